@@ -12,9 +12,24 @@
 
 #include "pmu_counter.h"
 
-/* On zephyr, use k_msleep */
+/* On zephyr, use k_msleep and k_sem */
 #if defined(__ZEPHYR__)
 #include <zephyr/kernel.h>
+#else
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+/* Pixels in flight from Display_FillRectAsync, the panel is busy until they are sent */
+static volatile bool s_bSendingPixels = false;
+static PFN_DISPLAY_DONE s_pfnSendDone = NULL;
+static void *s_pvSendDoneUserData = NULL;
+
+/* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+K_SEM_DEFINE(s_sSendDoneSem, 0, 1);
+#else
+static SemaphoreHandle_t s_sSendDoneSem = NULL;
 #endif
 
 #if defined(__EBI_LCD_PANEL__)
@@ -153,11 +168,89 @@ int Display_Init(void)
     /* lock protected registers */
     SYS_LockReg();
 
+#if !defined(__ZEPHYR__)
+    s_sSendDoneSem = xSemaphoreCreateBinary();
+
+    if (s_sSendDoneSem == NULL)
+        return -1;
+#endif
+
     //Init LCD
     s_psLCD->m_pfnInit();
     return 0;
 }
 
+static void WaitSendDone(void)
+{
+    if (!s_bSendingPixels)
+        return;
+
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_take(&s_sSendDoneSem, K_FOREVER);
+#else
+    xSemaphoreTake(s_sSendDoneSem, portMAX_DELAY);
+#endif
+
+    s_bSendingPixels = false;
+}
+
+static void SendDone(void *pvUserData, uint32_t u32Events)
+{
+    PFN_DISPLAY_DONE pfnDone = s_pfnSendDone;
+    void *pvDoneUserData = s_pvSendDoneUserData;
+
+    (void)pvUserData;
+    (void)u32Events;
+
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_give(&s_sSendDoneSem);
+#else
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR(s_sSendDoneSem, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif
+
+    if (pfnDone)
+        pfnDone(pvDoneUserData);
+}
+
+void Display_FillRectAsync(uint16_t *pu16Pixels, const S_DISP_RECT *psRect, int i32ScaleUpFactor,
+                           PFN_DISPLAY_DONE pfnDone, void *pvUserData)
+{
+    int32_t w = psRect->u32BottonRightX - psRect->u32TopLeftX  + 1;
+    int32_t h = psRect->u32BottonRightY - psRect->u32TopLeftY + 1;
+
+    if ((i32ScaleUpFactor == 1) && (s_psLCD->m_pfnSentPixelAsync != NULL))
+    {
+        WaitSendDone();
+
+        if ((psRect->u32BottonRightX >= s_psLCD->m_u16Width) || (psRect->u32BottonRightY >= s_psLCD->m_u16Height))
+        {
+            printf("Display_FillRectAsync incorrect setting \n");
+        }
+
+        s_psLCD->m_pfnSetColumn(psRect->u32TopLeftX, psRect->u32BottonRightX);
+        s_psLCD->m_pfnSetPage(psRect->u32TopLeftY, psRect->u32BottonRightY);
+
+        s_pfnSendDone = pfnDone;
+        s_pvSendDoneUserData = pvUserData;
+        s_bSendingPixels = true;
+
+        if (s_psLCD->m_pfnSentPixelAsync(pu16Pixels, w, h, SendDone, NULL) == 0)
+            return;
+
+        s_bSendingPixels = false;
+    }
+
+    Display_FillRect(pu16Pixels, psRect, i32ScaleUpFactor);
+
+    if (pfnDone)
+        pfnDone(pvUserData);
+}
+
 void Display_FillRect(uint16_t *pu16Pixels, const S_DISP_RECT *psRect, int i32ScaleUpFactor)
 {
     int32_t w = psRect->u32BottonRightX - psRect->u32TopLeftX  + 1;
@@ -168,6 +261,8 @@ void Display_FillRect(uint16_t *pu16Pixels, const S_DISP_RECT *psRect, int i32Sc
         printf("Display_FillRect incorrect setting \n");
     }
 
+    WaitSendDone();
+
     s_psLCD->m_pfnSetColumn(psRect->u32TopLeftX, psRect->u32BottonRightX);
     s_psLCD->m_pfnSetPage(psRect->u32TopLeftY, psRect->u32BottonRightY);
     s_psLCD->m_pfnSentPixel(pu16Pixels, w, h, 0, h * w * sizeof(uint16_t) * i32ScaleUpFactor, i32ScaleUpFactor);
@@ -210,6 +305,8 @@ int Display_PutText(
         return 1;
     }
 
+    WaitSendDone();
+
     /* If not within the LCD bounds, return error. */
     if (u32PosX + x_span > s_psLCD->m_u16Width || u32PosY + y_span > s_psLCD->m_u16Height)
     {
@@ -262,6 +359,8 @@ void Display_ClearRect(uint32_t u32Color, const S_DISP_RECT *psRect)
     int32_t w = psRect->u32BottonRightX - psRect->u32TopLeftX + 1;
     int32_t h = psRect->u32BottonRightY - psRect->u32TopLeftY + 1;
 
+    WaitSendDone();
+
     s_psLCD->m_pfnSetColumn(psRect->u32TopLeftX, psRect->u32BottonRightX);
     s_psLCD->m_pfnSetPage(psRect->u32TopLeftY, psRect->u32BottonRightY);
     s_psLCD->m_pfnSentPixel(NULL, w, h, u32Color, h * w * sizeof(uint16_t), 1);
@@ -272,6 +371,8 @@ void Display_ClearLCD(uint32_t u32Color)
     int32_t w = s_psLCD->m_u16Width;
     int32_t h = s_psLCD->m_u16Height;
 
+    WaitSendDone();
+
     s_psLCD->m_pfnSetColumn(0, w - 1);
     s_psLCD->m_pfnSetPage(0, h - 1);
     s_psLCD->m_pfnSentPixel(NULL, w, h, u32Color, h * w * sizeof(uint16_t), 1);
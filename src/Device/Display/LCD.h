@@ -69,6 +69,10 @@ typedef void (*PFN_LCD_SET_COLUMN)(uint16_t u16StartCol, uint16_t u16EndCol);
 typedef void (*PFN_LCD_SET_PAGE)(uint16_t u16StartPage, uint16_t u16EndPage);
 typedef void (*PFN_LCD_SENT_PIXEL)(uint16_t *pu16Pixels, uint32_t u32Width, uint32_t u32Height, uint32_t u32FixedColor, int32_t i32ByteLen, int32_t i32ScaleUpFactory);
 typedef void (*PFN_LCD_PUT_CHAR)(uint16_t x, uint16_t y, uint8_t c, uint32_t fColor, uint32_t bColor, int32_t i32ScaleUpFactory);
+/* Same as drv_pdma's nu_pdma_cb_handler_t, u32Events are NU_PDMA_EVENT_* */
+typedef void (*PFN_LCD_SENT_DONE)(void *pvUserData, uint32_t u32Events);
+/* Unscaled pixels only, returns <0 if they can't be sent this way */
+typedef int (*PFN_LCD_SENT_PIXEL_ASYNC)(uint16_t *pu16Pixels, uint32_t u32Width, uint32_t u32Height, PFN_LCD_SENT_DONE pfnDone, void *pvUserData);
 
 typedef enum
 {
@@ -88,6 +92,7 @@ typedef struct s_lcd_info
     PFN_LCD_SET_PAGE    m_pfnSetPage;
     PFN_LCD_SENT_PIXEL  m_pfnSentPixel;
     PFN_LCD_PUT_CHAR    m_pfnPutChar;
+    PFN_LCD_SENT_PIXEL_ASYNC m_pfnSentPixelAsync;   //Optional, NULL if synchronous only
 } S_LCD_INFO;
 
 extern S_LCD_INFO g_s_WVGA_LT7381;
@@ -151,6 +151,16 @@ static void fsa506_send_pixels(uint16_t *pixels, uint32_t destWidth, uint32_t de
     FSA506_WRITE_REG(0x80);
 }
 
+#if defined(CONFIG_DISP_USE_PDMA)
+static int fsa506_send_pixels_async(uint16_t *pixels, uint32_t destWidth, uint32_t destHeight, PFN_LCD_SENT_DONE pfnDone, void *pvUserData)
+{
+    FSA506_WRITE_REG(0xC1);
+
+    // PDMA-M2M feed, done in PDMA interrupt
+    return nu_pdma_mempush_async((void *)DISP_DAT_ADDR, (void *)pixels, 16, destWidth * destHeight, pfnDone, pvUserData);
+}
+#endif
+
 void fsa506_put_char8x16(uint16_t x, uint16_t y, uint8_t c, uint32_t fColor, uint32_t bColor, int32_t scaleUpFactory)
 {
     uint32_t i, j;
@@ -284,6 +294,9 @@ S_LCD_INFO g_s_WQVGA_FSA506 =
     .m_pfnSetPage   = fsa506_set_page,
     .m_pfnSentPixel = fsa506_send_pixels,
     .m_pfnPutChar   = fsa506_put_char8x16,
+#if defined(CONFIG_DISP_USE_PDMA)
+    .m_pfnSentPixelAsync = fsa506_send_pixels_async,
+#endif
 };
 
 #endif
@@ -688,6 +688,23 @@ static void lt7381_send_pixels(uint16_t *pixels, uint32_t destWidth, uint32_t de
     }
 }
 
+#if defined(CONFIG_DISP_USE_PDMA)
+static int lt7381_send_pixels_async(uint16_t *pixels, uint32_t destWidth, uint32_t destHeight, PFN_LCD_SENT_DONE pfnDone, void *pvUserData)
+{
+    /* Set Graphic Read/Write position */
+    lt7381_write_reg(0x5F, 0);
+    lt7381_write_reg(0x60, 0);
+    lt7381_write_reg(0x61, 0);
+    lt7381_write_reg(0x62, 0);
+
+    /* Memory Data Read/Write Port */
+    LT7381_WRITE_REG(0x04);
+
+    // PDMA-M2M feed, done in PDMA interrupt
+    return nu_pdma_mempush_async((void *)DISP_DAT_ADDR, (void *)pixels, 16, destWidth * destHeight, pfnDone, pvUserData);
+}
+#endif
+
 void lt7381_put_char8x16(uint16_t x, uint16_t y, uint8_t c, uint32_t fColor, uint32_t bColor, int32_t scaleUpFactory)
 {
     uint32_t i, j;
@@ -745,6 +762,9 @@ S_LCD_INFO g_s_WVGA_LT7381 =
     .m_pfnSetPage   = lt7381_set_page,
     .m_pfnSentPixel = lt7381_send_pixels,
     .m_pfnPutChar   = lt7381_put_char8x16,
+#if defined(CONFIG_DISP_USE_PDMA)
+    .m_pfnSentPixelAsync = lt7381_send_pixels_async,
+#endif
 };
 
 #endif
@@ -1317,6 +1317,111 @@ int nu_pdma_mempush(void *dest, void *src, uint32_t data_width, unsigned int tra
     return 0;
 }
 
+/* Asynchronous push: one transfer at a time, on a channel and SG tables of its own */
+static int nu_pdma_mempush_async_chn = -1;
+static nu_pdma_desc_t nu_pdma_mempush_async_sgtbls[NU_PDMA_SGTBL_POOL_SIZE];
+static int nu_pdma_mempush_async_sgtbl_num = 0;
+static volatile uint32_t nu_pdma_mempush_async_busy = 0;
+static volatile uint32_t nu_pdma_mempush_async_events = 0;
+static nu_pdma_cb_handler_t nu_pdma_mempush_async_pfn = NULL;
+static void *nu_pdma_mempush_async_userdata = NULL;
+
+static void nu_pdma_mempush_async_cb(void *pvUserData, uint32_t u32Events)
+{
+    nu_pdma_cb_handler_t pfnDone = nu_pdma_mempush_async_pfn;
+    void *pvDoneUserData = nu_pdma_mempush_async_userdata;
+
+    (void)pvUserData;
+
+    nu_pdma_mempush_async_events = u32Events;
+    nu_pdma_mempush_async_busy = 0;
+
+    if (pfnDone)
+        pfnDone(pvDoneUserData, u32Events);
+}
+
+int nu_pdma_mempush_async(void *dest, void *src, uint32_t data_width, unsigned int transfer_count,
+                          nu_pdma_cb_handler_t pfnDone, void *pvUserData)
+{
+    struct nu_pdma_chn_cb sChnCB;
+    int i32SgtblNum;
+    uint32_t u32Offset = 0;
+    int i;
+
+    if (!(data_width == 8 || data_width == 16 || data_width == 32) || (transfer_count == 0))
+        return -1;
+
+    i32SgtblNum = (transfer_count + NU_PDMA_MAX_TXCNT - 1) / NU_PDMA_MAX_TXCNT;
+
+    if ((i32SgtblNum > NU_PDMA_SGTBL_POOL_SIZE) || nu_pdma_mempush_async_busy)
+        return -1;
+
+    if (nu_pdma_mempush_async_chn < 0)
+    {
+        if ((nu_pdma_mempush_async_chn = nu_pdma_channel_allocate(PDMA_MEM)) < 0)
+            return -1;
+
+        nu_pdma_channel_memctrl_set(nu_pdma_mempush_async_chn, eMemCtl_SrcInc_DstFix);
+
+        /* Register ISR callback function */
+        sChnCB.m_eCBType = eCBType_Event;
+        sChnCB.m_pfnCBHandler = nu_pdma_mempush_async_cb;
+        sChnCB.m_pvUserData = NULL;
+
+        nu_pdma_filtering_set(nu_pdma_mempush_async_chn, NU_PDMA_EVENT_ABORT | NU_PDMA_EVENT_TRANSFER_DONE);
+        nu_pdma_callback_register(nu_pdma_mempush_async_chn, &sChnCB);
+    }
+
+    /* Terminate it if the last one got ABORT event */
+    if (nu_pdma_mempush_async_events & NU_PDMA_EVENT_ABORT)
+        nu_pdma_channel_terminate(nu_pdma_mempush_async_chn);
+
+    /* Tables are kept between transfers, and only taken again for a longer one */
+    if (i32SgtblNum > nu_pdma_mempush_async_sgtbl_num)
+    {
+        nu_pdma_sgtbls_free(nu_pdma_mempush_async_sgtbls, nu_pdma_mempush_async_sgtbl_num);
+        nu_pdma_mempush_async_sgtbl_num = 0;
+
+        if (nu_pdma_sgtbls_allocate(nu_pdma_mempush_async_sgtbls, i32SgtblNum) != 0)
+            return -1;
+
+        nu_pdma_mempush_async_sgtbl_num = i32SgtblNum;
+    }
+
+    for (i = 0; i < i32SgtblNum; i++)
+    {
+        uint32_t u32TxCnt = (transfer_count > NU_PDMA_MAX_TXCNT) ? NU_PDMA_MAX_TXCNT : transfer_count;
+        int bLast = ((i + 1) == i32SgtblNum);
+
+        /* Only the last one raises the transfer done interrupt */
+        if (nu_pdma_desc_setup(nu_pdma_mempush_async_chn,
+                               nu_pdma_mempush_async_sgtbls[i],
+                               data_width,
+                               (uint32_t)src + u32Offset,
+                               (uint32_t)dest,
+                               u32TxCnt,
+                               bLast ? NULL : nu_pdma_mempush_async_sgtbls[i + 1],
+                               bLast ? 0 : 1) != 0)
+            return -1;
+
+        transfer_count -= u32TxCnt;
+        u32Offset += (u32TxCnt * data_width / 8);
+    }
+
+    nu_pdma_mempush_async_pfn = pfnDone;
+    nu_pdma_mempush_async_userdata = pvUserData;
+    nu_pdma_mempush_async_events = 0;
+    nu_pdma_mempush_async_busy = 1;
+
+    if (nu_pdma_sg_transfer(nu_pdma_mempush_async_chn, nu_pdma_mempush_async_sgtbls[0], 0) != 0)
+    {
+        nu_pdma_mempush_async_busy = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
 void *nu_pdma_memcpy(void *dest, void *src, unsigned int count)
 {
     int i = 0;
@@ -96,6 +96,10 @@ int nu_pdma_m2m_desc_setup(nu_pdma_desc_t dma_desc, uint32_t u32DataWidth, uint3
 // For memory actor
 void *nu_pdma_memcpy(void *dest, void *src, unsigned int count);
 int nu_pdma_mempush(void *dest, void *src, uint32_t data_width, unsigned int transfer_count);
+/* Returns once started, pfnDone runs from the PDMA interrupt with the NU_PDMA_EVENT_* of the transfer.
+ * One at a time, <0 while the previous one is still going. */
+int nu_pdma_mempush_async(void *dest, void *src, uint32_t data_width, unsigned int transfer_count,
+                          nu_pdma_cb_handler_t pfnDone, void *pvUserData);
 
 #define PDMA_ASSERT(expr)                                      \
     do {                                                       \
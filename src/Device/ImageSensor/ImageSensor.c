@@ -9,6 +9,7 @@
 #include "NuMicro.h"
 
 #include "ImageSensor.h"
+#include "ImageSensorBackend.h"
 #include "Sensor.h"
 
 /* On zephyr, use zephyr ISR API */
@@ -43,20 +44,15 @@ const S_OUTPUT_FORMAT s_sOutputFormat[] =
 /*------------------------------------------------------------------------------------------*/
 /*  CCAP_IRQHandler                                                                          */
 /*------------------------------------------------------------------------------------------*/
-void CCAP_InterruptHandler(void)
-{
-    //g_u32FramePass++;
-    //printf("Frame count: %d\n", g_u32FramePass);
-}
-
 void CCAP_IRQHandler(void)
 {
     uint32_t u32CCAP_Status = CCAP->INTSTS;
+    uint32_t u32Events = 0;
 
     if ((CCAP->INTEN & CCAP_INTEN_VIEN_Msk) && (u32CCAP_Status & CCAP_INTSTS_VINTF_Msk))
     {
-        CCAP_InterruptHandler();
         CCAP->INTSTS |= CCAP_INTSTS_VINTF_Msk;        /* Clear Frame end interrupt */
+        u32Events |= IMAGE_SENSOR_EVENT_FRAME_END;
     }
 
     if ((CCAP->INTEN & CCAP_INTEN_ADDRMIEN_Msk) && (u32CCAP_Status & CCAP_INTSTS_ADDRMINTF_Msk))
@@ -67,8 +63,13 @@ void CCAP_IRQHandler(void)
     if ((CCAP->INTEN & CCAP_INTEN_MEIEN_Msk) && (u32CCAP_Status & CCAP_INTSTS_MEINTF_Msk))
     {
         CCAP->INTSTS |= CCAP_INTSTS_MEINTF_Msk;    /* Clear Memory error interrupt */
+        u32Events |= IMAGE_SENSOR_EVENT_MEM_ERROR;
     }
 
+    /* Completes the capture in flight, see ImageSensorCapture.c */
+    if (u32Events)
+        ImageSensor_CaptureEvent(u32Events);
+
     CCAP->CTL = CCAP->CTL | CCAP_CTL_UPDATE;
     __DSB();
     __ISB();
@@ -203,24 +204,93 @@ static void MFP_ConfigCCAP(uint32_t bConfigCCAP)
 }
 
 static S_SENSOR_INFO *s_psSensorInfo = NULL;
+static uint32_t s_u32PlanarWidth = 0;
+static uint32_t s_u32PlanarHeight = 0;
 
-int ImageSensor_Init(void)
+static void SetCaptureBufs(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr)
+{
+    /* Set System Memory Packet Base Address Register */
+    CCAP_SetPacketBuf((uint32_t)u32FrameBufAddr);
+
+    if (u32PlanarBufAddr != 0)
+    {
+        uint32_t u32YSize = s_u32PlanarWidth * s_u32PlanarHeight;
+
+        /* Set System Memory Planar Y/U/V Base Address Registers */
+        CCAP_SetPlanarYBuf(u32PlanarBufAddr);
+        CCAP_SetPlanarUBuf(u32PlanarBufAddr + u32YSize);
+        CCAP_SetPlanarVBuf(u32PlanarBufAddr + u32YSize + (u32YSize / 4));
+    }
+}
+
+static void StartCapture(void)
+{
+    /* One shot: CCAP stops by itself at the end of the frame, then raises VINTF */
+    CCAP_Start();
+    CCAP->CTL |= CCAP_CTL_SHUTTER_Msk;
+}
+
+static void StopCapture(void)
+{
+    CCAP_Stop(CCAP_DISABLE);
+}
+
+static void DisableCaptureIRQ(void)
+{
+    /* On zephyr, use zephyr ISR API */
+#if defined(__ZEPHYR__)
+    irq_disable(CCAP_IRQn);
+#else
+    NVIC_DisableIRQ(CCAP_IRQn);
+#endif
+}
+
+static void EnableCaptureIRQ(void)
+{
+    /* On zephyr, use zephyr ISR API */
+#if defined(__ZEPHYR__)
+    irq_enable(CCAP_IRQn);
+#else
+    NVIC_EnableIRQ(CCAP_IRQn);
+#endif
+}
+
+static const S_IMAGE_SENSOR_BACKEND s_sCcapBackend =
+{
+    SetCaptureBufs,
+    StartCapture,
+    StopCapture,
+    DisableCaptureIRQ,
+    EnableCaptureIRQ,
+};
+
+int ImageSensor_InitEx(uint32_t u32MinWidth, uint32_t u32MinHeight)
 {
     /* Init Engine clock and Sensor clock */
     CCAP_SetFreq(CLK_CCAPSEL_CCAP0SEL_HCLK2, 48000000);
     MFP_ConfigCCAP(TRUE);
 
     /* Init sensor */
-    //s_psSensorInfo = &g_sSensorHM1055_VGA_YUV422;
-    s_psSensorInfo = &g_sSensorHM1055_QVGA_YUV422;
+    if ((u32MinWidth <= g_sSensorHM1055_QVGA_YUV422.m_u16Width) &&
+            (u32MinHeight <= g_sSensorHM1055_QVGA_YUV422.m_u16Height))
+        s_psSensorInfo = &g_sSensorHM1055_QVGA_YUV422;
+    else
+        s_psSensorInfo = &g_sSensorHM1055_VGA_YUV422;
 
     /* Initialize sensor and set sensor output format as YUV422 */
     if (s_psSensorInfo->pfnInitSensor(0) == FALSE) return -1;
 
-    return 0;
+    /* Capture with the CCAP registers */
+    return ImageSensor_SetBackend(&s_sCcapBackend);
 }
 
-int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight, bool bKeepRatio)
+int ImageSensor_Init(void)
+{
+    return ImageSensor_InitEx(0, 0);
+}
+
+static int ConfigPipes(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight,
+                       uint32_t u32PlanarFmt, uint32_t u32PlanarWidth, uint32_t u32PlanarHeight, bool bKeepRatio)
 {
     uint32_t u32CropWinWidth;
     uint32_t u32CropWinHeight;
@@ -254,6 +324,14 @@ int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32Im
         u32CropWinHeight = s_psSensorInfo->m_u16Height;
     }
 
+    /* The planar scaler only shrinks the cropping window */
+    if ((u32PlanarFmt != CCAP_PLN_DISABLED) &&
+            ((u32PlanarWidth > u32CropWinWidth) || (u32PlanarHeight > u32CropWinHeight)))
+    {
+        printf("planar image %ux%u larger than cropping window %ux%u \n",
+               u32PlanarWidth, u32PlanarHeight, u32CropWinWidth, u32CropWinHeight);
+        return -1;
+    }
 
     /* Set Cropping Window Vertical/Horizontal Starting Address and Cropping Window Size */
     CCAP_SetCroppingWindow(u32CropWinY, u32CropWinX, u32CropWinHeight, u32CropWinWidth);
@@ -263,7 +341,7 @@ int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32Im
         s_psSensorInfo->m_u32Polarity,
         s_psSensorInfo->m_u32InputFormat,
         s_sOutputFormat[eImgFmt].m_u32OutputFormat,
-        CCAP_PLN_DISABLED
+        u32PlanarFmt
     );
 
     /* Set Packet Scaling Vertical/Horizontal Factor Register */
@@ -276,6 +354,21 @@ int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32Im
     /* Set Packet Frame Output Pixel Stride Width */
     CCAP_SetPacketStride(u32ImgWidth);
 
+    if (u32PlanarFmt != CCAP_PLN_DISABLED)
+    {
+        /* Set Planar Scaling Vertical/Horizontal Factor Register and Stride */
+        CCAP_SetPlanarScaling(u32PlanarHeight, u32CropWinHeight, u32PlanarWidth, u32CropWinWidth);
+        CCAP_SetPlanarStride(u32PlanarWidth);
+        printf("planar image width %u \n", u32PlanarWidth);
+        printf("planar image height %u \n", u32PlanarHeight);
+    }
+
+    s_u32PlanarWidth = u32PlanarWidth;
+    s_u32PlanarHeight = u32PlanarHeight;
+
+    /* Report frame end and memory errors, see CCAP_IRQHandler */
+    CCAP->INTEN |= (CCAP_INTEN_VIEN_Msk | CCAP_INTEN_MEIEN_Msk);
+
     /* Enable External CAP Interrupt */
     /* On zephyr, use zephyr ISR API */
 #if defined(__ZEPHYR__)
@@ -288,47 +381,18 @@ int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32Im
     return 0;
 }
 
-
-int ImageSensor_Capture(uint32_t u32FrameBufAddr)
-{
-    int i32Ret = CCAP_OK;
-    /* Set System Memory Packet Base Address Register */
-    //printf("sensor capture address %x \n", u32FrameBufAddr);
-    CCAP_SetPacketBuf((uint32_t)u32FrameBufAddr);
-
-    /* Start image capture */
-    CCAP_Start();
-
-    /* Start image capture */
-    i32Ret = CCAP_Stop(TRUE);
-
-    if (i32Ret != CCAP_OK)
-        return -1;
-
-    return 0;
-}
-
-int ImageSensor_TriggerCapture(uint32_t u32FrameBufAddr)
+int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight, bool bKeepRatio)
 {
-    /* Set System Memory Packet Base Address Register */
-    //printf("sensor capture address %x \n", u32FrameBufAddr);
-    CCAP_SetPacketBuf((uint32_t)u32FrameBufAddr);
-
-    /* Trigger image capture */
-    CCAP_Start();
-    CCAP->CTL |= CCAP_CTL_SHUTTER_Msk;
-
-    return 0;
+    return ConfigPipes(eImgFmt, u32ImgWidth, u32ImgHeight, CCAP_PLN_DISABLED, 0, 0, bKeepRatio);
 }
 
-int ImageSensor_WaitCaptureDone(void)
+int ImageSensor_ConfigDualPipe(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight,
+                               uint32_t u32PlanarWidth, uint32_t u32PlanarHeight, bool bKeepRatio)
 {
-    uint32_t u32TimeOutCnt = SystemCoreClock << 1; /* 2 second */
-
-    while (!CCAP_IS_STOPPED())
-    {
-        if (--u32TimeOutCnt == 0) return CCAP_ERR_TIMEOUT;
-    }
+    /* YUV420P halves the chroma both ways */
+    if ((u32PlanarWidth & 0x1) || (u32PlanarHeight & 0x1))
+        return -1;
 
-    return 0;
+    return ConfigPipes(eImgFmt, u32ImgWidth, u32ImgHeight, CCAP_PLN_OUTFMT_YUV420P,
+                       u32PlanarWidth, u32PlanarHeight, bKeepRatio);
 }
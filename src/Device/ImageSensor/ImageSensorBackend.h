@@ -0,0 +1,45 @@
+/**************************************************************************//**
+ * @file     ImageSensorBackend.h
+ * @version  V1.00
+ * @brief    CCAP operations of the image sensor capture path
+ *
+ * @copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __IMAGE_SENSOR_BACKEND_H__
+#define __IMAGE_SENSOR_BACKEND_H__
+
+#include <inttypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Capture events, reported from the CCAP interrupt */
+#define IMAGE_SENSOR_EVENT_FRAME_END    (1UL << 0)  /* VINTF, the frame is in memory */
+#define IMAGE_SENSOR_EVENT_MEM_ERROR    (1UL << 1)  /* MEINTF, CCAP could not write memory */
+
+/* What the capture path does to CCAP: the CCAP registers in ImageSensor.c, or a simulation in host tests */
+typedef struct
+{
+    /* Set the packet buffer and, unless u32PlanarBufAddr is 0, the planar buffers of the next frame */
+    void (*pfnSetBufs)(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr);
+    /* Start a one-shot capture, ImageSensor_CaptureEvent reports its end */
+    void (*pfnStart)(void);
+    /* Stop CCAP at once */
+    void (*pfnStop)(void);
+    /* Keep the CCAP interrupt from running, and let it run again */
+    void (*pfnDisableIRQ)(void);
+    void (*pfnEnableIRQ)(void);
+} S_IMAGE_SENSOR_BACKEND;
+
+/* Capture through psBackend from now on. Returns <0 if a capture is still in flight. */
+int ImageSensor_SetBackend(const S_IMAGE_SENSOR_BACKEND *psBackend);
+
+/* Complete the capture in flight on IMAGE_SENSOR_EVENT_* u32Events, from the CCAP interrupt */
+void ImageSensor_CaptureEvent(uint32_t u32Events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+/**************************************************************************//**
+ * @file     ImageSensorCapture.c
+ * @version  V1.00
+ * @brief    image sensor capture arming and completion
+ *
+ * @copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include <stddef.h>
+#include "NuMicro.h"
+
+#include "ImageSensor.h"
+#include "ImageSensorBackend.h"
+
+/* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+#include <zephyr/kernel.h>
+#else
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+#if !defined(CAPTURE_TIMEOUT_MS)
+#define CAPTURE_TIMEOUT_MS  2000
+#endif
+
+static const S_IMAGE_SENSOR_BACKEND *s_psBackend = NULL;
+
+/* Completion of the frame in flight, cleared by the interrupt that reports it */
+static volatile PFN_IMAGE_SENSOR_CAPTURE_DONE s_pfnCaptureDone = NULL;
+static void *s_pvCaptureDoneUserData = NULL;
+
+/* Completion of ImageSensor_TriggerCapture, for ImageSensor_WaitCaptureDone */
+/* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+K_SEM_DEFINE(s_sCaptureDoneSem, 0, 1);
+#else
+static SemaphoreHandle_t s_sCaptureDoneSem = NULL;
+#endif
+static volatile int s_i32CaptureResult = 0;
+
+int ImageSensor_SetBackend(const S_IMAGE_SENSOR_BACKEND *psBackend)
+{
+    if (s_pfnCaptureDone != NULL)
+        return -1;
+
+#if !defined(__ZEPHYR__)
+    if (s_sCaptureDoneSem == NULL)
+        s_sCaptureDoneSem = xSemaphoreCreateBinary();
+
+    if (s_sCaptureDoneSem == NULL) return -1;
+#endif
+
+    s_psBackend = psBackend;
+
+    return 0;
+}
+
+static void CompleteCapture(int i32Result)
+{
+    PFN_IMAGE_SENSOR_CAPTURE_DONE pfnDone = s_pfnCaptureDone;
+
+    if (pfnDone == NULL)
+        return;
+
+    s_pfnCaptureDone = NULL;
+    pfnDone(i32Result, s_pvCaptureDoneUserData);
+}
+
+void ImageSensor_CaptureEvent(uint32_t u32Events)
+{
+    if (s_psBackend == NULL)
+        return;
+
+    if (u32Events & IMAGE_SENSOR_EVENT_FRAME_END)
+        CompleteCapture(0);
+
+    if (u32Events & IMAGE_SENSOR_EVENT_MEM_ERROR)
+    {
+        s_psBackend->pfnStop();
+        CompleteCapture(-1);
+    }
+}
+
+int ImageSensor_CaptureAsync(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr,
+                             PFN_IMAGE_SENSOR_CAPTURE_DONE pfnDone, void *pvUserData)
+{
+    if ((s_psBackend == NULL) || (pfnDone == NULL) || (s_pfnCaptureDone != NULL))
+        return -1;
+
+    s_psBackend->pfnSetBufs(u32FrameBufAddr, u32PlanarBufAddr);
+
+    s_pvCaptureDoneUserData = pvUserData;
+    s_pfnCaptureDone = pfnDone;
+
+    /* One shot: CCAP stops by itself at the end of the frame, then raises VINTF */
+    s_psBackend->pfnStart();
+
+    return 0;
+}
+
+static void CaptureDoneSemGive(int i32Result, void *pvUserData)
+{
+    (void)pvUserData;
+
+    s_i32CaptureResult = i32Result;
+
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_give(&s_sCaptureDoneSem);
+#else
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR(s_sCaptureDoneSem, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif
+}
+
+static int TriggerFrame(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr)
+{
+    /* Drop a completion that came after an earlier wait gave up */
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_reset(&s_sCaptureDoneSem);
+#else
+    xSemaphoreTake(s_sCaptureDoneSem, 0);
+#endif
+
+    return ImageSensor_CaptureAsync(u32FrameBufAddr, u32PlanarBufAddr, CaptureDoneSemGive, NULL);
+}
+
+int ImageSensor_TriggerCapture(uint32_t u32FrameBufAddr)
+{
+    return TriggerFrame(u32FrameBufAddr, 0);
+}
+
+int ImageSensor_WaitCaptureDone(void)
+{
+    int i32Taken;
+
+    /* Sleep until the frame end interrupt, instead of polling CCAP */
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    i32Taken = (k_sem_take(&s_sCaptureDoneSem, K_MSEC(CAPTURE_TIMEOUT_MS)) == 0);
+#else
+    i32Taken = (xSemaphoreTake(s_sCaptureDoneSem, pdMS_TO_TICKS(CAPTURE_TIMEOUT_MS)) == pdTRUE);
+#endif
+
+    if (!i32Taken)
+    {
+        /* Give up on the frame, so that the next capture can be armed */
+        s_psBackend->pfnDisableIRQ();
+        s_pfnCaptureDone = NULL;
+        s_psBackend->pfnEnableIRQ();
+        s_psBackend->pfnStop();
+
+        return CCAP_ERR_TIMEOUT;
+    }
+
+    return (s_i32CaptureResult == 0) ? 0 : -1;
+}
+
+int ImageSensor_Capture(uint32_t u32FrameBufAddr)
+{
+    if (TriggerFrame(u32FrameBufAddr, 0) != 0)
+        return -1;
+
+    return ImageSensor_WaitCaptureDone();
+}
+
+int ImageSensor_CaptureDualPipe(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr)
+{
+    if (TriggerFrame(u32FrameBufAddr, u32PlanarBufAddr) != 0)
+        return -1;
+
+    return ImageSensor_WaitCaptureDone();
+}
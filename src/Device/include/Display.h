@@ -52,8 +52,18 @@ typedef struct
     uint32_t u32BottonRightY;
 } S_DISP_RECT;
 
+/* Called once the pixels have been sent and their buffer may be reused, from interrupt context if sent by PDMA */
+typedef void (*PFN_DISPLAY_DONE)(void *pvUserData);
+
 int Display_Init(void);
 void Display_FillRect(uint16_t *pu16Pixels, const S_DISP_RECT *psRect, int i32ScaleUpFactor);
+/*
+ * Start sending the pixels and return, pfnDone reports the end. Where the panel can't be fed by PDMA,
+ * or the pixels are scaled up, it is Display_FillRect followed by pfnDone. Other display calls wait for
+ * the pixels in flight first.
+ */
+void Display_FillRectAsync(uint16_t *pu16Pixels, const S_DISP_RECT *psRect, int i32ScaleUpFactor,
+                           PFN_DISPLAY_DONE pfnDone, void *pvUserData);
 void Display_Delay(uint32_t u32MilliSec);
 int Display_PutText(
     const char *szText,
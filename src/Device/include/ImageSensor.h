@@ -31,12 +31,35 @@ typedef enum
     eIMAGE_FMT_BGRA888_I8,
 } E_IMAGE_FMT;
 
+/* Called from the CCAP interrupt once the frame is in memory, i32Result 0, or on a memory error, i32Result <0 */
+typedef void (*PFN_IMAGE_SENSOR_CAPTURE_DONE)(int i32Result, void *pvUserData);
+
 int ImageSensor_Init(void);
+/* Init the sensor at the smallest mode of at least u32MinWidth x u32MinHeight, CCAP scaling only shrinks */
+int ImageSensor_InitEx(uint32_t u32MinWidth, uint32_t u32MinHeight);
 int ImageSensor_Capture(uint32_t u32FrameBufAddr);
 int ImageSensor_Config(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight, bool bKeepRatio);
 int ImageSensor_TriggerCapture(uint32_t u32FrameBufAddr);
+/* Sleeps until the frame triggered above is done, or 2 seconds, CCAP_ERR_TIMEOUT */
 int ImageSensor_WaitCaptureDone(void);
 
+/*
+ * Arm a one-shot capture and return at once, pfnDone reports the end of the frame.
+ * u32PlanarBufAddr 0 leaves the planar buffers as they are, see ImageSensor_ConfigDualPipe.
+ * Returns <0 if a capture is still in flight.
+ */
+int ImageSensor_CaptureAsync(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr,
+                             PFN_IMAGE_SENSOR_CAPTURE_DONE pfnDone, void *pvUserData);
+
+/*
+ * Dual pipe capture: the packet pipe writes eImgFmt at u32ImgWidth x u32ImgHeight, the planar pipe
+ * writes YUV420P at u32PlanarWidth x u32PlanarHeight from the same cropping window, in the same frame.
+ * The planar buffer holds the Y plane, then the U and V planes.
+ */
+int ImageSensor_ConfigDualPipe(E_IMAGE_FMT eImgFmt, uint32_t u32ImgWidth, uint32_t u32ImgHeight,
+                               uint32_t u32PlanarWidth, uint32_t u32PlanarHeight, bool bKeepRatio);
+int ImageSensor_CaptureDualPipe(uint32_t u32FrameBufAddr, uint32_t u32PlanarBufAddr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,152 @@
+/**************************************************************************//**
+ * @file     FrameSlotRing.cpp
+ * @version  V1.00
+ * @brief    Frame slots of the object detection main loop
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "FrameSlotRing.hpp"
+
+#if !defined(__ZEPHYR__)
+    #include "NuMicro.h"
+#endif
+
+#if defined(__ZEPHYR__)
+int FrameSlotRing::Init(S_FRAMEBUF *slots, int numSlots, k_fifo *processQueue)
+#else
+int FrameSlotRing::Init(S_FRAMEBUF *slots, int numSlots, QueueHandle_t processQueue)
+#endif
+{
+    m_slots = slots;
+    m_numSlots = numSlots;
+    m_processQueue = processQueue;
+
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    k_fifo_init(&m_freeQueue);
+#else
+    m_freeQueue = xQueueCreate(numSlots, sizeof(S_FRAMEBUF *));
+
+    if (m_freeQueue == nullptr)
+        return -1;
+#endif
+
+    Refill();
+
+    return 0;
+}
+
+void FrameSlotRing::PutFree(S_FRAMEBUF *slot)
+{
+#if defined(__ZEPHYR__)
+    k_fifo_put(&m_freeQueue, slot);
+#else
+    if (__get_IPSR() != 0)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        xQueueSendFromISR(m_freeQueue, &slot, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+    else
+    {
+        xQueueSend(m_freeQueue, &slot, portMAX_DELAY);
+    }
+#endif
+}
+
+S_FRAMEBUF *FrameSlotRing::GetFree(bool bWait)
+{
+    S_FRAMEBUF *slot = nullptr;
+
+#if defined(__ZEPHYR__)
+    slot = static_cast<S_FRAMEBUF *>(k_fifo_get(&m_freeQueue, bWait ? K_FOREVER : K_NO_WAIT));
+#else
+    if (xQueueReceive(m_freeQueue, &slot, bWait ? portMAX_DELAY : 0) != pdPASS)
+        slot = nullptr;
+#endif
+
+    return slot;
+}
+
+S_FRAMEBUF *FrameSlotRing::TakePending()
+{
+    struct xInferenceJob *inferenceJob = nullptr;
+
+#if defined(__ZEPHYR__)
+    inferenceJob = static_cast<xInferenceJob *>(k_fifo_get(m_processQueue, K_NO_WAIT));
+#else
+    if (xQueueReceive(m_processQueue, &inferenceJob, 0) != pdPASS)
+        inferenceJob = nullptr;
+#endif
+
+    return (inferenceJob != nullptr) ? static_cast<S_FRAMEBUF *>(inferenceJob->pvOwner) : nullptr;
+}
+
+S_FRAMEBUF *FrameSlotRing::Acquire(bool bLatestFrameWins, uint32_t &u32SlotsDropped, uint32_t &u32FramesDropped)
+{
+    S_FRAMEBUF *slot = nullptr;
+
+    /* Latest frame wins: rather than wait for a free slot, reuse the one waiting for inference */
+    if (bLatestFrameWins)
+    {
+        slot = GetFree(false);
+
+        if (slot == nullptr)
+        {
+            slot = TakePending();
+
+            if (slot != nullptr)
+            {
+                u32SlotsDropped++;
+                u32FramesDropped += slot->job.u32FramesDropped + 1;
+            }
+        }
+    }
+
+    if (slot == nullptr)
+        slot = GetFree();
+
+    return slot;
+}
+
+void FrameSlotRing::DropPending(uint32_t &u32SlotsDropped, uint32_t &u32FramesDropped)
+{
+    S_FRAMEBUF *staleSlot;
+
+    while ((staleSlot = TakePending()) != nullptr)
+    {
+        u32SlotsDropped++;
+        u32FramesDropped += staleSlot->job.u32FramesDropped + 1;
+        PutFree(staleSlot);
+    }
+}
+
+void FrameSlotRing::Submit(S_FRAMEBUF *slot)
+{
+    struct xInferenceJob *inferenceJob = &slot->job;
+
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    k_fifo_put(m_processQueue, inferenceJob);
+#else
+    xQueueSend(m_processQueue, &inferenceJob, portMAX_DELAY);
+#endif
+}
+
+void FrameSlotRing::Drain()
+{
+    for (int i = 0; i < m_numSlots; i++)
+    {
+        GetFree();
+    }
+}
+
+void FrameSlotRing::Refill()
+{
+    for (int i = 0; i < m_numSlots; i++)
+    {
+        PutFree(&m_slots[i]);
+    }
+}
@@ -0,0 +1,126 @@
+/**************************************************************************//**
+ * @file     FrameSlotRing.hpp
+ * @version  V1.00
+ * @brief    Frame slots of the object detection main loop
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef FRAME_SLOT_RING_HPP
+#define FRAME_SLOT_RING_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "InferenceTask.hpp"
+
+/* Frame slot, going round capture -> inference -> render -> capture */
+typedef struct
+{
+    void *pvFifoReserved;   //First word, for k_fifo
+    image_t frameImage;
+    uint8_t *modelStage;    //Second capture output, see FrameSource
+    std::vector<object_detection::DetectionResult> results;
+    struct xInferenceJob job;
+} S_FRAMEBUF;
+
+/*
+ * The slots free for capture, and the hand-over of captured ones to the
+ * inference process queue as their jobs, whose pvOwner is the slot. Each
+ * stage blocks on its own queue: capture on this one, inference on its
+ * process queue and render on its response queue.
+ *
+ * With latest frame wins, capture never waits for inference: a frame still
+ * waiting for inference when a newer one is captured is dropped, its slot
+ * going straight back to capture.
+ */
+class FrameSlotRing
+{
+public:
+    /**
+     * @brief       Take the slots and the queue their jobs go to. The slots
+     *              start free.
+     * @param[in]   slots          Slots, their jobs' pvOwner set to them.
+     * @param[in]   numSlots       Number of slots.
+     * @param[in]   processQueue   Inference process queue.
+     * @return      0 on success, <0 on failure.
+     */
+#if defined(__ZEPHYR__)
+    int Init(S_FRAMEBUF *slots, int numSlots, k_fifo *processQueue);
+#else
+    int Init(S_FRAMEBUF *slots, int numSlots, QueueHandle_t processQueue);
+#endif
+
+    /**
+     * @brief       Hand a slot back to capture. Also called from the
+     *              display's PDMA interrupt.
+     * @param[in]   slot   Slot.
+     */
+    void PutFree(S_FRAMEBUF *slot);
+
+    /**
+     * @brief       Take a free slot.
+     * @param[in]   bWait   Wait for one, rather than return nullptr if none is free.
+     * @return      Slot, nullptr if none is free and bWait is false.
+     */
+    S_FRAMEBUF *GetFree(bool bWait = true);
+
+    /**
+     * @brief       Slot for the next capture. With latest frame wins, a free
+     *              slot, or else one still waiting for inference, whose frame
+     *              is dropped. Otherwise waits for a free slot.
+     * @param[in]       bLatestFrameWins   Reuse a slot waiting for inference rather than wait.
+     * @param[in,out]   u32SlotsDropped    Incremented by the frames dropped here.
+     * @param[in,out]   u32FramesDropped   Incremented by the frames dropped here, and those
+     *                                     they were dropped for in turn.
+     * @return      Slot.
+     */
+    S_FRAMEBUF *Acquire(bool bLatestFrameWins, uint32_t &u32SlotsDropped, uint32_t &u32FramesDropped);
+
+    /**
+     * @brief       Drop the frames still waiting for inference, older than a
+     *              frame just captured, handing their slots back to capture.
+     * @param[in,out]   u32SlotsDropped    Incremented by the frames dropped here.
+     * @param[in,out]   u32FramesDropped   Incremented by the frames dropped here, and those
+     *                                     they were dropped for in turn.
+     */
+    void DropPending(uint32_t &u32SlotsDropped, uint32_t &u32FramesDropped);
+
+    /**
+     * @brief       Queue the job of a captured slot for inference.
+     * @param[in]   slot   Slot, its job filled in.
+     */
+    void Submit(S_FRAMEBUF *slot);
+
+    /**
+     * @brief       Wait for every slot to come back, so that no stage uses
+     *              them or what their jobs point at.
+     */
+    void Drain();
+
+    /**
+     * @brief       Hand every slot back to capture, after Drain.
+     */
+    void Refill();
+
+private:
+    S_FRAMEBUF *m_slots{nullptr};
+    int m_numSlots{0};
+
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    struct k_fifo m_freeQueue;
+    k_fifo *m_processQueue{nullptr};
+#else
+    QueueHandle_t m_freeQueue{nullptr};
+    QueueHandle_t m_processQueue{nullptr};
+#endif
+
+    /**
+     * @brief       Take back a slot still waiting for inference.
+     * @return      Slot, nullptr if inference has started on all of them.
+     */
+    S_FRAMEBUF *TakePending();
+};
+
+#endif /* FRAME_SLOT_RING_HPP */
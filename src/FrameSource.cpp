@@ -0,0 +1,180 @@
+/**************************************************************************//**
+ * @file     FrameSource.cpp
+ * @version  V1.00
+ * @brief    Frame sources of the object detection main loop
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "FrameSource.hpp"
+#include "InputFiles.hpp"
+
+#if defined (__USE_CCAP__)
+    #include "ImageSensor.h"
+
+/* On zephyr, use zephyr cache API */
+#if defined(__ZEPHYR__)
+    #include <zephyr/cache.h>
+#else
+    #include "NuMicro.h"
+#endif
+#endif
+
+int PlannedFrameSource::ToModelInput(image_t *frame, const uint8_t *modelStage, image_t *modelInput)
+{
+    (void)modelStage;
+
+    return imlib_nvt_scale_plan_run(m_inputPlan, frame, modelInput);
+}
+
+int ImageFrameSource::Init(const image_t *frame, const image_t *modelInput)
+{
+    (void)modelInput;
+
+    image_t srcImg;
+    image_t dstImg = *frame;
+    rectangle_t roi;
+
+    srcImg.w = IMAGE_WIDTH;
+    srcImg.h = IMAGE_HEIGHT;
+    srcImg.data = nullptr;
+    srcImg.pixfmt = PIXFORMAT_RGB888;
+
+    roi.x = 0;
+    roi.y = 0;
+    roi.w = IMAGE_WIDTH;
+    roi.h = IMAGE_HEIGHT;
+
+    return imlib_nvt_scale_plan_init(&m_imagePlan, &srcImg, &dstImg, &roi, NVT_SCALE_NEAREST, nullptr);
+}
+
+int ImageFrameSource::Capture(image_t *frame, uint8_t *modelStage)
+{
+    (void)modelStage;
+
+    const uint8_t *pu8ImgSrc = get_img_array(m_imageIdx);
+
+    if (nullptr == pu8ImgSrc)
+    {
+        return -1;
+    }
+
+    m_imageIdx ++;
+
+    if (m_imageIdx >= NUMBER_OF_FILES)
+        m_imageIdx = 0;
+
+    //copy source image to frame buffer
+    image_t srcImg;
+
+    srcImg.w = IMAGE_WIDTH;
+    srcImg.h = IMAGE_HEIGHT;
+    srcImg.data = (uint8_t *)pu8ImgSrc;
+    srcImg.pixfmt = PIXFORMAT_RGB888;
+
+    return imlib_nvt_scale_plan_run(&m_imagePlan, &srcImg, frame);
+}
+
+#if defined (__USE_CCAP__)
+int CameraFrameSource::Init(const image_t *frame, const image_t *modelInput)
+{
+    (void)modelInput;
+
+    if (ImageSensor_Init() != 0)
+        return -1;
+
+    return ImageSensor_Config(eIMAGE_FMT_RGB565, frame->w, frame->h, true);
+}
+
+int CameraFrameSource::Capture(image_t *frame, uint8_t *modelStage)
+{
+    (void)modelStage;
+
+    return ImageSensor_Capture((uint32_t)(frame->data));
+}
+
+int DualPipeFrameSource::Init(const image_t *frame, const image_t *modelInput)
+{
+    /* The sensor mode must cover both outputs, CCAP only shrinks */
+    uint32_t u32MinWidth = (frame->w > modelInput->w) ? frame->w : modelInput->w;
+    uint32_t u32MinHeight = (frame->h > modelInput->h) ? frame->h : modelInput->h;
+
+    if (ImageSensor_InitEx(u32MinWidth, u32MinHeight) != 0)
+        return -1;
+
+    if (ImageSensor_ConfigDualPipe(eIMAGE_FMT_RGB565, frame->w, frame->h, modelInput->w, modelInput->h, true) != 0)
+        return -1;
+
+    /* YUV420P: Y, then quarter size U and V */
+    m_modelStageSize = (modelInput->w * modelInput->h * 3) / 2;
+
+    return 0;
+}
+
+int DualPipeFrameSource::Capture(image_t *frame, uint8_t *modelStage)
+{
+    return ImageSensor_CaptureDualPipe((uint32_t)(frame->data), (uint32_t)modelStage);
+}
+
+int DualPipeFrameSource::ToModelInput(image_t *frame, const uint8_t *modelStage, image_t *modelInput)
+{
+    (void)frame;
+
+    return imlib_nvt_YUV420PtoRGB888(modelStage, modelInput, m_lut);
+}
+
+size_t DualPipeFrameSource::ModelStageSize() const
+{
+    return m_modelStageSize;
+}
+
+int TiledFrameSource::Init(const image_t *frame, const image_t *modelInput)
+{
+    /* Tiles are crops of the stage, no larger than it */
+    if ((modelInput->w > ms_stageWidth) || (modelInput->h > ms_stageHeight))
+        return -1;
+
+    if (ImageSensor_InitEx(ms_stageWidth, ms_stageHeight) != 0)
+        return -1;
+
+    if (ImageSensor_ConfigDualPipe(eIMAGE_FMT_RGB565, frame->w, frame->h, ms_stageWidth, ms_stageHeight, true) != 0)
+        return -1;
+
+    /* YUV420P: Y, then quarter size U and V */
+    m_modelStageSize = (ms_stageWidth * ms_stageHeight * 3) / 2;
+
+    return 0;
+}
+
+int TiledFrameSource::Capture(image_t *frame, uint8_t *modelStage)
+{
+    /* The stage is too large for non-cacheable SRAM. CCAP writes it behind
+     * the D-cache: drop its lines before, so that none is evicted over the
+     * new frame, and after, so that none cached meanwhile hides it */
+#if defined(__ZEPHYR__)
+    sys_cache_data_invd_range(modelStage, m_modelStageSize);
+#else
+    SCB_InvalidateDCache_by_Addr(modelStage, (int32_t)m_modelStageSize);
+#endif
+
+    int i32Ret = ImageSensor_CaptureDualPipe((uint32_t)(frame->data), (uint32_t)modelStage);
+
+#if defined(__ZEPHYR__)
+    sys_cache_data_invd_range(modelStage, m_modelStageSize);
+#else
+    SCB_InvalidateDCache_by_Addr(modelStage, (int32_t)m_modelStageSize);
+#endif
+
+    return i32Ret;
+}
+
+int TiledFrameSource::TileToModelInput(const uint8_t *modelStage, const rectangle_t *tile, image_t *modelInput)
+{
+    return imlib_nvt_YUV420PtoRGB888_roi(modelStage, ms_stageWidth, ms_stageHeight, tile, modelInput, m_lut);
+}
+
+size_t TiledFrameSource::ModelStageSize() const
+{
+    return m_modelStageSize;
+}
+#endif
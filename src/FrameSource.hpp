@@ -0,0 +1,181 @@
+/**************************************************************************//**
+ * @file     FrameSource.hpp
+ * @version  V1.00
+ * @brief    Frame sources of the object detection main loop
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef FRAME_SOURCE_HPP
+#define FRAME_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "imlib.h"
+
+/*
+ * Where the main loop gets its frames from. Each capture fills an RGB565
+ * display frame and, for sources with a second output, a model stage the
+ * size of ModelStageSize(). ToModelInput() later turns the two into the
+ * model input, once the previous inference no longer reads it.
+ */
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    /**
+     * @brief       Prepare the source for frames and model inputs of these sizes.
+     * @param[in]   frame        Display frame, RGB565.
+     * @param[in]   modelInput   Model input, RGB888 or int8 RGB.
+     * @return      0 on success, <0 on failure.
+     */
+    virtual int Init(const image_t *frame, const image_t *modelInput) = 0;
+
+    /**
+     * @brief       Capture the next frame.
+     * @param[out]  frame        Display frame.
+     * @param[out]  modelStage   Second output of ModelStageSize() bytes, unused if that is 0.
+     * @return      0 on success, <0 on failure.
+     */
+    virtual int Capture(image_t *frame, uint8_t *modelStage) = 0;
+
+    /**
+     * @brief       Fill the model input from a captured frame.
+     * @param[in]   frame        Display frame, as captured.
+     * @param[in]   modelStage   Second output, as captured.
+     * @param[out]  modelInput   Model input.
+     * @return      0 on success, <0 on failure.
+     */
+    virtual int ToModelInput(image_t *frame, const uint8_t *modelStage, image_t *modelInput) = 0;
+
+    /**
+     * @brief       Fill the model input from a tile of the model stage, for
+     *              sources whose stage is larger than the model input.
+     * @param[in]   modelStage   Second output, as captured.
+     * @param[in]   tile         Model input sized tile, in stage pixels.
+     * @param[out]  modelInput   Model input.
+     * @return      0 on success, <0 on failure or if the source has no tiles.
+     */
+    virtual int TileToModelInput(const uint8_t *modelStage, const rectangle_t *tile, image_t *modelInput)
+    {
+        (void)modelStage;
+        (void)tile;
+        (void)modelInput;
+
+        return -1;
+    }
+
+    /**
+     * @brief       Bytes of the second output per frame.
+     * @return      0 if the model input is taken from the display frame.
+     */
+    virtual size_t ModelStageSize() const
+    {
+        return 0;
+    }
+};
+
+/* Model input resized from the display frame by a scale plan */
+class PlannedFrameSource : public FrameSource
+{
+public:
+    explicit PlannedFrameSource(const nvt_scale_plan_t *inputPlan) :
+        m_inputPlan(inputPlan)
+    {}
+
+    int ToModelInput(image_t *frame, const uint8_t *modelStage, image_t *modelInput) override;
+
+protected:
+    const nvt_scale_plan_t *m_inputPlan;
+};
+
+/*
+ * The baked-in images, in turn. Needs no sensor, so it also stands in for
+ * the camera when the main loop runs on a board without one, and in the
+ * host tests of the frame slots, on imlib built with emulated intrinsics.
+ */
+class ImageFrameSource : public PlannedFrameSource
+{
+public:
+    explicit ImageFrameSource(const nvt_scale_plan_t *inputPlan) :
+        PlannedFrameSource(inputPlan)
+    {}
+
+    int Init(const image_t *frame, const image_t *modelInput) override;
+    int Capture(image_t *frame, uint8_t *modelStage) override;
+
+private:
+    nvt_scale_plan_t m_imagePlan;
+    uint32_t m_imageIdx{0};
+};
+
+#if defined (__USE_CCAP__)
+/* CCAP packet pipe, RGB565 */
+class CameraFrameSource : public PlannedFrameSource
+{
+public:
+    explicit CameraFrameSource(const nvt_scale_plan_t *inputPlan) :
+        PlannedFrameSource(inputPlan)
+    {}
+
+    int Init(const image_t *frame, const image_t *modelInput) override;
+    int Capture(image_t *frame, uint8_t *modelStage) override;
+};
+
+/*
+ * CCAP packet and planar pipes in the same frame: RGB565 for display, and
+ * YUV420P already scaled by CCAP to the model input size. Only the color
+ * conversion to the model input is left to the CPU.
+ */
+class DualPipeFrameSource : public FrameSource
+{
+public:
+    /* lut quantizes to int8, nullptr for an RGB888 model input */
+    explicit DualPipeFrameSource(const rgb565_int8_lut_t *lut) :
+        m_lut(lut)
+    {}
+
+    int Init(const image_t *frame, const image_t *modelInput) override;
+    int Capture(image_t *frame, uint8_t *modelStage) override;
+    int ToModelInput(image_t *frame, const uint8_t *modelStage, image_t *modelInput) override;
+    size_t ModelStageSize() const override;
+
+private:
+    const rgb565_int8_lut_t *m_lut;
+    size_t m_modelStageSize{0};
+};
+
+/*
+ * CCAP packet and planar pipes in the same frame, with the sensor at VGA:
+ * RGB565 for display, and YUV420P at the full sensor resolution, which
+ * the model reads in model input sized tiles. Small objects keep the
+ * pixels the display frame and a whole-frame resize throw away. The
+ * whole-frame ToModelInput still resizes the display frame.
+ */
+class TiledFrameSource : public PlannedFrameSource
+{
+public:
+    /* Model stage size, the HM1055 VGA mode */
+    static constexpr int ms_stageWidth = 640;
+    static constexpr int ms_stageHeight = 480;
+
+    /* lut quantizes to int8, nullptr for an RGB888 model input */
+    TiledFrameSource(const nvt_scale_plan_t *inputPlan, const rgb565_int8_lut_t *lut) :
+        PlannedFrameSource(inputPlan),
+        m_lut(lut)
+    {}
+
+    int Init(const image_t *frame, const image_t *modelInput) override;
+    int Capture(image_t *frame, uint8_t *modelStage) override;
+    int TileToModelInput(const uint8_t *modelStage, const rectangle_t *tile, image_t *modelInput) override;
+    size_t ModelStageSize() const override;
+
+private:
+    const rgb565_int8_lut_t *m_lut;
+    size_t m_modelStageSize{0};
+};
+#endif
+
+#endif /* FRAME_SOURCE_HPP */
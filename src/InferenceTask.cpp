@@ -6,6 +6,8 @@
  * @copyright (C) 2022 Nuvoton Technology Corp. All rights reserved.
  ******************************************************************************/
 
+#include <cstring>
+
 #include "InferenceTask.hpp"
 #include "log_macros.h"      /* Logging macros */
 
@@ -17,6 +19,76 @@ InferenceProcess::InferenceProcess(
     :   m_model(model)
 {}
 
+InferenceProcess::InferenceProcess(
+    Model *model,
+    NpuScheduler *npuScheduler,
+    int npuClient,
+    int npuPriority,
+    uint32_t u32NpuDeadlineUs)
+    :   m_model(model),
+        m_npuScheduler(npuScheduler)
+{
+    m_npuJob.client = npuClient;
+    m_npuJob.priority = npuPriority;
+    m_npuJob.u32DeadlineUs = u32NpuDeadlineUs;
+    m_npuJob.pfnDone = NpuJobDone;
+    m_npuJob.pvOwner = this;
+
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_init(&m_npuDone, 0, 1);
+#else
+    m_npuDone = xSemaphoreCreateBinary();
+#endif
+}
+
+void InferenceProcess::NpuJobDone(xNpuJob *job)
+{
+    InferenceProcess *process = static_cast<InferenceProcess *>(job->pvOwner);
+
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    k_sem_give(&process->m_npuDone);
+#else
+    xSemaphoreGive(process->m_npuDone);
+#endif
+}
+
+bool InferenceProcess::RunInference()
+{
+#if defined(__PROFILE__)
+    profiler.StartProfiling("Inference");
+#endif
+
+    bool runInf;
+
+    if (m_npuScheduler == nullptr)
+    {
+        runInf = m_model->RunInference();
+    }
+    else if (m_npuScheduler->Submit(&m_npuJob) != 0)
+    {
+        runInf = false;
+    }
+    else
+    {
+        /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+        k_sem_take(&m_npuDone, K_FOREVER);
+#else
+        xSemaphoreTake(m_npuDone, portMAX_DELAY);
+#endif
+        runInf = (m_npuJob.eStatus == eNPU_JOB_DONE);
+    }
+
+#if defined(__PROFILE__)
+    profiler.StopProfiling();
+    profiler.PrintProfilingResult();
+#endif
+
+    return runInf;
+}
+
 bool InferenceProcess::RunJob(
     object_detection::DetectorPostprocessing *pPostProc,
     int modelCols,
@@ -31,16 +103,11 @@ bool InferenceProcess::RunJob(
 #if defined(__PROFILE__)
     uint64_t u64StartCycle;
     uint64_t u64EndCycle;
-
-    profiler.StartProfiling("Inference");
 #endif
 
-    bool runInf = m_model->RunInference();
-
-#if defined(__PROFILE__)
-    profiler.StopProfiling();
-    profiler.PrintProfilingResult();
-#endif
+    /* Outputs of a failed or expired inference are not this input's */
+    if (!RunInference())
+        return false;
 
     TfLiteTensor *modelOutput0 = m_model->GetOutputTensor(0);
     TfLiteTensor *modelOutput1 = m_model->GetOutputTensor(1);
@@ -63,11 +130,99 @@ bool InferenceProcess::RunJob(
     info("post processing cycles %llu \n", (u64EndCycle - u64StartCycle));
 #endif
 
-    return runInf;
+    return true;
 }
 
 }// namespace InferenceProcess
 
+/* Final results of a job, once post-processed if inferred. lastResults
+ * holds those of the previous job, which come from the same stage */
+static void FinishResults(xInferenceJob *xJob, std::vector<object_detection::DetectionResult> &lastResults)
+{
+    /* One tracker step per captured frame, so that velocities stay per frame */
+    if (xJob->pTracker)
+        xJob->pTracker->Advance(xJob->u32FramesDropped);
+
+    switch (xJob->eResults)
+    {
+    case eJOB_RESULTS_REUSE:
+    case eJOB_RESULTS_PREDICT:
+        if (xJob->pTracker)
+            xJob->pTracker->Predict(*xJob->results);
+        else
+            *xJob->results = lastResults;
+        break;
+
+    default:
+        if (xJob->pTracker)
+            xJob->pTracker->Update(*xJob->results);
+        break;
+    }
+
+    lastResults = *xJob->results;
+}
+
+/* Infer the tiles of a job one after another, each post-processed into the
+ * job's results before the next overwrites the output tensors, then merge
+ * them. Its results are then final, as if post-processed */
+static void RunTiles(InferenceProcess::InferenceProcess &inferenceProcess, Model *model, xInferenceJob *xJob)
+{
+    rectangle_t tiles[TilePlanner::ms_maxTiles];
+    int tileEnd[TilePlanner::ms_maxTiles];
+    int numTiles = xJob->pTilePlanner->Plan(xJob->bAdaptiveTiles, tiles);
+    image_t modelInput;
+
+    modelInput.w = xJob->modelCols;
+    modelInput.h = xJob->mode1Rows;
+    modelInput.data = model->GetInputTensor(0)->data.uint8;
+    modelInput.pixfmt = PIXFORMAT_RGB888;
+
+    xJob->pPostProc->SetTopN(xJob->topN);
+
+    for (int i = 0; i < numTiles; i++)
+    {
+        const size_t first = xJob->results->size();
+
+        tileEnd[i] = static_cast<int>(first);
+
+#if defined(__PROFILE__)
+        uint64_t u64StartCycle = pmu_get_systick_Count();
+#endif
+        if (xJob->pFrameSource->TileToModelInput(xJob->modelStage, &tiles[i], &modelInput) != 0)
+        {
+            printf_err("Failed to fill model input from tile\n");
+            continue;
+        }
+#if defined(__PROFILE__)
+        info("tile convert and quantize cycles %llu \n", (pmu_get_systick_Count() - u64StartCycle));
+#endif
+
+        /* In tile pixels, then moved to the tile in the stage */
+        if (!inferenceProcess.RunJob(
+                    xJob->pPostProc,
+                    xJob->modelCols,
+                    xJob->mode1Rows,
+                    tiles[i].w,
+                    tiles[i].h,
+                    xJob->results
+                ))
+        {
+            printf_err("Failed to infer tile\n");
+            continue;
+        }
+
+        for (size_t n = first; n < xJob->results->size(); n++)
+        {
+            (*xJob->results)[n].m_x0 += tiles[i].x;
+            (*xJob->results)[n].m_y0 += tiles[i].y;
+        }
+
+        tileEnd[i] = static_cast<int>(xJob->results->size());
+    }
+
+    xJob->pTilePlanner->Merge(*xJob->results, tileEnd);
+}
+
 /* On zephyr, ethos-u overrides are implemented in zephyr driver
  * (zephyr/drivers/misc/ethos_u)
  */
@@ -140,7 +295,7 @@ extern "C" {
 
 #endif
 
-/* On zephyr, use k_queue */
+/* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
 void inferenceProcessTask(void *pvParameters, void *p2, void *p3)
 #else
@@ -149,38 +304,226 @@ void inferenceProcessTask(void *pvParameters)
 {
     struct ProcessTaskParams params = *reinterpret_cast<struct ProcessTaskParams *>(pvParameters);
 
-    InferenceProcess::InferenceProcess inferenceProcess(params.model);
+    InferenceProcess::InferenceProcess inferenceProcess(
+        params.model,
+        params.npuScheduler,
+        params.npuClient,
+        params.npuPriority,
+        params.u32NpuDeadlineUs);
+
+    /* Results of the last job, for the jobs reusing them */
+    std::vector<object_detection::DetectionResult> lastResults;
 
     for (;;)
     {
         xInferenceJob *xJob;
 
-        /* On zephyr, use k_queue */
+        /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-        xJob = static_cast<xInferenceJob *>(k_queue_get(params.queueHandle, Z_FOREVER));
+        xJob = static_cast<xInferenceJob *>(k_fifo_get(params.queueHandle, Z_FOREVER));
 #else
         xQueueReceive(params.queueHandle, &xJob, portMAX_DELAY);
 #endif
 
-        inferenceProcess.RunJob(
-                            xJob->pPostProc,
-                            xJob->modelCols,
-                            xJob->mode1Rows,
-                            xJob->srcImgWidth,
-                            xJob->srcImgHeight,
-                            xJob->results
-                        );
+        /* Nothing to infer, or tiles inferred and post-processed right here:
+         * post-processing or here, whichever has the results, fills them in */
+        if ((xJob->eResults != eJOB_RESULTS_INFER) || (xJob->pTilePlanner != nullptr))
+        {
+            if (xJob->eResults == eJOB_RESULTS_INFER)
+                RunTiles(inferenceProcess, params.model, xJob);
+
+            xJob->pOutputCopy = nullptr;
 
-        /* On zephyr, use k_queue */
+            /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-        k_queue_alloc_append(xJob->responseQueue, xJob);
+            if (params.postProcessQueue == nullptr)
+            {
+                FinishResults(xJob, lastResults);
+                k_fifo_put(xJob->responseQueue, xJob);
+            }
+            else
+            {
+                k_fifo_put(params.postProcessQueue, xJob);
+            }
 #else
-        xQueueSend(xJob->responseQueue, &xJob, portMAX_DELAY);
+            if (params.postProcessQueue == nullptr)
+            {
+                FinishResults(xJob, lastResults);
+                xQueueSend(xJob->responseQueue, &xJob, portMAX_DELAY);
+            }
+            else
+            {
+                xQueueSend(params.postProcessQueue, &xJob, portMAX_DELAY);
+            }
+#endif
+            continue;
+        }
+
+        /* Model input of this job */
+        if (xJob->pFrameSource)
+        {
+            image_t modelInput;
+
+            modelInput.w = xJob->modelCols;
+            modelInput.h = xJob->mode1Rows;
+            modelInput.data = params.model->GetInputTensor(0)->data.uint8;
+            modelInput.pixfmt = PIXFORMAT_RGB888;
+
+#if defined(__PROFILE__)
+            uint64_t u64StartCycle = pmu_get_systick_Count();
+#endif
+            xJob->pFrameSource->ToModelInput(xJob->frame, xJob->modelStage, &modelInput);
+#if defined(__PROFILE__)
+            info("resize and quantize cycles %llu \n", (pmu_get_systick_Count() - u64StartCycle));
+#endif
+        }
+
+        if (params.postProcessQueue == nullptr)
+        {
+            xJob->pPostProc->SetTopN(xJob->topN);
+
+            /* Failed or expired: the last results stand in */
+            if (!inferenceProcess.RunJob(
+                        xJob->pPostProc,
+                        xJob->modelCols,
+                        xJob->mode1Rows,
+                        xJob->srcImgWidth,
+                        xJob->srcImgHeight,
+                        xJob->results
+                    ))
+                xJob->eResults = eJOB_RESULTS_REUSE;
+
+            FinishResults(xJob, lastResults);
+
+            /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+            k_fifo_put(xJob->responseQueue, xJob);
+#else
+            xQueueSend(xJob->responseQueue, &xJob, portMAX_DELAY);
+#endif
+            continue;
+        }
+
+        /* Failed or expired: the last results stand in */
+        if (!inferenceProcess.RunInference())
+        {
+            xJob->eResults = eJOB_RESULTS_REUSE;
+            xJob->pOutputCopy = nullptr;
+
+            /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+            k_fifo_put(params.postProcessQueue, xJob);
+#else
+            xQueueSend(params.postProcessQueue, &xJob, portMAX_DELAY);
+#endif
+            continue;
+        }
+
+        /* Copy the outputs out, so that the next job can run inference while this one is post-processed */
+        xOutputCopy *psOutputCopy;
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        psOutputCopy = static_cast<xOutputCopy *>(k_fifo_get(params.freeOutputQueue, Z_FOREVER));
+#else
+        xQueueReceive(params.freeOutputQueue, &psOutputCopy, portMAX_DELAY);
+#endif
+
+#if defined(__PROFILE__)
+        uint64_t u64CopyStartCycle = pmu_get_systick_Count();
+#endif
+        TfLiteTensor *modelOutput0 = params.model->GetOutputTensor(0);
+        TfLiteTensor *modelOutput1 = params.model->GetOutputTensor(1);
+
+        memcpy(psOutputCopy->output0, modelOutput0->data.int8, modelOutput0->bytes);
+        memcpy(psOutputCopy->output1, modelOutput1->data.int8, modelOutput1->bytes);
+#if defined(__PROFILE__)
+        info("output copy cycles %llu \n", (pmu_get_systick_Count() - u64CopyStartCycle));
+#endif
+
+        xJob->pOutputCopy = psOutputCopy;
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        k_fifo_put(params.postProcessQueue, xJob);
+#else
+        xQueueSend(params.postProcessQueue, &xJob, portMAX_DELAY);
 #endif
     }
 
 }
 
+/* Post-processing stage: decode the output copy of each job, hand the copy
+ * back to inference and the job on to its response queue */
+/* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+void postProcessTask(void *pvParameters, void *p2, void *p3)
+#else
+void postProcessTask(void *pvParameters)
+#endif
+{
+    struct PostProcessTaskParams params = *reinterpret_cast<struct PostProcessTaskParams *>(pvParameters);
+
+    /* Results of the last job, for the jobs reusing them */
+    std::vector<object_detection::DetectionResult> lastResults;
+
+    for (;;)
+    {
+        xInferenceJob *xJob;
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        xJob = static_cast<xInferenceJob *>(k_fifo_get(params.queueHandle, Z_FOREVER));
+#else
+        xQueueReceive(params.queueHandle, &xJob, portMAX_DELAY);
+#endif
+
+        /* Nothing to decode: reused, predicted or tiled results */
+        if (xJob->pOutputCopy == nullptr)
+        {
+            FinishResults(xJob, lastResults);
+
+            /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+            k_fifo_put(xJob->responseQueue, xJob);
+#else
+            xQueueSend(xJob->responseQueue, &xJob, portMAX_DELAY);
+#endif
+            continue;
+        }
+
+        xOutputCopy *psOutputCopy = xJob->pOutputCopy;
+
+        xJob->pPostProc->SetTopN(xJob->topN);
+
+#if defined(__PROFILE__)
+        uint64_t u64StartCycle = pmu_get_systick_Count();
+#endif
+        xJob->pPostProc->RunPostProcessing(
+            xJob->srcImgHeight,
+            xJob->srcImgWidth,
+            psOutputCopy->output0,
+            psOutputCopy->output1,
+            *xJob->results);
+#if defined(__PROFILE__)
+        info("post processing cycles %llu \n", (pmu_get_systick_Count() - u64StartCycle));
+#endif
+
+        xJob->pOutputCopy = nullptr;
+
+        FinishResults(xJob, lastResults);
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        k_fifo_put(params.freeOutputQueue, psOutputCopy);
+        k_fifo_put(xJob->responseQueue, xJob);
+#else
+        xQueueSend(params.freeOutputQueue, &psOutputCopy, portMAX_DELAY);
+        xQueueSend(xJob->responseQueue, &xJob, portMAX_DELAY);
+#endif
+    }
+}
+
 
 
 
@@ -19,7 +19,11 @@
 #endif
 
 #include "DetectorPostProcessing.hpp" /* Post-processing class. */
+#include "DetectionTracker.hpp"
+#include "FrameSource.hpp"
 #include "Model.hpp"
+#include "NpuScheduler.hpp"
+#include "TilePlanner.hpp"
 
 #if defined(__PROFILE__)
     #include "Profiler.hpp"
@@ -34,6 +38,10 @@ class InferenceProcess
 {
 public:
     InferenceProcess(Model *model);
+    /* Inferences through npuScheduler as client, with this priority and
+     * deadline, 0 for none. An expired inference counts as failed */
+    InferenceProcess(Model *model, NpuScheduler *npuScheduler, int npuClient, int npuPriority, uint32_t u32NpuDeadlineUs);
+    bool RunInference();
     bool RunJob(
         object_detection::DetectorPostprocessing *pPostProc,
         int modelCols,
@@ -48,25 +56,74 @@ protected:
 #endif
 
     Model *m_model = nullptr;
+
+    NpuScheduler *m_npuScheduler = nullptr;
+    xNpuJob m_npuJob;
+    /* On zephyr, use k_sem */
+#if defined(__ZEPHYR__)
+    struct k_sem m_npuDone;
+#else
+    SemaphoreHandle_t m_npuDone;
+#endif
+
+    static void NpuJobDone(xNpuJob *job);
 };
 }// namespace InferenceProcess
 
+/* Copy of the output tensors, which post-processing reads while the next
+ * inference already overwrites the tensors */
+struct xOutputCopy
+{
+    void *pvFifoReserved;   //First word, for k_fifo
+    int8_t *output0;
+    int8_t *output1;
+};
+
 struct ProcessTaskParams
 {
     Model *model;
-    /* On zephyr, use k_queue */
+    NpuScheduler *npuScheduler;     //nullptr to invoke the model right in the task
+    int npuClient;
+    int npuPriority;
+    uint32_t u32NpuDeadlineUs;
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    k_fifo *queueHandle;
+    k_fifo *postProcessQueue;   //nullptr to post-process in this task
+    k_fifo *freeOutputQueue;    //Output copies free for the next inference
+#else
+    QueueHandle_t queueHandle;
+    QueueHandle_t postProcessQueue;
+    QueueHandle_t freeOutputQueue;
+#endif
+};
+
+struct PostProcessTaskParams
+{
+    /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-    k_queue *queueHandle;
+    k_fifo *queueHandle;
+    k_fifo *freeOutputQueue;
 #else
     QueueHandle_t queueHandle;
+    QueueHandle_t freeOutputQueue;
 #endif
 };
 
+/* Where the results of a job come from */
+enum eJobResults
+{
+    eJOB_RESULTS_INFER,     //Inference of its frame
+    eJOB_RESULTS_REUSE,     //Scene unchanged, or inference failed: as eJOB_RESULTS_PREDICT
+    eJOB_RESULTS_PREDICT,   //Between sparse inferences: the tracker's, moved on by a frame
+};
+
 struct xInferenceJob
 {
-    /* On zephyr, use k_queue */
+    void *pvFifoReserved;   //First word, for k_fifo, so that queueing a job never allocates
+    /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-    k_queue *responseQueue;
+    k_fifo *responseQueue;
 #else
     QueueHandle_t responseQueue;
 #endif
@@ -75,15 +132,45 @@ struct xInferenceJob
     int mode1Rows;
     int srcImgWidth;
     int srcImgHeight;
+    int topN;
+
+    /* Fills the model input from frame and modelStage before inference, so
+     * that it is written only once the previous job is done with it */
+    FrameSource *pFrameSource;
+    image_t *frame;
+    const uint8_t *modelStage;
+
+    /* Infer the tiles it plans of modelStage rather than the whole frame,
+     * nullptr for none. Tiles are post-processed by the inference task */
+    TilePlanner *pTilePlanner;
+    bool bAdaptiveTiles;
+
+    /* Anything but eJOB_RESULTS_INFER skips inference */
+    eJobResults eResults;
+
+    /* Tracks the results from job to job, nullptr for none. Without one,
+     * eJOB_RESULTS_PREDICT reuses the last results */
+    object_detection::DetectionTracker *pTracker;
+    /* Frames dropped for this one since the last job, which the tracker
+     * moves on by all the same */
+    uint32_t u32FramesDropped;
 
     std::vector<object_detection::DetectionResult> *results;
+
+    /* Set by inference for the post-processing task */
+    xOutputCopy *pOutputCopy;
+
+    /* Left to the submitter, e.g. the frame slot the job belongs to */
+    void *pvOwner;
 };
 
-/* On zephyr, use k_queue */
+/* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
 void inferenceProcessTask(void *pvParameters, void *p2, void *p3);
+void postProcessTask(void *pvParameters, void *p2, void *p3);
 #else
 void inferenceProcessTask(void *pvParameters);
+void postProcessTask(void *pvParameters);
 #endif
 
 #endif
@@ -18,6 +18,8 @@
 
 #include "log_macros.h"
 
+#include <cinttypes>
+
 const tflite::MicroOpResolver &arm::app::YoloFastestModel::GetOpResolver()
 {
     return this->m_opResolver;
@@ -51,6 +53,35 @@ bool arm::app::YoloFastestModel::EnlistOperations()
     return true;
 }
 
+bool arm::app::YoloFastestModel::PostInit()
+{
+    const float *anchors[ms_numBranches] = {anchor1, anchor2};
+
+    if (this->GetNumOutputs() < ms_numBranches)
+    {
+        printf_err("Expected %" PRIu32 " output tensors\n", ms_numBranches);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < ms_numBranches; ++i)
+    {
+        QuantParams quantParams = GetTensorQuantParams(this->GetOutputTensor(i));
+        this->m_decodeTables[i].Build(quantParams.scale, quantParams.offset, anchors[i], ms_numBoxes);
+    }
+
+    return true;
+}
+
+arm::app::object_detection::YoloDecodeTable *arm::app::YoloFastestModel::GetDecodeTable(size_t index)
+{
+    if (index < ms_numBranches)
+    {
+        return &this->m_decodeTables[index];
+    }
+
+    return nullptr;
+}
+
 namespace arm
 {
 namespace app
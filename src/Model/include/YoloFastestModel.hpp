@@ -18,6 +18,8 @@
 #define YOLO_FASTEST_MODEL_HPP
 
 #include "Model.hpp"
+#include "YoloDecodeTable.hpp"
+#include "YoloFastestModelConfig.hpp"
 
 extern const int originalImageSize;
 extern const int channelsImageDisplayed;
@@ -39,6 +41,18 @@ public:
     static constexpr uint32_t ms_inputColsIdx     = 2;
     static constexpr uint32_t ms_inputChannelsIdx = 3;
 
+    /* Number of output branches and boxes (anchors) per cell */
+    static constexpr uint32_t ms_numBranches      = YoloFastestModelConfig::ms_numBranches;
+    static constexpr uint32_t ms_numBoxes         = YoloFastestModelConfig::ms_numBoxes;
+
+    /**
+     * @brief       Gets the decode lookup table of the given output branch.
+     *              It is built at Init, for the output tensor's quantization.
+     * @param[in]   index   Output branch index.
+     * @return      Pointer to the table, or nullptr if index is out of range.
+     **/
+    object_detection::YoloDecodeTable *GetDecodeTable(size_t index);
+
 protected:
     /** @brief   Gets the reference to op resolver interface class. */
     const tflite::MicroOpResolver &GetOpResolver() override;
@@ -50,12 +64,18 @@ protected:
 
     size_t ModelSize();
 
+    /** @brief   Builds the decode lookup tables for the output tensors. */
+    bool PostInit() override;
+
 private:
     /* Maximum number of individual operations that can be enlisted. */
     static constexpr int ms_maxOpCnt = 8;
 
     /* A mutable op resolver instance. */
     tflite::MicroMutableOpResolver<ms_maxOpCnt> m_opResolver;
+
+    /* Decode lookup tables, one per output branch. */
+    object_detection::YoloDecodeTable m_decodeTables[ms_numBranches];
 };
 
 } /* namespace app */
@@ -0,0 +1,52 @@
+/**************************************************************************//**
+ * @file     YoloFastestModelConfig.hpp
+ * @version  V1.00
+ * @brief    Compile-time output head layout of the YOLO-Fastest models
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef YOLO_FASTEST_MODEL_CONFIG_HPP
+#define YOLO_FASTEST_MODEL_CONFIG_HPP
+
+namespace arm
+{
+namespace app
+{
+
+/*
+ * Output head of the YOLO-Fastest INT8 model, the same as the anchors and
+ * numClasses of yolo-fastest_int8.tflite.cpp: two branches, 3 boxes per
+ * cell, 80 COCO classes.
+ */
+struct YoloFastestInt8Config
+{
+    static constexpr int ms_numBranches = 2;
+    static constexpr int ms_numBoxes    = 3;
+    static constexpr int ms_numClasses  = 80;
+
+    /* Anchor width and height per box, per branch */
+    static constexpr float ms_anchors[ms_numBranches][ms_numBoxes * 2] =
+    {
+        {12, 18, 37, 49, 52, 132},
+        {115, 73, 119, 199, 242, 238}
+    };
+};
+
+/* Vela compilation for Ethos-U55/256 MAC keeps the output head */
+struct YoloFastestInt8EthosU55_256SizeConfig : YoloFastestInt8Config {};
+struct YoloFastestInt8EthosU55_256SpeedConfig : YoloFastestInt8Config {};
+
+/* Head layout of the model selected by NVT_ML_OD_MODEL_CHOICE */
+#if defined(CONFIG_NVT_ML_OD_MODEL_YOLO_FASTEST_INT8_ETHOS_U55_256_SIZE)
+using YoloFastestModelConfig = YoloFastestInt8EthosU55_256SizeConfig;
+#elif defined(CONFIG_NVT_ML_OD_MODEL_YOLO_FASTEST_INT8_ETHOS_U55_256_SPEED)
+using YoloFastestModelConfig = YoloFastestInt8EthosU55_256SpeedConfig;
+#else
+using YoloFastestModelConfig = YoloFastestInt8Config;
+#endif
+
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* YOLO_FASTEST_MODEL_CONFIG_HPP */
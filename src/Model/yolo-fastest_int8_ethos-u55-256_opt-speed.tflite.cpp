@@ -26,11 +26,16 @@
 #include <cstddef>
 #include <cstdint>
 
+/* With NVT_ML_OD_MODEL_SWITCHING, both variants are linked, and the one
+ * chosen by NVT_ML_OD_MODEL_CHOICE defines the model globals, the same
+ * for both, and the default getters */
+#if !defined(CONFIG_NVT_ML_OD_MODEL_SWITCHING) || defined(CONFIG_NVT_ML_OD_MODEL_YOLO_FASTEST_INT8_ETHOS_U55_256_SPEED)
 extern const int originalImageSize = 320;
 extern const int channelsImageDisplayed = 3;
 extern const float anchor1[] = {12, 18, 37, 49, 52, 132};
 extern const float anchor2[] = {115, 73, 119, 199, 242, 238};
 extern const int numClasses = 80;
+#endif
 
 namespace arm
 {
@@ -16466,6 +16471,7 @@ static const uint8_t nn_model[] MODEL_TFLITE_ATTRIBUTE =
 };
 
 
+#if !defined(CONFIG_NVT_ML_OD_MODEL_SWITCHING) || defined(CONFIG_NVT_ML_OD_MODEL_YOLO_FASTEST_INT8_ETHOS_U55_256_SPEED)
 const uint8_t *GetModelPointer()
 {
     return nn_model;
@@ -16475,6 +16481,23 @@ size_t GetModelLen()
 {
     return sizeof(nn_model);
 }
+#endif
+
+/* Getters of this variant, whichever is the default */
+namespace opt_speed
+{
+
+const uint8_t *GetModelPointer()
+{
+    return nn_model;
+}
+
+size_t GetModelLen()
+{
+    return sizeof(nn_model);
+}
+
+} /* namespace opt_speed */
 
 } /* namespace arm */
 } /* namespace app */
@@ -0,0 +1,73 @@
+/**************************************************************************//**
+ * @file     MotionGate.cpp
+ * @version  V1.00
+ * @brief    Scene change detection gating the object detection inference
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "MotionGate.hpp"
+
+int MotionGate::Init(const image_t *frame)
+{
+    image_t srcImg = *frame;
+    image_t thumbImg;
+    rectangle_t roi;
+
+    thumbImg.w = ms_thumbWidth;
+    thumbImg.h = ms_thumbHeight;
+    thumbImg.data = nullptr;
+    thumbImg.pixfmt = PIXFORMAT_GRAYSCALE;
+
+    roi.x = 0;
+    roi.y = 0;
+    roi.w = frame->w;
+    roi.h = frame->h;
+
+    m_hasRef = false;
+
+    return imlib_nvt_scale_plan_init(&m_thumbPlan, &srcImg, &thumbImg, &roi, NVT_SCALE_NEAREST, nullptr);
+}
+
+void MotionGate::Configure(int pixelThreshold, int changedPermille, int refreshFrames)
+{
+    m_pixelThreshold = static_cast<uint8_t>(pixelThreshold);
+    m_changedPermille = changedPermille;
+    m_refreshFrames = refreshFrames;
+}
+
+bool MotionGate::Check(image_t *frame, bool force)
+{
+    const int thumbPixels = ms_thumbWidth * ms_thumbHeight;
+    const int newThumb = m_refThumb ^ 1;
+    image_t refImg;
+    image_t thumbImg;
+
+    thumbImg.w = ms_thumbWidth;
+    thumbImg.h = ms_thumbHeight;
+    thumbImg.data = m_thumbs[newThumb];
+    thumbImg.pixfmt = PIXFORMAT_GRAYSCALE;
+
+    if (imlib_nvt_scale_plan_run(&m_thumbPlan, frame, &thumbImg) != 0)
+        force = true;
+
+    m_framesSinceRef++;
+
+    if (m_hasRef && !force && ((m_refreshFrames == 0) || (m_framesSinceRef < static_cast<uint32_t>(m_refreshFrames))))
+    {
+        refImg = thumbImg;
+        refImg.data = m_thumbs[m_refThumb];
+
+        int32_t changed = imlib_nvt_count_changed(&refImg, &thumbImg, m_pixelThreshold);
+
+        /* Unchanged scene, the reference stays so that slow drift adds up */
+        if ((changed >= 0) && ((changed * 1000) <= (m_changedPermille * thumbPixels)))
+            return false;
+    }
+
+    m_refThumb = newThumb;
+    m_hasRef = true;
+    m_framesSinceRef = 0;
+
+    return true;
+}
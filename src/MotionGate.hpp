@@ -0,0 +1,64 @@
+/**************************************************************************//**
+ * @file     MotionGate.hpp
+ * @version  V1.00
+ * @brief    Scene change detection gating the object detection inference
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef MOTION_GATE_HPP
+#define MOTION_GATE_HPP
+
+#include <cstdint>
+
+#include "imlib.h"
+
+/*
+ * Tells whether a frame changed enough since the last inferred one to be
+ * worth an inference. Frames are compared as grayscale thumbnails, so that
+ * the check costs a small fraction of the model input resize.
+ */
+class MotionGate
+{
+public:
+    /* Thumbnail size, a quarter of the QVGA display frame each way */
+    static constexpr int ms_thumbWidth = 80;
+    static constexpr int ms_thumbHeight = 60;
+
+    /**
+     * @brief       Prepare for frames of this size.
+     * @param[in]   frame   Display frame, RGB565.
+     * @return      0 on success, <0 on failure.
+     */
+    int Init(const image_t *frame);
+
+    /**
+     * @brief       Set how much change triggers an inference.
+     * @param[in]   pixelThreshold    Gray level difference from which a thumbnail pixel counts as changed.
+     * @param[in]   changedPermille   Changed thumbnail pixels, in 1/1000, above which the scene changed.
+     * @param[in]   refreshFrames     Infer at least once every so many frames, 0 for no forced refresh.
+     */
+    void Configure(int pixelThreshold, int changedPermille, int refreshFrames);
+
+    /**
+     * @brief       Check a captured frame. When it is to be inferred, it
+     *              becomes the reference the next frames are checked against.
+     * @param[in]   frame   Display frame, as captured.
+     * @param[in]   force   Infer regardless, e.g. when the last inferred frame was dropped.
+     * @return      true to infer the frame, false to reuse the last results.
+     */
+    bool Check(image_t *frame, bool force);
+
+private:
+    nvt_scale_plan_t m_thumbPlan;
+    uint8_t m_thumbs[2][ms_thumbWidth * ms_thumbHeight];
+    int m_refThumb{0};              /* Index of the thumbnail of the last inferred frame */
+    bool m_hasRef{false};
+    uint32_t m_framesSinceRef{0};
+
+    uint8_t m_pixelThreshold{0};
+    int m_changedPermille{0};
+    int m_refreshFrames{0};
+};
+
+#endif /* MOTION_GATE_HPP */
@@ -0,0 +1,254 @@
+/**************************************************************************//**
+ * @file     NpuScheduler.cpp
+ * @version  V1.00
+ * @brief    Priority scheduling of the inferences of several models on one NPU
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "NpuScheduler.hpp"
+
+#include "Model.hpp"
+
+#if !defined(__ZEPHYR__)
+#include "task.h"
+#endif
+
+bool EthosuNpuBackend::Invoke(arm::app::Model *model)
+{
+    return model->RunInference();
+}
+
+uint64_t EthosuNpuBackend::NowUs()
+{
+    /* On zephyr, use kernel ticks */
+#if defined(__ZEPHYR__)
+    return k_ticks_to_us_floor64(k_uptime_ticks());
+#else
+    return static_cast<uint64_t>(xTaskGetTickCount()) * portTICK_PERIOD_MS * 1000;
+#endif
+}
+
+NpuScheduler::NpuScheduler(NpuBackend *backend) :
+    m_backend(backend)
+{
+    /* On zephyr, use k_mutex and k_sem */
+#if defined(__ZEPHYR__)
+    k_mutex_init(&m_mutex);
+    k_sem_init(&m_submitted, 0, K_SEM_MAX_LIMIT);
+#else
+    m_mutex = xSemaphoreCreateMutex();
+    m_submitted = xSemaphoreCreateCounting(0xFFFF, 0);
+#endif
+}
+
+void NpuScheduler::Lock()
+{
+#if defined(__ZEPHYR__)
+    k_mutex_lock(&m_mutex, K_FOREVER);
+#else
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+#endif
+}
+
+void NpuScheduler::Unlock()
+{
+#if defined(__ZEPHYR__)
+    k_mutex_unlock(&m_mutex);
+#else
+    xSemaphoreGive(m_mutex);
+#endif
+}
+
+int NpuScheduler::AddClient(arm::app::Model *model, const char *name)
+{
+    Lock();
+
+    if (m_numClients == ms_maxClients)
+    {
+        Unlock();
+        return -1;
+    }
+
+    const int client = m_numClients;
+
+    m_clients[client].model = model;
+    m_clients[client].name = name;
+    m_clients[client].stats = ClientStats{};
+    m_numClients++;
+
+    Unlock();
+
+    return client;
+}
+
+int NpuScheduler::Submit(xNpuJob *job)
+{
+    Lock();
+
+    if ((job->client < 0) || (job->client >= m_numClients))
+    {
+        Unlock();
+        return -1;
+    }
+
+    job->pNext = nullptr;
+    job->u64SubmitUs = m_backend->NowUs();
+    job->u64StartByUs = (job->u32DeadlineUs != 0) ? (job->u64SubmitUs + job->u32DeadlineUs) : 0;
+    job->eStatus = eNPU_JOB_PENDING;
+
+    /* Appended, so that the list stays in submission order */
+    xNpuJob **ppTail = &m_pending;
+
+    while (*ppTail != nullptr)
+    {
+        ppTail = &(*ppTail)->pNext;
+    }
+
+    *ppTail = job;
+
+    Unlock();
+
+    /* One count per job, so that a pending job always has one left */
+#if defined(__ZEPHYR__)
+    k_sem_give(&m_submitted);
+#else
+    xSemaphoreGive(m_submitted);
+#endif
+
+    return 0;
+}
+
+bool NpuScheduler::Before(const xNpuJob *a, const xNpuJob *b)
+{
+    if (a->priority != b->priority)
+        return a->priority > b->priority;
+
+    /* No deadline is the latest one */
+    if (a->u64StartByUs != b->u64StartByUs)
+        return (b->u64StartByUs == 0) || ((a->u64StartByUs != 0) && (a->u64StartByUs < b->u64StartByUs));
+
+    return false;
+}
+
+bool NpuScheduler::RunNext(bool wait)
+{
+    if (wait)
+    {
+#if defined(__ZEPHYR__)
+        k_sem_take(&m_submitted, K_FOREVER);
+#else
+        xSemaphoreTake(m_submitted, portMAX_DELAY);
+#endif
+    }
+
+    xNpuJob *expired = nullptr;
+    xNpuJob *next = nullptr;
+    xNpuJob **ppNext = nullptr;
+
+    Lock();
+
+    const uint64_t u64NowUs = m_backend->NowUs();
+
+    /* Expire the jobs past their deadline, and find the next of the rest.
+     * Earlier submitted ones win ties, being found first */
+    for (xNpuJob **ppJob = &m_pending; *ppJob != nullptr;)
+    {
+        xNpuJob *job = *ppJob;
+
+        if ((job->u64StartByUs != 0) && (u64NowUs > job->u64StartByUs))
+        {
+            *ppJob = job->pNext;
+
+            job->eStatus = eNPU_JOB_EXPIRED;
+            job->pNext = expired;
+            expired = job;
+            m_clients[job->client].stats.u32Expired++;
+            continue;
+        }
+
+        if ((next == nullptr) || Before(job, next))
+        {
+            next = job;
+            ppNext = ppJob;
+        }
+
+        ppJob = &job->pNext;
+    }
+
+    if (next != nullptr)
+        *ppNext = next->pNext;
+
+    Unlock();
+
+    const bool ran = (expired != nullptr) || (next != nullptr);
+
+    while (expired != nullptr)
+    {
+        xNpuJob *job = expired;
+
+        expired = job->pNext;
+        job->pfnDone(job);
+    }
+
+    if (next == nullptr)
+        return ran;
+
+    Client &client = m_clients[next->client];
+    const uint64_t u64StartUs = m_backend->NowUs();
+    const bool ok = m_backend->Invoke(client.model);
+    const uint64_t u64EndUs = m_backend->NowUs();
+    const uint64_t u64QueueUs = u64StartUs - next->u64SubmitUs;
+
+    Lock();
+    client.stats.u32Run++;
+    client.stats.u32Failed += ok ? 0 : 1;
+    client.stats.u64QueueUsTotal += u64QueueUs;
+    client.stats.u64QueueUsMax = (u64QueueUs > client.stats.u64QueueUsMax) ? u64QueueUs : client.stats.u64QueueUsMax;
+    client.stats.u64InvokeUsTotal += u64EndUs - u64StartUs;
+    Unlock();
+
+    next->eStatus = ok ? eNPU_JOB_DONE : eNPU_JOB_FAILED;
+    next->pfnDone(next);
+
+    return true;
+}
+
+const char *NpuScheduler::GetStats(int client, ClientStats *stats)
+{
+    Lock();
+
+    if ((client < 0) || (client >= m_numClients))
+    {
+        Unlock();
+        return nullptr;
+    }
+
+    *stats = m_clients[client].stats;
+    const char *name = m_clients[client].name;
+
+    Unlock();
+
+    return name;
+}
+
+/* Dispatching thread, pvParameters is the NpuScheduler */
+/* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+void npuSchedulerTask(void *pvParameters, void *p2, void *p3)
+#else
+void npuSchedulerTask(void *pvParameters)
+#endif
+{
+#if defined(__ZEPHYR__)
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+#endif
+
+    NpuScheduler *scheduler = static_cast<NpuScheduler *>(pvParameters);
+
+    for (;;)
+    {
+        scheduler->RunNext(true);
+    }
+}
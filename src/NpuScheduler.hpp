@@ -0,0 +1,199 @@
+/**************************************************************************//**
+ * @file     NpuScheduler.hpp
+ * @version  V1.00
+ * @brief    Priority scheduling of the inferences of several models on one NPU
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef NPU_SCHEDULER_HPP
+#define NPU_SCHEDULER_HPP
+
+#include <cstdint>
+
+/* Zephyr, not FreeRTOS */
+#if defined(__ZEPHYR__)
+#include <zephyr/kernel.h>
+#else
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+namespace arm
+{
+namespace app
+{
+class Model;
+} /* namespace app */
+} /* namespace arm */
+
+/* Outcome of an NPU job */
+enum eNpuJobStatus
+{
+    eNPU_JOB_PENDING,       //Submitted, not run yet
+    eNPU_JOB_DONE,          //Inference run
+    eNPU_JOB_FAILED,        //Inference run, and failed
+    eNPU_JOB_EXPIRED,       //Not started by its deadline, so not run
+};
+
+struct xNpuJob
+{
+    xNpuJob *pNext;         //Pending list link, so that submitting a job never allocates
+    int client;             //From NpuScheduler::AddClient
+    int priority;           //Higher runs first
+    uint32_t u32DeadlineUs; //Latest start after submission, 0 for none
+
+    uint64_t u64SubmitUs;   //Set by Submit, NpuBackend::NowUs() time
+    uint64_t u64StartByUs;  //Set by Submit from u32DeadlineUs, 0 for none
+
+    eNpuJobStatus eStatus;
+
+    /* Called from the dispatching thread once the job is run or expired,
+     * e.g. to wake the submitter. The job is the submitter's again */
+    void (*pfnDone)(xNpuJob *job);
+
+    /* Left to the submitter */
+    void *pvOwner;
+};
+
+/* What the scheduler runs inferences on, and tells the time by; the host tests simulate one */
+class NpuBackend
+{
+public:
+    virtual ~NpuBackend() = default;
+
+    /**
+     * @brief       Run an inference of the model.
+     * @param[in]   model   Model, its input filled in.
+     * @return      true on success.
+     */
+    virtual bool Invoke(arm::app::Model *model) = 0;
+
+    /**
+     * @brief       Current time.
+     * @return      Microseconds since an arbitrary start.
+     */
+    virtual uint64_t NowUs() = 0;
+};
+
+/* The Ethos-U, through the model's interpreter, and the kernel clock */
+class EthosuNpuBackend : public NpuBackend
+{
+public:
+    bool Invoke(arm::app::Model *model) override;
+    uint64_t NowUs() override;
+};
+
+/*
+ * Shares one NPU between the models of several threads, e.g. a detector
+ * on video frames and a keyword spotter on audio windows. Each thread
+ * submits an inference as a job, with a priority and optionally a
+ * deadline, and a single dispatching thread runs one job at a time: the
+ * highest priority first, then the earliest deadline, then the earliest
+ * submitted. A job not started by its deadline expires instead of
+ * running late. A running inference is never preempted, so a job waits
+ * at most for the one running, and those of higher priority.
+ *
+ * Only the dispatching thread invokes the models, so the Ethos-U driver,
+ * which each Ethos-U operator reserves for itself, is never contended.
+ * Submitters fill the input of their model before Submit and read its
+ * outputs from pfnDone on, and must not submit their model again before.
+ */
+class NpuScheduler
+{
+public:
+    static constexpr int ms_maxClients = 4;
+
+    /* Jobs of a client, all times in microseconds */
+    struct ClientStats
+    {
+        uint32_t u32Run;            //Run, failed ones included
+        uint32_t u32Failed;
+        uint32_t u32Expired;
+        uint64_t u64QueueUsTotal;   //Submission to start, of the jobs run
+        uint64_t u64QueueUsMax;
+        uint64_t u64InvokeUsTotal;  //Inference time, of the jobs run
+    };
+
+    /**
+     * @brief       Constructor.
+     * @param[in]   backend   NPU to run the jobs on, and its clock.
+     */
+    explicit NpuScheduler(NpuBackend *backend);
+
+    /**
+     * @brief       Add a model that submits jobs.
+     * @param[in]   model   Model, invoked by the dispatching thread only from here on.
+     * @param[in]   name    Name in the statistics.
+     * @return      Client of its jobs, <0 if ms_maxClients are added already.
+     */
+    int AddClient(arm::app::Model *model, const char *name);
+
+    /**
+     * @brief       Queue a job. Any thread.
+     * @param[in]   job   Job, its client, priority, deadline and pfnDone set.
+     * @return      0 on success, <0 if the client is unknown.
+     */
+    int Submit(xNpuJob *job);
+
+    /**
+     * @brief       Dispatch: expire the jobs past their deadline, then run
+     *              the job next in turn, if any. The dispatching thread only.
+     * @param[in]   wait   Wait for a submission first.
+     * @return      true if a job was run or expired.
+     */
+    bool RunNext(bool wait);
+
+    /**
+     * @brief       Statistics of a client.
+     * @param[in]   client   Client.
+     * @param[out]  stats    Statistics.
+     * @return      Name of the client, nullptr if it is unknown.
+     */
+    const char *GetStats(int client, ClientStats *stats);
+
+    /** @brief      Number of clients added. */
+    int NumClients() const
+    {
+        return m_numClients;
+    }
+
+private:
+    struct Client
+    {
+        arm::app::Model *model;
+        const char *name;
+        ClientStats stats;
+    };
+
+    NpuBackend *m_backend;
+    Client m_clients[ms_maxClients];
+    int m_numClients{0};
+    xNpuJob *m_pending{nullptr};    /* In submission order */
+
+    /* On zephyr, use k_mutex and k_sem */
+#if defined(__ZEPHYR__)
+    struct k_mutex m_mutex;
+    struct k_sem m_submitted;
+#else
+    SemaphoreHandle_t m_mutex;
+    SemaphoreHandle_t m_submitted;
+#endif
+
+    void Lock();
+    void Unlock();
+
+    /**
+     * @brief       Whether job a runs before job b.
+     */
+    static bool Before(const xNpuJob *a, const xNpuJob *b);
+};
+
+/* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+void npuSchedulerTask(void *pvParameters, void *p2, void *p3);
+#else
+void npuSchedulerTask(void *pvParameters);
+#endif
+
+#endif /* NPU_SCHEDULER_HPP */
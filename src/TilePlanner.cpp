@@ -0,0 +1,274 @@
+/**************************************************************************//**
+ * @file     TilePlanner.cpp
+ * @version  V1.00
+ * @brief    Tiling of high-resolution frames into model inputs
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "TilePlanner.hpp"
+
+#include <algorithm>
+
+using arm::app::object_detection::DetectionResult;
+
+int TilePlanner::PlaceTiles(int length, int tile, int minOverlap, int16_t *origins)
+{
+    int num = 1;
+
+    if ((tile <= 0) || (tile > length) || (minOverlap < 0) || (minOverlap >= tile))
+        return -1;
+
+    if (length > tile)
+    {
+        const int step = tile - minOverlap;
+
+        num = 1 + (length - tile + step - 1) / step;
+    }
+
+    if (num > ms_maxTiles)
+        return -1;
+
+    /* Even origins keep the chroma of YUV420 tiles aligned */
+    for (int i = 0; i < num; i++)
+    {
+        origins[i] = (num > 1) ? static_cast<int16_t>(((length - tile) * i / (num - 1)) & ~1) : 0;
+    }
+
+    return num;
+}
+
+int TilePlanner::Init(int stageWidth, int stageHeight, int tileWidth, int tileHeight, int minOverlap,
+                      int frameWidth, int frameHeight, int fullGridFrames, int maxDetections)
+{
+    int16_t xs[ms_maxTiles];
+    int16_t ys[ms_maxTiles];
+    int numX = PlaceTiles(stageWidth, tileWidth, minOverlap, xs);
+    int numY = PlaceTiles(stageHeight, tileHeight, minOverlap, ys);
+
+    if ((numX < 0) || (numY < 0) || ((numX * numY) > ms_maxTiles))
+        return -1;
+
+    m_stageWidth = stageWidth;
+    m_stageHeight = stageHeight;
+    m_tileWidth = tileWidth;
+    m_tileHeight = tileHeight;
+    m_frameWidth = frameWidth;
+    m_frameHeight = frameHeight;
+    m_fullGridFrames = std::max(fullGridFrames, 1);
+
+    m_numGrid = 0;
+
+    for (int y = 0; y < numY; y++)
+    {
+        for (int x = 0; x < numX; x++)
+        {
+            rectangle_t &tile = m_grid[m_numGrid++];
+
+            tile.x = xs[x];
+            tile.y = ys[y];
+            tile.w = static_cast<int16_t>(tileWidth);
+            tile.h = static_cast<int16_t>(tileHeight);
+        }
+    }
+
+    m_framesSinceGrid = 0;
+    m_numPlanned = 0;
+
+    /* Each tile, adaptive ones too, returns up to maxDetections */
+    const size_t frameDetections = static_cast<size_t>(m_numGrid) * maxDetections;
+
+    m_last.clear();
+    m_last.reserve(frameDetections);
+    m_order.reserve(frameDetections);
+    m_dropped.reserve(frameDetections);
+    m_tileOf.reserve(frameDetections);
+
+    return 0;
+}
+
+rectangle_t TilePlanner::TileAround(const DetectionResult &detection) const
+{
+    const int centreX = detection.m_x0 + detection.m_w / 2;
+    const int centreY = detection.m_y0 + detection.m_h / 2;
+    rectangle_t tile;
+
+    tile.x = static_cast<int16_t>(std::min(std::max(centreX - m_tileWidth / 2, 0), m_stageWidth - m_tileWidth) & ~1);
+    tile.y = static_cast<int16_t>(std::min(std::max(centreY - m_tileHeight / 2, 0), m_stageHeight - m_tileHeight) & ~1);
+    tile.w = static_cast<int16_t>(m_tileWidth);
+    tile.h = static_cast<int16_t>(m_tileHeight);
+
+    return tile;
+}
+
+int TilePlanner::Plan(bool adaptive, rectangle_t *tiles)
+{
+    if (adaptive && (++m_framesSinceGrid < m_fullGridFrames))
+    {
+        int num = 0;
+        bool cheaper = true;
+
+        /* A tile around each detection not inside a tile already */
+        for (const auto &detection : m_last)
+        {
+            bool covered = false;
+
+            for (int i = 0; (i < num) && !covered; i++)
+            {
+                covered = (detection.m_x0 >= tiles[i].x) && (detection.m_y0 >= tiles[i].y) &&
+                          ((detection.m_x0 + detection.m_w) <= (tiles[i].x + tiles[i].w)) &&
+                          ((detection.m_y0 + detection.m_h) <= (tiles[i].y + tiles[i].h));
+            }
+
+            if (covered)
+                continue;
+
+            if (num == m_numGrid)
+            {
+                cheaper = false;
+                break;
+            }
+
+            tiles[num++] = TileAround(detection);
+        }
+
+        if (cheaper)
+        {
+            std::copy(tiles, tiles + num, m_planned);
+            m_numPlanned = num;
+            return num;
+        }
+    }
+
+    /* The full grid, also when tiling around the detections takes as many tiles */
+    m_framesSinceGrid = 0;
+    std::copy(m_grid, m_grid + m_numGrid, tiles);
+    std::copy(m_grid, m_grid + m_numGrid, m_planned);
+    m_numPlanned = m_numGrid;
+
+    return m_numGrid;
+}
+
+bool TilePlanner::TouchesSeam(const DetectionResult &detection, const rectangle_t &tile, const rectangle_t &other)
+{
+    /* Boxes clipped at a tile edge end within a pixel of it */
+    const int slack = 1;
+    const int tileRight = tile.x + tile.w;
+    const int tileBottom = tile.y + tile.h;
+    const bool leftInside = (tile.x > other.x) && (tile.x < (other.x + other.w));
+    const bool rightInside = (tileRight > other.x) && (tileRight < (other.x + other.w));
+    const bool topInside = (tile.y > other.y) && (tile.y < (other.y + other.h));
+    const bool bottomInside = (tileBottom > other.y) && (tileBottom < (other.y + other.h));
+
+    return (leftInside && (detection.m_x0 <= (tile.x + slack))) ||
+           (rightInside && ((detection.m_x0 + detection.m_w) >= (tileRight - slack))) ||
+           (topInside && (detection.m_y0 <= (tile.y + slack))) ||
+           (bottomInside && ((detection.m_y0 + detection.m_h) >= (tileBottom - slack)));
+}
+
+void TilePlanner::Merge(std::vector<DetectionResult> &results, const int *tileEnd)
+{
+    const int num = static_cast<int>(results.size());
+
+    m_order.resize(num);
+    m_dropped.assign(num, 0);
+    m_tileOf.assign(num, 0);
+
+    for (int i = 0; i < num; i++)
+    {
+        m_order[i] = i;
+    }
+
+    for (int t = 0, i = 0; t < m_numPlanned; t++)
+    {
+        for (; i < std::min(tileEnd[t], num); i++)
+        {
+            m_tileOf[i] = static_cast<uint8_t>(t);
+        }
+    }
+
+    /* Highest score first, ties in tile order */
+    std::sort(m_order.begin(), m_order.end(), [&results](int a, int b)
+    {
+        if (results[a].m_normalisedVal != results[b].m_normalisedVal)
+        {
+            return results[a].m_normalisedVal > results[b].m_normalisedVal;
+        }
+
+        return a < b;
+    });
+
+    m_last.clear();
+
+    for (int n = 0; n < num; n++)
+    {
+        const int i = m_order[n];
+
+        if (m_dropped[i])
+            continue;
+
+        /* Overlaps are of the box as detected, so that a union cannot chain into further neighbours */
+        const DetectionResult &kept = results[i];
+        const rectangle_t &keptTile = m_planned[m_tileOf[i]];
+        DetectionResult merged = kept;
+
+        for (int k = n + 1; k < num; k++)
+        {
+            const int j = m_order[k];
+            const DetectionResult &other = results[j];
+            const rectangle_t &otherTile = m_planned[m_tileOf[j]];
+
+            if (m_dropped[j] || (other.m_cls != kept.m_cls))
+                continue;
+
+            const int left = std::max(kept.m_x0, other.m_x0);
+            const int top = std::max(kept.m_y0, other.m_y0);
+            const int right = std::min(kept.m_x0 + kept.m_w, other.m_x0 + other.m_w);
+            const int bottom = std::min(kept.m_y0 + kept.m_h, other.m_y0 + other.m_h);
+
+            if ((right <= left) || (bottom <= top))
+                continue;
+
+            const float intersection = static_cast<float>(right - left) * (bottom - top);
+            const float keptArea = static_cast<float>(kept.m_w) * kept.m_h;
+            const float otherArea = static_cast<float>(other.m_w) * other.m_h;
+
+            if ((m_tileOf[i] != m_tileOf[j]) && (intersection > ms_mergeCover * std::min(keptArea, otherArea)) &&
+                (TouchesSeam(kept, keptTile, otherTile) || TouchesSeam(other, otherTile, keptTile)))
+            {
+                /* Seen whole by one tile and cut by the other's edge: the merged box spans both */
+                const int mergedRight = std::max(merged.m_x0 + merged.m_w, other.m_x0 + other.m_w);
+                const int mergedBottom = std::max(merged.m_y0 + merged.m_h, other.m_y0 + other.m_h);
+
+                merged.m_x0 = std::min(merged.m_x0, other.m_x0);
+                merged.m_y0 = std::min(merged.m_y0, other.m_y0);
+                merged.m_w = mergedRight - merged.m_x0;
+                merged.m_h = mergedBottom - merged.m_y0;
+                m_dropped[j] = 1;
+            }
+            else if (intersection > ms_mergeIou * (keptArea + otherArea - intersection))
+            {
+                m_dropped[j] = 1;
+            }
+        }
+
+        m_last.push_back(merged);
+    }
+
+    /* Stage to frame pixels */
+    results.clear();
+
+    for (const auto &detection : m_last)
+    {
+        DetectionResult scaled = detection;
+        const int right = ((detection.m_x0 + detection.m_w) * m_frameWidth) / m_stageWidth;
+        const int bottom = ((detection.m_y0 + detection.m_h) * m_frameHeight) / m_stageHeight;
+
+        scaled.m_x0 = (detection.m_x0 * m_frameWidth) / m_stageWidth;
+        scaled.m_y0 = (detection.m_y0 * m_frameHeight) / m_stageHeight;
+        scaled.m_w = right - scaled.m_x0;
+        scaled.m_h = bottom - scaled.m_y0;
+
+        results.push_back(scaled);
+    }
+}
@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @file     TilePlanner.hpp
+ * @version  V1.00
+ * @brief    Tiling of high-resolution frames into model inputs
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef TILE_PLANNER_HPP
+#define TILE_PLANNER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "imlib.h"
+#include "DetectionResult.hpp"
+
+/*
+ * Splits a model stage larger than the model input into overlapping model
+ * input sized tiles, and merges the detections of the tiles back into one
+ * set for the display frame. An object near a tile edge is seen whole by
+ * a neighbouring tile, so the merge drops duplicates across tiles and
+ * joins boxes cut by the seam of two tiles into the boxes they are part of.
+ * Boxes of one tile, or away from seams, are never joined: they are
+ * distinct objects the tile's own NMS kept.
+ *
+ * Adaptive tiling only infers tiles centred on the detections of the last
+ * frame, and the full grid every few frames to find new objects.
+ *
+ * Plan and Merge take turns, one frame at a time, from the same thread.
+ */
+class TilePlanner
+{
+public:
+    static constexpr int ms_maxTiles = 16;
+
+    /**
+     * @brief       Lay out the tile grid.
+     * @param[in]   stageWidth       Model stage width.
+     * @param[in]   stageHeight      Model stage height.
+     * @param[in]   tileWidth        Tile width, that of the model input.
+     * @param[in]   tileHeight       Tile height, that of the model input.
+     * @param[in]   minOverlap       Pixels neighbouring tiles share at least.
+     * @param[in]   frameWidth       Display frame width, merged boxes are scaled to it.
+     * @param[in]   frameHeight      Display frame height.
+     * @param[in]   fullGridFrames   With adaptive tiling, infer the full grid at least once every so many frames.
+     * @param[in]   maxDetections    Detections of a frame reserved for up front.
+     * @return      0 on success, <0 if the grid takes more than ms_maxTiles tiles.
+     */
+    int Init(int stageWidth, int stageHeight, int tileWidth, int tileHeight, int minOverlap,
+             int frameWidth, int frameHeight, int fullGridFrames, int maxDetections);
+
+    /**
+     * @brief       Tiles of the next frame.
+     * @param[in]   adaptive   Tile around the last detections only, rather than the full grid.
+     * @param[out]  tiles      Tiles, in stage pixels, room for ms_maxTiles.
+     * @return      Number of tiles, 0 when adaptive and nothing was detected.
+     */
+    int Plan(bool adaptive, rectangle_t *tiles);
+
+    /**
+     * @brief       Merge the detections of the tiles of the planned frame.
+     * @param[in,out]   results   Detections of all tiles in stage pixels in,
+     *                            tile after tile in planned order, merged
+     *                            detections in frame pixels out, highest
+     *                            score first.
+     * @param[in]       tileEnd   Per planned tile, the index in results one
+     *                            past its last detection.
+     */
+    void Merge(std::vector<arm::app::object_detection::DetectionResult> &results, const int *tileEnd);
+
+private:
+    /* Cross-tile NMS: a box of a class this much inside another is the same
+     * object, whole or cut, and one overlapping it by more than this IoU a
+     * duplicate */
+    static constexpr float ms_mergeIou = 0.45f;
+    static constexpr float ms_mergeCover = 0.6f;
+
+    int m_stageWidth{0};
+    int m_stageHeight{0};
+    int m_tileWidth{0};
+    int m_tileHeight{0};
+    int m_frameWidth{0};
+    int m_frameHeight{0};
+    int m_fullGridFrames{1};
+
+    rectangle_t m_grid[ms_maxTiles];
+    int m_numGrid{0};
+    int m_framesSinceGrid{0};
+    rectangle_t m_planned[ms_maxTiles];         /* Tiles of the planned frame */
+    int m_numPlanned{0};
+
+    std::vector<arm::app::object_detection::DetectionResult> m_last;   /* Merged detections of the last frame, stage pixels */
+    std::vector<int> m_order;                   /* Detections by descending score */
+    std::vector<uint8_t> m_dropped;             /* Detections merged into others */
+    std::vector<uint8_t> m_tileOf;              /* Planned tile of each detection */
+
+    /**
+     * @brief       Tile origins along one axis, evenly spread, on even pixels.
+     * @param[in]   length       Stage length.
+     * @param[in]   tile         Tile length.
+     * @param[in]   minOverlap   Pixels neighbouring tiles share at least.
+     * @param[out]  origins      Tile origins, room for ms_maxTiles.
+     * @return      Number of tiles, <0 if more than ms_maxTiles.
+     */
+    static int PlaceTiles(int length, int tile, int minOverlap, int16_t *origins);
+
+    /**
+     * @brief       Tile centred on a detection, inside the stage.
+     * @param[in]   detection   Detection, stage pixels.
+     * @return      Tile.
+     */
+    rectangle_t TileAround(const arm::app::object_detection::DetectionResult &detection) const;
+
+    /**
+     * @brief       Tell whether a detection reaches an edge of its tile that
+     *              lies inside another tile, i.e. may be cut by their seam.
+     * @param[in]   detection   Detection, stage pixels.
+     * @param[in]   tile        Tile it was detected in.
+     * @param[in]   other       Other tile.
+     * @return      true if it touches such an edge.
+     */
+    static bool TouchesSeam(const arm::app::object_detection::DetectionResult &detection,
+                            const rectangle_t &tile, const rectangle_t &other);
+};
+
+#endif /* TILE_PLANNER_HPP */
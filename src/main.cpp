@@ -8,6 +8,7 @@
  ******************************************************************************/
 #include <string>
 #include <cinttypes>
+#include <cstdlib>
 
 #include "BoardInit.hpp"      /* Board initialisation */
 /* On zephyr, redirect ml-embedded-evaluation-kit logging to zephyr way */
@@ -21,7 +22,12 @@
 #include "Labels.hpp"
 
 #include "InferenceTask.hpp"
+#include "FrameSlotRing.hpp"
+#include "FrameSource.hpp"
+#include "MotionGate.hpp"
+#include "TilePlanner.hpp"
 #include "DetectorPostProcessing.hpp"
+#include "DetectionTracker.hpp"
 #include "YoloFastestModel.hpp"       /* Model API */
 
 #include "imlib.h"          /* Image processing */
@@ -40,9 +46,6 @@
 
 #include "Profiler.hpp"
 
-#if defined (__USE_CCAP__)
-    #include "ImageSensor.h"
-#endif
 #if defined (__USE_DISPLAY__)
     #include "Display.h"
 #endif
@@ -55,6 +58,9 @@
 #if !defined(__ZEPHYR__)
 #define MAINLOOP_TASK_PRIO  4
 #define INFERENCE_TASK_PRIO 3
+#define RENDER_TASK_PRIO    3
+#define POSTPROCESS_TASK_PRIO 3
+#define NPU_SCHEDULER_TASK_PRIO 3
 #endif
 #define IMAGE_DISP_UPSCALE_FACTOR 1
 
@@ -64,24 +70,157 @@
     #define FONT_DISP_UPSCALE_FACTOR 1
 #endif
 
-#define NUM_FRAMEBUF 2  //1 or 2
-
-typedef enum
-{
-    eFRAMEBUF_EMPTY,
-    eFRAMEBUF_FULL,
-    eFRAMEBUF_INF
-} E_FRAMEBUF_STATE;
-
-typedef struct
-{
-    E_FRAMEBUF_STATE eState;
-    image_t frameImage;
-    std::vector<object_detection::DetectionResult> results;
-} S_FRAMEBUF;
-
+/* On zephyr, configure via Kconfig */
+#if defined(__ZEPHYR__)
+#define MAX_DETECTION_RESULTS CONFIG_NVT_ML_OD_MAX_DETECTIONS
+#if defined(CONFIG_NVT_ML_OD_DETECTION_POOL_GROW)
+#define DETECTION_POOL_GROW 1
+#else
+#define DETECTION_POOL_GROW 0
+#endif
+#define NUM_FRAMEBUF CONFIG_NVT_ML_OD_NUM_FRAMEBUF
+#if defined(CONFIG_NVT_ML_OD_NMS_CLASS_AGNOSTIC)
+#define NMS_MODE arm::app::object_detection::NmsMode::ClassAgnostic
+#elif defined(CONFIG_NVT_ML_OD_NMS_SORT_PER_CLASS)
+#define NMS_MODE arm::app::object_detection::NmsMode::PerClassSorted
+#else
+#define NMS_MODE arm::app::object_detection::NmsMode::PerClass
+#endif
+#if defined(CONFIG_NVT_ML_OD_BEST_CLASS_ONLY)
+#define CLASS_MODE arm::app::object_detection::ClassMode::BestClass
+#else
+#define CLASS_MODE arm::app::object_detection::ClassMode::AllClasses
+#endif
+#define CLASS_MASK CONFIG_NVT_ML_OD_CLASS_MASK
+#define TOP_N CONFIG_NVT_ML_OD_TOP_N
+#if defined(CONFIG_NVT_ML_OD_FIXED_POINT_POSTPROCESS)
+#define DECODE_MODE arm::app::object_detection::DecodeMode::FixedPoint
+#else
+#define DECODE_MODE arm::app::object_detection::DecodeMode::Int8Prefilter
+#endif
+#if defined(CONFIG_NVT_ML_OD_INPUT_SCALE_AREA)
+#define INPUT_SCALE_MODE NVT_SCALE_AREA
+#elif defined(CONFIG_NVT_ML_OD_INPUT_SCALE_BILINEAR)
+#define INPUT_SCALE_MODE NVT_SCALE_BILINEAR
+#else
+#define INPUT_SCALE_MODE NVT_SCALE_NEAREST
+#endif
+#if defined(CONFIG_NVT_ML_OD_INPUT_LETTERBOX)
+#define INPUT_LETTERBOX 1
+#else
+#define INPUT_LETTERBOX 0
+#endif
+#if defined(CONFIG_NVT_ML_OD_INPUT_CCAP_DUAL_PIPE)
+#define CCAP_DUAL_PIPE 1
+#else
+#define CCAP_DUAL_PIPE 0
+#endif
+#if defined(CONFIG_NVT_ML_OD_LATEST_FRAME_WINS)
+#define LATEST_FRAME_WINS 1
+#else
+#define LATEST_FRAME_WINS 0
+#endif
+/* Tiles are post-processed by the inference thread, leaving a post-processing thread nothing to decode */
+#if defined(CONFIG_NVT_ML_OD_POSTPROCESS_THREAD) && !defined(CONFIG_NVT_ML_OD_TILED_INFERENCE)
+#define POSTPROCESS_THREAD 1
+#else
+#define POSTPROCESS_THREAD 0
+#endif
+#if defined(CONFIG_NVT_ML_OD_MOTION_GATE)
+#define MOTION_GATE 1
+#else
+#define MOTION_GATE 0
+#endif
+#define MOTION_PIXEL_THRESHOLD CONFIG_NVT_ML_OD_MOTION_PIXEL_THRESHOLD
+#define MOTION_CHANGED_PERMILLE CONFIG_NVT_ML_OD_MOTION_CHANGED_PERMILLE
+#define MOTION_REFRESH_FRAMES CONFIG_NVT_ML_OD_MOTION_REFRESH_FRAMES
+#if defined(CONFIG_NVT_ML_OD_TRACKER)
+#define TRACKER 1
+#define MAX_TRACKS CONFIG_NVT_ML_OD_TRACKER_MAX_TRACKS
+#else
+#define TRACKER 0
+#endif
+#define INFER_INTERVAL CONFIG_NVT_ML_OD_INFER_INTERVAL
+#if defined(CONFIG_NVT_ML_OD_TILED_INFERENCE)
+#define TILED_INFERENCE 1
+#define TILE_MIN_OVERLAP CONFIG_NVT_ML_OD_TILE_MIN_OVERLAP
+#define TILED_FULL_GRID_FRAMES CONFIG_NVT_ML_OD_TILED_FULL_GRID_FRAMES
+#else
+#define TILED_INFERENCE 0
+#endif
+#if defined(CONFIG_NVT_ML_OD_TILED_ADAPTIVE)
+#define TILED_ADAPTIVE 1
+#else
+#define TILED_ADAPTIVE 0
+#endif
+#if defined(CONFIG_NVT_ML_OD_MODEL_SWITCHING)
+#define MODEL_SWITCHING 1
+#else
+#define MODEL_SWITCHING 0
+#endif
+/* Model at boot, as an index into model_names */
+#if defined(CONFIG_NVT_ML_OD_MODEL_YOLO_FASTEST_INT8_ETHOS_U55_256_SPEED)
+#define MODEL_BOOT 1
+#else
+#define MODEL_BOOT 0
+#endif
+#if defined(CONFIG_NVT_ML_NPU_SCHEDULER)
+#define NPU_SCHEDULER 1
+#define OD_NPU_PRIORITY CONFIG_NVT_ML_OD_NPU_PRIORITY
+#define OD_NPU_DEADLINE_MS CONFIG_NVT_ML_OD_NPU_DEADLINE_MS
+#else
+#define NPU_SCHEDULER 0
+#define OD_NPU_PRIORITY 0
+#define OD_NPU_DEADLINE_MS 0
+#endif
+#else
+#define MAX_DETECTION_RESULTS 128
+#define DETECTION_POOL_GROW 0
+#define NUM_FRAMEBUF 2
+#define NMS_MODE arm::app::object_detection::NmsMode::PerClass
+#define CLASS_MODE arm::app::object_detection::ClassMode::AllClasses
+#define CLASS_MASK ""
+#define TOP_N 0
+#define DECODE_MODE arm::app::object_detection::DecodeMode::Int8Prefilter
+#define INPUT_SCALE_MODE NVT_SCALE_NEAREST
+#define INPUT_LETTERBOX 0
+#define CCAP_DUAL_PIPE 0
+#define LATEST_FRAME_WINS 0
+#define POSTPROCESS_THREAD 0
+#define MOTION_GATE 0
+#define MOTION_PIXEL_THRESHOLD 24
+#define MOTION_CHANGED_PERMILLE 10
+#define MOTION_REFRESH_FRAMES 30
+#define TRACKER 0
+#define INFER_INTERVAL 1
+#define TILED_INFERENCE 0
+#define TILED_ADAPTIVE 0
+#define MODEL_SWITCHING 0
+#define MODEL_BOOT 0
+#define NPU_SCHEDULER 0
+#define OD_NPU_PRIORITY 0
+#define OD_NPU_DEADLINE_MS 0
+#endif
 
 S_FRAMEBUF s_asFramebuf[NUM_FRAMEBUF];
+static FrameSlotRing s_frameSlots;
+
+/* Per-frame scaling from frame to model input, resolved once */
+static nvt_scale_plan_t s_sInputScalePlan;
+
+/* Frames captured, and of those, dropped for a newer one before inference started */
+static volatile uint32_t s_u32FramesCaptured = 0;
+static volatile uint32_t s_u32FramesDropped = 0;
+/* Frames the motion gate let reuse the last results rather than be inferred */
+static volatile uint32_t s_u32FramesReused = 0;
+/* Frames between sparse inferences, taking the tracker's prediction */
+static volatile uint32_t s_u32FramesPredicted = 0;
+
+#if NPU_SCHEDULER
+/* One NPU, shared by the models of all threads through one dispatcher */
+static EthosuNpuBackend s_npuBackend;
+static NpuScheduler s_npuScheduler(&s_npuBackend);
+#endif
 
 
 /* FreeRTOS only */
@@ -120,6 +259,17 @@ K_CONDVAR_DEFINE(condvar_infer_ctrl);
 static bool infer_ctrl_cont;
 static bool infer_ctrl_oneshot;
 static bool record_ctrl_end;
+static int infer_ctrl_topn = TOP_N;
+static bool infer_ctrl_latest = LATEST_FRAME_WINS;
+static bool infer_ctrl_motion = MOTION_GATE;
+static int infer_ctrl_motion_pixel = MOTION_PIXEL_THRESHOLD;
+static int infer_ctrl_motion_permille = MOTION_CHANGED_PERMILLE;
+static int infer_ctrl_motion_refresh = MOTION_REFRESH_FRAMES;
+static int infer_ctrl_interval = INFER_INTERVAL;
+static bool infer_ctrl_adaptive_tiles = TILED_ADAPTIVE;
+/* Models od model switches between, linked with NVT_ML_OD_MODEL_SWITCHING */
+static const char *const model_names[] = {"size", "speed"};
+static int infer_ctrl_model = MODEL_BOOT;
 
 static int od_next_cmd_handler(const struct shell *sh, size_t argc, char **argv)
 {
@@ -189,11 +339,208 @@ static int od_suspend_cmd_handler(const struct shell *sh, size_t argc, char **ar
     return 0;
 }
 
+static int od_topn_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    char *end;
+    long topN = strtol(argv[1], &end, 10);
+
+    if (*end != '\0' || topN < 0 || topN > MAX_DETECTION_RESULTS)
+    {
+        shell_error(sh, "topN must be 0 to %d\n", MAX_DETECTION_RESULTS);
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    infer_ctrl_topn = (int)topN;
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    return 0;
+}
+
+static int od_mode_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    bool bLatest;
+
+    if (strcmp(argv[1], "latency") == 0)
+    {
+        bLatest = true;
+    }
+    else if (strcmp(argv[1], "throughput") == 0)
+    {
+        bLatest = false;
+    }
+    else
+    {
+        shell_error(sh, "mode must be latency or throughput\n");
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    infer_ctrl_latest = bLatest;
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    return 0;
+}
+
+static int od_motion_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    static const long maxParams[3] = {255, 1000, INT32_MAX};
+    long params[3];
+
+    if ((strcmp(argv[1], "on") == 0) || (strcmp(argv[1], "off") == 0))
+    {
+        k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+        infer_ctrl_motion = (strcmp(argv[1], "on") == 0);
+        k_mutex_unlock(&mutex_infer_ctrl);
+
+        return 0;
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    params[0] = infer_ctrl_motion_pixel;
+    params[1] = infer_ctrl_motion_permille;
+    params[2] = infer_ctrl_motion_refresh;
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    for (size_t i = 1; i < argc; i++)
+    {
+        char *end;
+
+        params[i - 1] = strtol(argv[i], &end, 10);
+
+        if (*end != '\0' || params[i - 1] < 0 || params[i - 1] > maxParams[i - 1])
+        {
+            shell_error(sh, "pixel threshold must be 0 to 255, changed permille 0 to 1000, refresh frames >= 0\n");
+            return -EINVAL;
+        }
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    infer_ctrl_motion = true;
+    infer_ctrl_motion_pixel = (int)params[0];
+    infer_ctrl_motion_permille = (int)params[1];
+    infer_ctrl_motion_refresh = (int)params[2];
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    return 0;
+}
+
+static int od_interval_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    char *end;
+    long interval = strtol(argv[1], &end, 10);
+
+    if (*end != '\0' || interval < 1 || interval > 30)
+    {
+        shell_error(sh, "interval must be 1 to 30\n");
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    infer_ctrl_interval = (int)interval;
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    return 0;
+}
+
+static int od_tiles_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+
+    bool bAdaptive;
+
+    if (strcmp(argv[1], "adaptive") == 0)
+    {
+        bAdaptive = true;
+    }
+    else if (strcmp(argv[1], "grid") == 0)
+    {
+        bAdaptive = false;
+    }
+    else
+    {
+        shell_error(sh, "tiles must be grid or adaptive\n");
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+    infer_ctrl_adaptive_tiles = bAdaptive;
+    k_mutex_unlock(&mutex_infer_ctrl);
+
+    return 0;
+}
+
+static int od_model_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    if (argc == 1)
+    {
+        k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+        int model = infer_ctrl_model;
+        k_mutex_unlock(&mutex_infer_ctrl);
+
+        shell_print(sh, "model %s\n", model_names[model]);
+
+        return 0;
+    }
+
+    for (int i = 0; i < (int)ARRAY_SIZE(model_names); i++)
+    {
+        if (strcmp(argv[1], model_names[i]) == 0)
+        {
+            k_mutex_lock(&mutex_infer_ctrl, K_FOREVER);
+            infer_ctrl_model = i;
+            k_mutex_unlock(&mutex_infer_ctrl);
+
+            return 0;
+        }
+    }
+
+    shell_error(sh, "model must be size or speed\n");
+    return -EINVAL;
+}
+
+static int od_stats_cmd_handler(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    shell_print(sh, "frames captured %u, dropped %u, reused results %u, predicted %u\n",
+                s_u32FramesCaptured, s_u32FramesDropped, s_u32FramesReused, s_u32FramesPredicted);
+
+#if NPU_SCHEDULER
+    for (int i = 0; i < s_npuScheduler.NumClients(); i++)
+    {
+        NpuScheduler::ClientStats stats;
+        const char *name = s_npuScheduler.GetStats(i, &stats);
+
+        shell_print(sh, "npu %s: run %u, failed %u, expired %u, queued avg %llu us, max %llu us\n",
+                    name, stats.u32Run, stats.u32Failed, stats.u32Expired,
+                    (stats.u32Run > 0) ? (stats.u64QueueUsTotal / stats.u32Run) : 0ULL,
+                    stats.u64QueueUsMax);
+    }
+#endif
+
+    return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(od_subcmd_set,
 	SHELL_CMD_ARG(exit, NULL, "Exit object detection app", od_exit_cmd_handler, 1, 0),
 	SHELL_CMD_ARG(next, NULL, "Resume object detection recording one-shot", od_next_cmd_handler, 1, 0),
 	SHELL_CMD_ARG(resume, NULL, "Resume object detection recording continuously", od_resume_cmd_handler, 1, 0),
 	SHELL_CMD_ARG(suspend, NULL, "Suspend object detection recording", od_suspend_cmd_handler, 1, 0),
+	SHELL_CMD_ARG(topn, NULL, "Set number of detection candidates kept per frame, 0 for all", od_topn_cmd_handler, 2, 0),
+	SHELL_CMD_ARG(mode, NULL, "Set scheduling: latency drops frames waiting for inference for newer ones, throughput keeps all", od_mode_cmd_handler, 2, 0),
+	SHELL_CMD_ARG(motion, NULL, "Set motion gating: off, on, or <pixel threshold> [<changed permille> [<refresh frames>]]", od_motion_cmd_handler, 2, 2),
+	SHELL_CMD_ARG(interval, NULL, "Set inference to every Nth frame, the tracker predicts the others", od_interval_cmd_handler, 2, 0),
+	SHELL_COND_CMD_ARG(CONFIG_NVT_ML_OD_TILED_INFERENCE, tiles, NULL, "Set tiling: grid infers all tiles, adaptive only those around the last detections", od_tiles_cmd_handler, 2, 0),
+	SHELL_COND_CMD_ARG(CONFIG_NVT_ML_OD_MODEL_SWITCHING, model, NULL, "Show or switch the model: size or speed optimized, switched before the next frame", od_model_cmd_handler, 1, 1),
+	SHELL_CMD_ARG(stats, NULL, "Show frames captured, dropped, reusing results and predicted, and NPU queueing", od_stats_cmd_handler, 1, 0),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -203,6 +550,20 @@ SHELL_CMD_REGISTER(od, &od_subcmd_set, "object detection", NULL);
 
 extern uint8_t *GetModelPointer();
 extern size_t GetModelLen();
+
+#if MODEL_SWITCHING
+namespace opt_size
+{
+extern const uint8_t *GetModelPointer();
+extern size_t GetModelLen();
+} /* namespace opt_size */
+
+namespace opt_speed
+{
+extern const uint8_t *GetModelPointer();
+extern size_t GetModelLen();
+} /* namespace opt_speed */
+#endif
 } /* namespace yolofastest */
 } /* namespace app */
 } /* namespace arm */
@@ -231,47 +592,30 @@ static void HyperRAM_InitCRT(void)
 #endif
 #endif
 
-//frame buffer managemnet function
-static S_FRAMEBUF *get_empty_framebuf()
+//parse comma-separated class indices, e.g. "0,2,5"
+static std::vector<int> parse_class_mask(const char *pcMask)
 {
-    int i;
-
-    for (i = 0; i < NUM_FRAMEBUF; i ++)
-    {
-        if (s_asFramebuf[i].eState == eFRAMEBUF_EMPTY)
-            return &s_asFramebuf[i];
-    }
-
-    return NULL;
-}
-
-static S_FRAMEBUF *get_full_framebuf()
-{
-    int i;
+    std::vector<int> classMask;
+    char *pcEnd;
 
-    for (i = 0; i < NUM_FRAMEBUF; i ++)
+    while (*pcMask)
     {
-        if (s_asFramebuf[i].eState == eFRAMEBUF_FULL)
-            return &s_asFramebuf[i];
-    }
-
-    return NULL;
-}
+        long cls = strtol(pcMask, &pcEnd, 10);
 
-static S_FRAMEBUF *get_inf_framebuf()
-{
-    int i;
+        if (pcEnd == pcMask)
+        {
+            //skip separator
+            pcMask ++;
+            continue;
+        }
 
-    for (i = 0; i < NUM_FRAMEBUF; i ++)
-    {
-        if (s_asFramebuf[i].eState == eFRAMEBUF_INF)
-            return &s_asFramebuf[i];
+        classMask.push_back((int)cls);
+        pcMask = pcEnd;
     }
 
-    return NULL;
+    return classMask;
 }
 
-
 /* Image processing initiate function */
 //Used by omv library
 #if defined(__USE_UVC__)
@@ -292,21 +636,49 @@ static S_FRAMEBUF *get_inf_framebuf()
 #undef OMV_FB_ALLOC_SIZE
 #define OMV_FB_ALLOC_SIZE (1024)
 
+#if TILED_INFERENCE
+//YUV420P of the VGA sensor frame, tiled into model inputs
+#define MODEL_STAGE_SIZE (TiledFrameSource::ms_stageWidth * TiledFrameSource::ms_stageHeight * 3 / 2)
+#else
+//YUV420P of the model input, up to 320x320
+#define MODEL_STAGE_SIZE (320 * 320 * 3 / 2)
+#endif
+
 /* On zephyr, allocate at '.nocache.*' sections for non-cache-able */
 #if defined(__ZEPHYR__)
 __attribute__((section(".nocache.bss.vram.data"), aligned(32))) static char fb_array[OMV_FB_SIZE + OMV_FB_ALLOC_SIZE];
 __attribute__((section(".nocache.bss.sram.data"), aligned(32))) static char jpeg_array[OMV_JPEG_BUF_SIZE];
 
-#if (NUM_FRAMEBUF == 2)
-    __attribute__((section(".nocache.bss.vram.data"), aligned(32))) static char frame_buf1[OMV_FB_SIZE];
+#if (NUM_FRAMEBUF > 1)
+    __attribute__((section(".nocache.bss.vram.data"), aligned(32))) static char frame_bufs[NUM_FRAMEBUF - 1][OMV_FB_SIZE];
+#endif
+
+/* CCAP planar pipe output, one per frame buffer. At VGA, too large for SRAM */
+#if TILED_INFERENCE
+__attribute__((section(".hyperram.bss"), aligned(32))) static uint8_t model_stage[NUM_FRAMEBUF][MODEL_STAGE_SIZE];
+#elif CCAP_DUAL_PIPE
+__attribute__((section(".nocache.bss.vram.data"), aligned(32))) static uint8_t model_stage[NUM_FRAMEBUF][MODEL_STAGE_SIZE];
 #endif
 #else
 __attribute__((section(".bss.vram.data"), aligned(32))) static char fb_array[OMV_FB_SIZE + OMV_FB_ALLOC_SIZE];
 __attribute__((section(".bss.sram.data"), aligned(32))) static char jpeg_array[OMV_JPEG_BUF_SIZE];
 
-#if (NUM_FRAMEBUF == 2)
-    __attribute__((section(".bss.vram.data"), aligned(32))) static char frame_buf1[OMV_FB_SIZE];
+#if (NUM_FRAMEBUF > 1)
+    __attribute__((section(".bss.vram.data"), aligned(32))) static char frame_bufs[NUM_FRAMEBUF - 1][OMV_FB_SIZE];
+#endif
 #endif
+
+#if POSTPROCESS_THREAD
+//Output tensors of the model, up to YOLO-Fastest at 320x320
+#define MODEL_OUTPUT0_SIZE (10 * 10 * 255)
+#define MODEL_OUTPUT1_SIZE (20 * 20 * 255)
+
+/* Output copies, one post-processed while the next inference is copied to the other */
+#define NUM_OUTPUT_COPY 2
+
+__attribute__((aligned(32))) static int8_t output_copy0[NUM_OUTPUT_COPY][MODEL_OUTPUT0_SIZE];
+__attribute__((aligned(32))) static int8_t output_copy1[NUM_OUTPUT_COPY][MODEL_OUTPUT1_SIZE];
+static xOutputCopy s_asOutputCopy[NUM_OUTPUT_COPY];
 #endif
 
 char *_fb_base = NULL;
@@ -336,17 +708,26 @@ static void omv_init()
 
     for (i = 0 ; i < NUM_FRAMEBUF; i++)
     {
-        s_asFramebuf[i].eState = eFRAMEBUF_EMPTY;
+#if CCAP_DUAL_PIPE || TILED_INFERENCE
+        s_asFramebuf[i].modelStage = model_stage[i];
+#else
+        s_asFramebuf[i].modelStage = nullptr;
+#endif
+        /* Reserve up front so that post-processing doesn't allocate per frame */
+        s_asFramebuf[i].results.reserve(MAX_DETECTION_RESULTS);
     }
 
     framebuffer_init_image(&s_asFramebuf[0].frameImage);
 
-#if (NUM_FRAMEBUF == 2)
-    s_asFramebuf[1].frameImage.w = GLCD_WIDTH;
-    s_asFramebuf[1].frameImage.h = GLCD_HEIGHT;
-    s_asFramebuf[1].frameImage.size = GLCD_WIDTH * GLCD_HEIGHT * 2;
-    s_asFramebuf[1].frameImage.pixfmt = PIXFORMAT_RGB565;
-    s_asFramebuf[1].frameImage.data = (uint8_t *)frame_buf1;
+#if (NUM_FRAMEBUF > 1)
+    for (i = 1 ; i < NUM_FRAMEBUF; i++)
+    {
+        s_asFramebuf[i].frameImage.w = GLCD_WIDTH;
+        s_asFramebuf[i].frameImage.h = GLCD_HEIGHT;
+        s_asFramebuf[i].frameImage.size = GLCD_WIDTH * GLCD_HEIGHT * 2;
+        s_asFramebuf[i].frameImage.pixfmt = PIXFORMAT_RGB565;
+        s_asFramebuf[i].frameImage.data = (uint8_t *)frame_bufs[i - 1];
+    }
 #endif
 }
 
@@ -358,10 +739,11 @@ static bool PresentInferenceResult(const std::vector<arm::app::object_detection:
 
     for (uint32_t i = 0; i < results.size(); ++i)
     {
-        info("%" PRIu32 ") %s(%f) -> %s {x=%d,y=%d,w=%d,h=%d}\n", i,
+        info("%" PRIu32 ") %s(%f) -> %s {x=%d,y=%d,w=%d,h=%d} track %d\n", i,
              labels[results[i].m_cls].c_str(),
              results[i].m_normalisedVal, "Detection box:",
-             results[i].m_x0, results[i].m_y0, results[i].m_w, results[i].m_h);
+             results[i].m_x0, results[i].m_y0, results[i].m_w, results[i].m_h,
+             results[i].m_trackId);
     }
 
     return true;
@@ -373,56 +755,319 @@ static void DrawImageDetectionBoxes(
     image_t *drawImg,
     std::vector<std::string> &labels)
 {
+    char szLabel[64];
+
     for (const auto &result : results)
     {
+        const char *pcLabel = labels[result.m_cls].c_str();
+
+        //tracked boxes show their track ID
+        if (result.m_trackId >= 0)
+        {
+            snprintf(szLabel, sizeof(szLabel), "%s #%d", pcLabel, result.m_trackId);
+            pcLabel = szLabel;
+        }
+
         imlib_draw_rectangle(drawImg, result.m_x0, result.m_y0, result.m_w, result.m_h, COLOR_B5_MAX, 1, false);
-        imlib_draw_string(drawImg, result.m_x0, result.m_y0 - 16, labels[result.m_cls].c_str(), COLOR_B5_MAX, 2, 0, 0, false,
+        imlib_draw_string(drawImg, result.m_x0, result.m_y0 - 16, pcLabel, COLOR_B5_MAX, 2, 0, 0, false,
                           false, false, false, 0, false, false);
     }
 }
 
-static void main_task(void *pvParameters)
+#if defined (__USE_DISPLAY__) && !defined (__USE_UVC__)
+/* Display_FillRectAsync completion */
+static void framebuf_displayed(void *pvUserData)
 {
-#if !defined(__ZEPHYR__)
-    BaseType_t ret;
+    s_frameSlots.PutFree(static_cast<S_FRAMEBUF *>(pvUserData));
+}
 #endif
 
-    info("main task running \n");
-    /* Model object creation and initialisation. */
-    arm::app::YoloFastestModel model;
+struct RenderTaskParams
+{
+    std::vector<std::string> *labels;
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    k_fifo *queueHandle;
+#else
+    QueueHandle_t queueHandle;
+#endif
+};
 
-    if (!model.Init(arm::app::tensorArena,
-                    sizeof(arm::app::tensorArena),
-                    arm::app::yolofastest::GetModelPointer(),
-                    arm::app::yolofastest::GetModelLen()))
-    {
-        printf_err("Failed to initialise model\n");
-        /* On zephyr, context is main thread */
-#if !defined(__ZEPHYR__)
-        vTaskDelete(nullptr);
+/* Render stage: draw, display and report each inferred frame, then hand its slot back to capture */
+/* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+static void render_task(void *pvParameters, void *p2, void *p3)
+#else
+static void render_task(void *pvParameters)
 #endif
-        return;
-    }
+{
+    struct RenderTaskParams params = *reinterpret_cast<struct RenderTaskParams *>(pvParameters);
+    std::vector<std::string> &labels = *params.labels;
 
-    /*
-     * On zephyr, configure mpu region for tensor arena in zephyr way
-     * rather than direct control
-     *
-     * With CONFIG_CONFIG_NOCACHE_MEMORY=y, frame buffer is allocated
-     * at non-cache-able memory.
-     */
-#if !defined(__ZEPHYR__)
-    /* Setup cache poicy of tensor arean buffer */
-    info("Set tesnor arena cache policy to WTRA \n");
-    const std::vector<ARM_MPU_Region_t> mpuConfig =
+#if defined(__PROFILE__)
+    uint64_t u64StartCycle;
+    uint64_t u64EndCycle;
+#endif
+
+#if defined (__USE_DISPLAY__)
+    char szDisplayText[160];
+    S_DISP_RECT sDispRect;
+#endif
+
+#define EACH_PERF_SEC 5
+    uint64_t u64PerfCycle = 0;
+    uint64_t u64PerfFrames = 0;
+
+    u64PerfCycle = (uint64_t)pmu_get_systick_Count() + (uint64_t)(SystemCoreClock * EACH_PERF_SEC);
+    info("init perfcycles %llu \n", u64PerfCycle);
+
+    for (;;)
     {
-        {
-            // SRAM for tensor arena
-            ARM_MPU_RBAR(((unsigned int)arm::app::tensorArena),        // Base
-                         ARM_MPU_SH_NON,    // Non-shareable
-                         0,                 // Read-only
-                         1,                 // Non-Privileged
-                         1),                // eXecute Never enabled
+        struct xInferenceJob *inferenceJob;
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        inferenceJob = static_cast<xInferenceJob *>(k_fifo_get(params.queueHandle, Z_FOREVER));
+#else
+        xQueueReceive(params.queueHandle, &inferenceJob, portMAX_DELAY);
+#endif
+
+        S_FRAMEBUF *infFramebuf = static_cast<S_FRAMEBUF *>(inferenceJob->pvOwner);
+
+        //draw bbox and render
+        /* Draw boxes. */
+        DrawImageDetectionBoxes(infFramebuf->results, &infFramebuf->frameImage, labels);
+
+        PresentInferenceResult(infFramebuf->results, labels);
+
+        u64PerfFrames ++;
+
+        if ((uint64_t) pmu_get_systick_Count() > u64PerfCycle)
+        {
+            info("Total inference rate: %llu\n", u64PerfFrames / EACH_PERF_SEC);
+            info("Frames captured %" PRIu32 ", dropped %" PRIu32 ", reused results %" PRIu32 ", predicted %" PRIu32 "\n",
+                 s_u32FramesCaptured, s_u32FramesDropped, s_u32FramesReused, s_u32FramesPredicted);
+#if defined (__USE_DISPLAY__)
+            sprintf(szDisplayText, "Frame Rate %llu", u64PerfFrames / EACH_PERF_SEC);
+            //              sprintf(szDisplayText,"Time %llu",(uint64_t) pmu_get_systick_Count() / (uint64_t)SystemCoreClock);
+
+            sDispRect.u32TopLeftX = 0;
+            sDispRect.u32TopLeftY = (infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR);
+            sDispRect.u32BottonRightX = (infFramebuf->frameImage.w * IMAGE_DISP_UPSCALE_FACTOR);
+            sDispRect.u32BottonRightY = ((infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR) + (FONT_DISP_UPSCALE_FACTOR * FONT_HTIGHT) - 1);
+            Display_ClearRect(C_WHITE, &sDispRect);
+            Display_PutText(
+                szDisplayText,
+                strlen(szDisplayText),
+                0,
+                infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR,
+                C_BLUE,
+                C_WHITE,
+                false,
+                FONT_DISP_UPSCALE_FACTOR
+            );
+#endif
+            u64PerfCycle = (uint64_t)pmu_get_systick_Count() + (uint64_t)(SystemCoreClock * EACH_PERF_SEC);
+            u64PerfFrames = 0;
+        }
+
+#if defined (__USE_DISPLAY__) && !defined (__USE_UVC__)
+        //display result image
+        //Display image on LCD, the slot goes back to capture once PDMA has sent it
+        sDispRect.u32TopLeftX = 0;
+        sDispRect.u32TopLeftY = 0;
+        sDispRect.u32BottonRightX = ((infFramebuf->frameImage.w * IMAGE_DISP_UPSCALE_FACTOR) - 1);
+        sDispRect.u32BottonRightY = ((infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR) - 1);
+
+#if defined(__PROFILE__)
+        u64StartCycle = pmu_get_systick_Count();
+#endif
+
+        Display_FillRectAsync((uint16_t *)infFramebuf->frameImage.data, &sDispRect, IMAGE_DISP_UPSCALE_FACTOR,
+                              framebuf_displayed, infFramebuf);
+
+#if defined(__PROFILE__)
+        u64EndCycle = pmu_get_systick_Count();
+        info("display submit cycles %llu \n", (u64EndCycle - u64StartCycle));
+#endif
+#else
+        /* UVC converts the frame in place, so it waits for the display */
+#if defined (__USE_DISPLAY__)
+        //Display image on LCD
+        sDispRect.u32TopLeftX = 0;
+        sDispRect.u32TopLeftY = 0;
+        sDispRect.u32BottonRightX = ((infFramebuf->frameImage.w * IMAGE_DISP_UPSCALE_FACTOR) - 1);
+        sDispRect.u32BottonRightY = ((infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR) - 1);
+
+#if defined(__PROFILE__)
+        u64StartCycle = pmu_get_systick_Count();
+#endif
+
+        Display_FillRect((uint16_t *)infFramebuf->frameImage.data, &sDispRect, IMAGE_DISP_UPSCALE_FACTOR);
+
+#if defined(__PROFILE__)
+        u64EndCycle = pmu_get_systick_Count();
+        info("display image cycles %llu \n", (u64EndCycle - u64StartCycle));
+#endif
+
+#endif
+
+#if defined (__USE_UVC__)
+
+        if (UVC_IsConnect())
+        {
+#if (UVC_Color_Format == UVC_Format_YUY2)
+            rectangle_t roi;
+
+            image_t RGB565Img;
+            image_t YUV422Img;
+
+            RGB565Img.w = infFramebuf->frameImage.w;
+            RGB565Img.h = infFramebuf->frameImage.h;
+            RGB565Img.data = (uint8_t *)infFramebuf->frameImage.data;
+            RGB565Img.pixfmt = PIXFORMAT_RGB565;
+
+            YUV422Img.w = RGB565Img.w;
+            YUV422Img.h = RGB565Img.h;
+            YUV422Img.data = (uint8_t *)infFramebuf->frameImage.data;
+            YUV422Img.pixfmt = PIXFORMAT_YUV422;
+
+            roi.x = 0;
+            roi.y = 0;
+            roi.w = RGB565Img.w;
+            roi.h = RGB565Img.h;
+            imlib_nvt_scale(&RGB565Img, &YUV422Img, &roi);
+
+#else
+            image_t origImg;
+            image_t vflipImg;
+
+            origImg.w = infFramebuf->frameImage.w;
+            origImg.h = infFramebuf->frameImage.h;
+            origImg.data = (uint8_t *)infFramebuf->frameImage.data;
+            origImg.pixfmt = PIXFORMAT_RGB565;
+
+            vflipImg.w = origImg.w;
+            vflipImg.h = origImg.h;
+            vflipImg.data = (uint8_t *)infFramebuf->frameImage.data;
+            vflipImg.pixfmt = PIXFORMAT_RGB565;
+
+            imlib_nvt_vflip(&origImg, &vflipImg);
+#endif
+            UVC_SendImage((uint32_t)infFramebuf->frameImage.data, IMAGE_FB_SIZE, uvcStatus.StillImage);
+
+        }
+
+#endif
+
+        s_frameSlots.PutFree(infFramebuf);
+#endif
+    }
+}
+
+#if MODEL_SWITCHING
+/* Getters of the linked models, in model_names order */
+static const struct
+{
+    const uint8_t *(*getModelPointer)();
+    size_t (*getModelLen)();
+} s_asModels[] =
+{
+    {arm::app::yolofastest::opt_size::GetModelPointer, arm::app::yolofastest::opt_size::GetModelLen},
+    {arm::app::yolofastest::opt_speed::GetModelPointer, arm::app::yolofastest::opt_speed::GetModelLen},
+};
+
+/*
+ * Switch to another linked model, in the tensor arena of the current one.
+ * The slots must all be drained, so that no stage uses the model. The model
+ * input must keep its size and type, and with them the input scale plan;
+ * the input quantization, the output tensors and their decode tables are
+ * bound anew.
+ */
+static bool switch_model(arm::app::YoloFastestModel &model, int modelIdx,
+                         int inputImgCols, int inputImgRows, bool bSigned,
+                         rgb565_int8_lut_t *inputQuantLut,
+                         arm::app::object_detection::DetectorPostprocessing &postProcess)
+{
+    if (!model.SwitchModel(s_asModels[modelIdx].getModelPointer(), s_asModels[modelIdx].getModelLen()))
+    {
+        return false;
+    }
+
+    TfLiteTensor *inputTensor = model.GetInputTensor(0);
+    TfLiteIntArray *inputShape = model.GetInputShape(0);
+
+    if ((inputShape->size < 3) ||
+        (inputShape->data[arm::app::YoloFastestModel::ms_inputColsIdx] != inputImgCols) ||
+        (inputShape->data[arm::app::YoloFastestModel::ms_inputRowsIdx] != inputImgRows) ||
+        (model.IsDataSigned() != bSigned))
+    {
+        printf_err("Model input unlike the one of the boot model\n");
+        return false;
+    }
+
+#if POSTPROCESS_THREAD
+    if ((model.GetOutputTensor(0)->bytes > MODEL_OUTPUT0_SIZE) ||
+        (model.GetOutputTensor(1)->bytes > MODEL_OUTPUT1_SIZE))
+    {
+        printf_err("Model output larger than its copy\n");
+        return false;
+    }
+#endif
+
+    imlib_nvt_RGB565toInt8_lut(inputQuantLut, 1.0f / 255.0f,
+                               inputTensor->params.scale, inputTensor->params.zero_point);
+
+    /* New decode tables, and output tensors, even if at the same addresses */
+    postProcess.SetDecodeTables(model.GetDecodeTable(0), model.GetDecodeTable(1));
+    postProcess.InitNetwork(inputImgRows, inputImgCols, model.GetOutputTensor(0), model.GetOutputTensor(1));
+
+    return true;
+}
+#endif
+
+static void main_task(void *pvParameters)
+{
+#if !defined(__ZEPHYR__)
+    BaseType_t ret;
+#endif
+
+    info("main task running \n");
+    /* Model object creation and initialisation. */
+    arm::app::YoloFastestModel model;
+
+    if (!model.Init(arm::app::tensorArena,
+                    sizeof(arm::app::tensorArena),
+                    arm::app::yolofastest::GetModelPointer(),
+                    arm::app::yolofastest::GetModelLen()))
+    {
+        printf_err("Failed to initialise model\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
+
+    /*
+     * On zephyr, configure mpu region for tensor arena in zephyr way
+     * rather than direct control
+     *
+     * With CONFIG_CONFIG_NOCACHE_MEMORY=y, frame buffer is allocated
+     * at non-cache-able memory.
+     */
+#if !defined(__ZEPHYR__)
+    /* Setup cache poicy of tensor arean buffer */
+    info("Set tesnor arena cache policy to WTRA \n");
+    const std::vector<ARM_MPU_Region_t> mpuConfig =
+    {
+        {
+            // SRAM for tensor arena
+            ARM_MPU_RBAR(((unsigned int)arm::app::tensorArena),        // Base
+                         ARM_MPU_SH_NON,    // Non-shareable
+                         0,                 // Read-only
+                         1,                 // Non-Privileged
+                         1),                // eXecute Never enabled
             ARM_MPU_RLAR((((unsigned int)arm::app::tensorArena) + ACTIVATION_BUF_SZ - 1),        // Limit
                          eMPU_ATTR_CACHEABLE_WTRA) // Attribute index - cacheable WTRA
         },
@@ -437,15 +1082,15 @@ static void main_task(void *pvParameters)
             ARM_MPU_RLAR((((unsigned int)fb_array) + OMV_FB_SIZE - 1),        // Limit
                          eMPU_ATTR_NON_CACHEABLE) // NonCache
         },
-#if (NUM_FRAMEBUF == 2)
+#if (NUM_FRAMEBUF > 1)
         {
             // Image data from CCAP DMA, so must set frame buffer to Non-cache attribute
-            ARM_MPU_RBAR(((unsigned int)frame_buf1),        // Base
+            ARM_MPU_RBAR(((unsigned int)frame_bufs),        // Base
                          ARM_MPU_SH_NON,    // Non-shareable
                          0,                 // Read-only
                          1,                 // Non-Privileged
                          1),                // eXecute Never enabled
-            ARM_MPU_RLAR((((unsigned int)frame_buf1) + OMV_FB_SIZE - 1),        // Limit
+            ARM_MPU_RLAR((((unsigned int)frame_bufs) + sizeof(frame_bufs) - 1),        // Limit
                          eMPU_ATTR_NON_CACHEABLE) // NonCache
         },
 #endif
@@ -458,21 +1103,92 @@ static void main_task(void *pvParameters)
 
     // Setup inference resource and create task
     struct ProcessTaskParams taskParam;
-    /* On zephyr, use k_queue */
+    /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-    static K_QUEUE_DEFINE(inferenceProcessQueue);
-    static K_QUEUE_DEFINE(inferenceResponseQueue);
+    static K_FIFO_DEFINE(inferenceProcessQueue);
+    static K_FIFO_DEFINE(inferenceResponseQueue);
+#if POSTPROCESS_THREAD
+    static K_FIFO_DEFINE(postProcessQueue);
+    static K_FIFO_DEFINE(freeOutputQueue);
+#endif
 #else
-    QueueHandle_t inferenceProcessQueue = xQueueCreate(1, sizeof(xInferenceJob *));
-    QueueHandle_t inferenceResponseQueue = xQueueCreate(1, sizeof(xInferenceJob *));
+    QueueHandle_t inferenceProcessQueue = xQueueCreate(NUM_FRAMEBUF, sizeof(xInferenceJob *));
+    QueueHandle_t inferenceResponseQueue = xQueueCreate(NUM_FRAMEBUF, sizeof(xInferenceJob *));
+#if POSTPROCESS_THREAD
+    QueueHandle_t postProcessQueue = xQueueCreate(NUM_FRAMEBUF, sizeof(xInferenceJob *));
+    QueueHandle_t freeOutputQueue = xQueueCreate(NUM_OUTPUT_COPY, sizeof(xOutputCopy *));
+#endif
 #endif
 
     taskParam.model = &model;
-    /* On zephyr, use k_queue */
+    /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
     taskParam.queueHandle = &inferenceProcessQueue;
+#if POSTPROCESS_THREAD
+    taskParam.postProcessQueue = &postProcessQueue;
+    taskParam.freeOutputQueue = &freeOutputQueue;
+#else
+    taskParam.postProcessQueue = nullptr;
+    taskParam.freeOutputQueue = nullptr;
+#endif
 #else
     taskParam.queueHandle = inferenceProcessQueue;
+#if POSTPROCESS_THREAD
+    taskParam.postProcessQueue = postProcessQueue;
+    taskParam.freeOutputQueue = freeOutputQueue;
+#else
+    taskParam.postProcessQueue = nullptr;
+    taskParam.freeOutputQueue = nullptr;
+#endif
+#endif
+
+#if NPU_SCHEDULER
+    taskParam.npuScheduler = &s_npuScheduler;
+    taskParam.npuClient = s_npuScheduler.AddClient(&model, "object detection");
+    taskParam.npuPriority = OD_NPU_PRIORITY;
+    taskParam.u32NpuDeadlineUs = OD_NPU_DEADLINE_MS * 1000;
+
+    /* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+    const size_t npuSchedulerThreadStackSize = CONFIG_NVT_ML_NPU_SCHEDULER_THREAD_STACK_SIZE;
+    static K_THREAD_STACK_DEFINE(npuSchedulerThreadStack,
+                                 npuSchedulerThreadStackSize);
+    static k_thread npuSchedulerThread;
+    static k_tid_t npuSchedulerThreadId;
+
+    npuSchedulerThreadId = k_thread_create(&npuSchedulerThread,
+                                           npuSchedulerThreadStack,
+                                           K_THREAD_STACK_SIZEOF(npuSchedulerThreadStack),
+                                           npuSchedulerTask,
+                                           &s_npuScheduler,
+                                           NULL,
+                                           NULL,
+                                           CONFIG_MAIN_THREAD_PRIORITY,
+                                           0,
+                                           K_FOREVER);
+    if (npuSchedulerThreadId == NULL) {
+        printf_err("Failed to create NPU scheduler task\n");
+        return;
+    }
+
+    k_thread_name_set(npuSchedulerThreadId, "npu scheduler task");
+
+    k_thread_start(npuSchedulerThreadId);
+#else
+    ret = xTaskCreate(npuSchedulerTask, "npu scheduler task", 2 * 1024, &s_npuScheduler, NPU_SCHEDULER_TASK_PRIO, nullptr);
+
+    if (ret != pdPASS)
+    {
+        printf_err("FreeRTOS: Failed to create NPU scheduler task \n");
+        vTaskDelete(nullptr);
+        return;
+    }
+#endif
+#else
+    taskParam.npuScheduler = nullptr;
+    taskParam.npuClient = -1;
+    taskParam.npuPriority = 0;
+    taskParam.u32NpuDeadlineUs = 0;
 #endif
 
     /* On zephyr, use k_thread */
@@ -513,7 +1229,6 @@ static void main_task(void *pvParameters)
 #endif
 
 #if !defined (__USE_CCAP__)
-    uint8_t u8ImgIdx = 0;
     char chStdIn;
 #endif
 
@@ -544,8 +1259,103 @@ static void main_task(void *pvParameters)
     const int inputImgCols = inputShape->data[arm::app::YoloFastestModel::ms_inputColsIdx];
     const int inputImgRows = inputShape->data[arm::app::YoloFastestModel::ms_inputRowsIdx];
 
+    /* int8 value of each RGB565 channel code under the input tensor's quantization.
+     * YOLO-Fastest takes RGB normalised to [0, 1] */
+    rgb565_int8_lut_t inputQuantLut;
+    imlib_nvt_RGB565toInt8_lut(&inputQuantLut, 1.0f / 255.0f,
+                               inputTensor->params.scale, inputTensor->params.zero_point);
+
     // postProcess
-    arm::app::object_detection::DetectorPostprocessing postProcess(0.5, 0.45, numClasses, 0);
+    arm::app::object_detection::DetectorPostprocessing postProcess(0.5, 0.45, numClasses, TOP_N,
+                                                                   DECODE_MODE,
+                                                                   MAX_DETECTION_RESULTS,
+                                                                   NMS_MODE,
+                                                                   CLASS_MODE,
+                                                                   parse_class_mask(CLASS_MASK),
+                                                                   DETECTION_POOL_GROW);
+
+    /* Decode through the lookup tables the model built at Init */
+    postProcess.SetDecodeTables(model.GetDecodeTable(0), model.GetDecodeTable(1));
+
+    /* Prepare the output branches here, leaving the inference thread nothing but per-frame work */
+    postProcess.InitNetwork(inputImgRows, inputImgCols, model.GetOutputTensor(0), model.GetOutputTensor(1));
+
+#if POSTPROCESS_THREAD
+    if ((model.GetOutputTensor(0)->bytes > MODEL_OUTPUT0_SIZE) ||
+        (model.GetOutputTensor(1)->bytes > MODEL_OUTPUT1_SIZE))
+    {
+        printf_err("Model output larger than its copy\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
+
+    for (int i = 0; i < NUM_OUTPUT_COPY; i++)
+    {
+        s_asOutputCopy[i].output0 = output_copy0[i];
+        s_asOutputCopy[i].output1 = output_copy1[i];
+
+        xOutputCopy *psOutputCopy = &s_asOutputCopy[i];
+
+        /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+        k_fifo_put(&freeOutputQueue, psOutputCopy);
+#else
+        xQueueSend(freeOutputQueue, &psOutputCopy, portMAX_DELAY);
+#endif
+    }
+
+    // Setup post-processing task, it alone uses postProcess from here on, but for model switches with all slots drained
+    struct PostProcessTaskParams postProcessParam;
+
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    postProcessParam.queueHandle = &postProcessQueue;
+    postProcessParam.freeOutputQueue = &freeOutputQueue;
+#else
+    postProcessParam.queueHandle = postProcessQueue;
+    postProcessParam.freeOutputQueue = freeOutputQueue;
+#endif
+
+    /* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+    const size_t postProcessThreadStackSize = CONFIG_NVT_ML_OD_POSTPROCESS_THREAD_STACK_SIZE;
+    static K_THREAD_STACK_DEFINE(postProcessThreadStack,
+                                 postProcessThreadStackSize);
+    static k_thread postProcessThread;
+    static k_tid_t postProcessThreadId;
+
+    postProcessThreadId = k_thread_create(&postProcessThread,
+                                          postProcessThreadStack,
+                                          K_THREAD_STACK_SIZEOF(postProcessThreadStack),
+                                          postProcessTask,
+                                          &postProcessParam,
+                                          NULL,
+                                          NULL,
+                                          CONFIG_MAIN_THREAD_PRIORITY,
+                                          0,
+                                          K_FOREVER);
+    if (postProcessThreadId == NULL) {
+        printf_err("Failed to create post-processing task\n");
+        return;
+    }
+
+    k_thread_name_set(postProcessThreadId, "post-processing task");
+
+    k_thread_start(postProcessThreadId);
+#else
+    ret = xTaskCreate(postProcessTask, "post-processing task", 2 * 1024, &postProcessParam, POSTPROCESS_TASK_PRIO, nullptr);
+
+    if (ret != pdPASS)
+    {
+        printf_err("FreeRTOS: Failed to post-processing task \n");
+        vTaskDelete(nullptr);
+        return;
+    }
+#endif
+#endif
 
     //label information
     std::vector<std::string> labels;
@@ -559,357 +1369,429 @@ static void main_task(void *pvParameters)
     omv_init();
     framebuffer_init_image(&frameBuffer);
 
-#if defined(__PROFILE__)
-    arm::app::Profiler profiler;
-    uint64_t u64StartCycle;
-    uint64_t u64EndCycle;
-    uint64_t u64CCAPStartCycle;
-    uint64_t u64CCAPEndCycle;
-#else
-    pmu_reset_counters();
-#endif
+    /* All frames share one size, as do the source images */
+    image_t inputImg;
 
-#define EACH_PERF_SEC 5
-    uint64_t u64PerfCycle = 0;
-    uint64_t u64PerfFrames = 0;
+    inputImg.w = inputImgCols;
+    inputImg.h = inputImgRows;
+    inputImg.data = (uint8_t *)inputTensor->data.data;
+    inputImg.pixfmt = PIXFORMAT_RGB888;
 
-    u64PerfCycle = (uint64_t)pmu_get_systick_Count() + (uint64_t)(SystemCoreClock * EACH_PERF_SEC);
-    info("init perfcycles %llu \n", u64PerfCycle);
+    roi.x = 0;
+    roi.y = 0;
+    roi.w = s_asFramebuf[0].frameImage.w;
+    roi.h = s_asFramebuf[0].frameImage.h;
 
-    S_FRAMEBUF *infFramebuf;
-    S_FRAMEBUF *fullFramebuf;
-    S_FRAMEBUF *emptyFramebuf;
+    /* If the data is signed, resize, convert and quantize in one pass. */
+#if INPUT_LETTERBOX
+    if (imlib_nvt_scale_plan_init_letterbox(&s_sInputScalePlan, &s_asFramebuf[0].frameImage, &inputImg, &roi,
+                                            INPUT_SCALE_MODE, model.IsDataSigned() ? &inputQuantLut : nullptr) != 0)
+#else
+    if (imlib_nvt_scale_plan_init(&s_sInputScalePlan, &s_asFramebuf[0].frameImage, &inputImg, &roi, INPUT_SCALE_MODE,
+                                  model.IsDataSigned() ? &inputQuantLut : nullptr) != 0)
+#endif
+    {
+        printf_err("Unsupported model input resize\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
 
-    struct xInferenceJob *inferenceJob = new (struct xInferenceJob);
+#if INPUT_LETTERBOX
+    /* Boxes come back in the letterboxed input, map them to the frame. */
+    postProcess.SetLetterbox(s_sInputScalePlan.dst_rect.x, s_sInputScalePlan.dst_rect.y,
+                             s_sInputScalePlan.dst_rect.w, s_sInputScalePlan.dst_rect.h);
+#endif
 
+    /* Frames from the camera, or from the baked-in images without one */
 #if defined (__USE_CCAP__)
-    //Setup image senosr
-    ImageSensor_Init();
-    ImageSensor_Config(eIMAGE_FMT_RGB565, frameBuffer.w, frameBuffer.h, true);
+#if TILED_INFERENCE
+    static TiledFrameSource frameSource(&s_sInputScalePlan, model.IsDataSigned() ? &inputQuantLut : nullptr);
+#elif CCAP_DUAL_PIPE
+    static DualPipeFrameSource frameSource(model.IsDataSigned() ? &inputQuantLut : nullptr);
+#else
+    static CameraFrameSource frameSource(&s_sInputScalePlan);
 #endif
-
-#if defined (__USE_DISPLAY__)
-    char szDisplayText[160];
-    S_DISP_RECT sDispRect;
-
-    Display_Init();
-    Display_ClearLCD(C_WHITE);
+#else
+    static ImageFrameSource frameSource(&s_sInputScalePlan);
 #endif
 
-#if defined (__USE_UVC__)
-    UVC_Init();
-    HSUSBD_Start();
+#if defined(__PROFILE__)
+    arm::app::Profiler profiler;
+    uint64_t u64CCAPStartCycle;
+    uint64_t u64CCAPEndCycle;
+#else
+    pmu_reset_counters();
 #endif
 
-    while (1)
+    //Setup frame source, image sensor if any
+    if ((frameSource.Init(&s_asFramebuf[0].frameImage, &inputImg) != 0) ||
+        (frameSource.ModelStageSize() > MODEL_STAGE_SIZE))
     {
+        printf_err("Failed to set up frame source\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
 
-        infFramebuf = get_inf_framebuf();
-
-        if (infFramebuf)
-        {
-            /* Detector post-processing*/
+#if TILED_INFERENCE
+    /* Tiles of the VGA stage to infer, and the merge of their detections */
+    static TilePlanner tilePlanner;
 
-            /* On zephyr, use k_queue */
-#if defined(__ZEPHYR__)
-            inferenceJob->responseQueue = &inferenceResponseQueue;
-#else
-            inferenceJob->responseQueue = inferenceResponseQueue;
+    if (tilePlanner.Init(TiledFrameSource::ms_stageWidth, TiledFrameSource::ms_stageHeight,
+                         inputImgCols, inputImgRows, TILE_MIN_OVERLAP,
+                         s_asFramebuf[0].frameImage.w, s_asFramebuf[0].frameImage.h,
+                         TILED_FULL_GRID_FRAMES, MAX_DETECTION_RESULTS) != 0)
+    {
+        printf_err("Failed to set up tiles\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
 #endif
-            inferenceJob->pPostProc = &postProcess;
-            inferenceJob->modelCols = inputImgCols;
-            inferenceJob->mode1Rows = inputImgRows;
-            inferenceJob->srcImgWidth = infFramebuf->frameImage.w;
-            inferenceJob->srcImgHeight = infFramebuf->frameImage.h;
-            inferenceJob->results = &infFramebuf->results; //&results;
-
-            /* On zephyr, use k_queue */
-#if defined(__ZEPHYR__)
-            xInferenceJob *inferenceJob = static_cast<xInferenceJob *>(k_queue_get(&inferenceResponseQueue, Z_FOREVER));
-#else
-            xQueueReceive(inferenceResponseQueue, &inferenceJob, portMAX_DELAY);
+        return;
+    }
 #endif
-        }
 
-        fullFramebuf = get_full_framebuf();
+    /* Scene change check of each captured frame, before its inference is queued */
+    static MotionGate motionGate;
 
-        if (fullFramebuf)
-        {
-            //resize full image to input tensor
-            image_t resizeImg;
+    if (motionGate.Init(&s_asFramebuf[0].frameImage) != 0)
+    {
+        printf_err("Failed to set up motion gate\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
 
-            roi.x = 0;
-            roi.y = 0;
-            roi.w = fullFramebuf->frameImage.w;
-            roi.h = fullFramebuf->frameImage.h;
+    /* The motion gate checks against the last frame it let through, while it was on */
+    bool bMotionGateOn = false;
 
-            resizeImg.w = inputImgCols;
-            resizeImg.h = inputImgRows;
-            resizeImg.data = (uint8_t *)inputTensor->data.data; //direct resize to input tensor buffer
-            resizeImg.pixfmt = PIXFORMAT_RGB888;
+    /* Predicted frames left before the next inference */
+    int framesToInference = 0;
 
-#if defined(__PROFILE__)
-            u64StartCycle = pmu_get_systick_Count();
+#if MODEL_SWITCHING
+    /* Model the pipeline runs, and the input type any model switched to keeps */
+    int curModelIdx = MODEL_BOOT;
+    const bool bSignedInput = model.IsDataSigned();
 #endif
-            imlib_nvt_scale(&fullFramebuf->frameImage, &resizeImg, &roi);
 
-#if defined(__PROFILE__)
-            u64EndCycle = pmu_get_systick_Count();
-            info("resize cycles %llu \n", (u64EndCycle - u64StartCycle));
-#endif
-
-#if defined(__PROFILE__)
-            u64StartCycle = pmu_get_systick_Count();
+#if TRACKER
+    /* Track IDs, and boxes that keep moving between sparse inferences */
+    static arm::app::object_detection::DetectionTracker tracker(MAX_TRACKS, MAX_DETECTION_RESULTS,
+                                                                s_asFramebuf[0].frameImage.w,
+                                                                s_asFramebuf[0].frameImage.h);
 #endif
 
-            /* If the data is signed. */
-            if (model.IsDataSigned())
-            {
-                arm::app::image::ConvertImgToInt8(inputTensor->data.data, inputTensor->bytes);
-            }
+    /* The inference job of each slot only changes in its topN and where its results come from */
+    for (int i = 0; i < NUM_FRAMEBUF; i++)
+    {
+        struct xInferenceJob *inferenceJob = &s_asFramebuf[i].job;
 
-#if defined(__PROFILE__)
-            u64EndCycle = pmu_get_systick_Count();
-            info("quantize cycles %llu \n", (u64EndCycle - u64StartCycle));
-#endif
-            //trigger inference
-            /* On zephyr, use k_queue */
+        /* On zephyr, use k_fifo */
 #if defined(__ZEPHYR__)
-            inferenceJob->responseQueue = &inferenceResponseQueue;
+        inferenceJob->responseQueue = &inferenceResponseQueue;
 #else
-            inferenceJob->responseQueue = inferenceResponseQueue;
+        inferenceJob->responseQueue = inferenceResponseQueue;
 #endif
-            inferenceJob->pPostProc = &postProcess;
-            inferenceJob->modelCols = inputImgCols;
-            inferenceJob->mode1Rows = inputImgRows;
-            inferenceJob->srcImgWidth = fullFramebuf->frameImage.w;
-            inferenceJob->srcImgHeight = fullFramebuf->frameImage.h;
-            inferenceJob->results = &fullFramebuf->results;
+        inferenceJob->pPostProc = &postProcess;
+        inferenceJob->modelCols = inputImgCols;
+        inferenceJob->mode1Rows = inputImgRows;
+        inferenceJob->srcImgWidth = s_asFramebuf[i].frameImage.w;
+        inferenceJob->srcImgHeight = s_asFramebuf[i].frameImage.h;
+        inferenceJob->topN = TOP_N;
+        inferenceJob->pFrameSource = &frameSource;
+        inferenceJob->frame = &s_asFramebuf[i].frameImage;
+        inferenceJob->modelStage = s_asFramebuf[i].modelStage;
+#if TILED_INFERENCE
+        inferenceJob->pTilePlanner = &tilePlanner;
+#else
+        inferenceJob->pTilePlanner = nullptr;
+#endif
+        inferenceJob->bAdaptiveTiles = TILED_ADAPTIVE;
+        inferenceJob->eResults = eJOB_RESULTS_INFER;
+#if TRACKER
+        inferenceJob->pTracker = &tracker;
+#else
+        inferenceJob->pTracker = nullptr;
+#endif
+        inferenceJob->u32FramesDropped = 0;
+        inferenceJob->results = &s_asFramebuf[i].results;
+        inferenceJob->pOutputCopy = nullptr;
+        inferenceJob->pvOwner = &s_asFramebuf[i];
+    }
 
-            /* On zephyr, use k_queue */
 #if defined(__ZEPHYR__)
-            k_queue_alloc_append(&inferenceProcessQueue, inferenceJob);
+    if (s_frameSlots.Init(s_asFramebuf, NUM_FRAMEBUF, &inferenceProcessQueue) != 0)
 #else
-            xQueueSend(inferenceProcessQueue, &inferenceJob, portMAX_DELAY);
+    if (s_frameSlots.Init(s_asFramebuf, NUM_FRAMEBUF, inferenceProcessQueue) != 0)
 #endif
-            fullFramebuf->eState = eFRAMEBUF_INF;
-        }
-
-        if (infFramebuf)
-        {
-            //draw bbox and render
-            /* Draw boxes. */
-            DrawImageDetectionBoxes(infFramebuf->results, &infFramebuf->frameImage, labels);
+    {
+        printf_err("Failed to create the frame slots\n");
+        /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+        vTaskDelete(nullptr);
+#endif
+        return;
+    }
 
-            //display result image
 #if defined (__USE_DISPLAY__)
-            //Display image on LCD
-            sDispRect.u32TopLeftX = 0;
-            sDispRect.u32TopLeftY = 0;
-            sDispRect.u32BottonRightX = ((infFramebuf->frameImage.w * IMAGE_DISP_UPSCALE_FACTOR) - 1);
-            sDispRect.u32BottonRightY = ((infFramebuf->frameImage.h * IMAGE_DISP_UPSCALE_FACTOR) - 1);
-
-#if defined(__PROFILE__)
-            u64StartCycle = pmu_get_systick_Count();
+    Display_Init();
+    Display_ClearLCD(C_WHITE);
 #endif
 
-            Display_FillRect((uint16_t *)infFramebuf->frameImage.data, &sDispRect, IMAGE_DISP_UPSCALE_FACTOR);
-
-#if defined(__PROFILE__)
-            u64EndCycle = pmu_get_systick_Count();
-            info("display image cycles %llu \n", (u64EndCycle - u64StartCycle));
+#if defined (__USE_UVC__)
+    UVC_Init();
+    HSUSBD_Start();
 #endif
 
-#endif
+    // Setup render resource and create task
+    struct RenderTaskParams renderParam;
 
-#if defined (__USE_UVC__)
+    renderParam.labels = &labels;
+    /* On zephyr, use k_fifo */
+#if defined(__ZEPHYR__)
+    renderParam.queueHandle = &inferenceResponseQueue;
+#else
+    renderParam.queueHandle = inferenceResponseQueue;
+#endif
 
-            if (UVC_IsConnect())
-            {
-#if (UVC_Color_Format == UVC_Format_YUY2)
-                rectangle_t roi;
+    /* On zephyr, use k_thread */
+#if defined(__ZEPHYR__)
+    const size_t renderThreadStackSize = CONFIG_NVT_ML_OD_RENDER_THREAD_STACK_SIZE;
+    static K_THREAD_STACK_DEFINE(renderThreadStack,
+                                 renderThreadStackSize);
+    static k_thread renderThread;
+    static k_tid_t renderThreadId;
+
+    renderThreadId = k_thread_create(&renderThread,
+                                     renderThreadStack,
+                                     K_THREAD_STACK_SIZEOF(renderThreadStack),
+                                     render_task,
+                                     &renderParam,
+                                     NULL,
+                                     NULL,
+                                     CONFIG_MAIN_THREAD_PRIORITY,
+                                     0,
+                                     K_FOREVER);
+    if (renderThreadId == NULL) {
+        printf_err("Failed to create render task\n");
+        return;
+    }
 
-                image_t RGB565Img;
-                image_t YUV422Img;
+    k_thread_name_set(renderThreadId, "render task");
 
-                RGB565Img.w = infFramebuf->frameImage.w;
-                RGB565Img.h = infFramebuf->frameImage.h;
-                RGB565Img.data = (uint8_t *)infFramebuf->frameImage.data;
-                RGB565Img.pixfmt = PIXFORMAT_RGB565;
+    k_thread_start(renderThreadId);
+#else
+    ret = xTaskCreate(render_task, "render task", 2 * 1024, &renderParam, RENDER_TASK_PRIO, nullptr);
 
-                YUV422Img.w = RGB565Img.w;
-                YUV422Img.h = RGB565Img.h;
-                YUV422Img.data = (uint8_t *)infFramebuf->frameImage.data;
-                YUV422Img.pixfmt = PIXFORMAT_YUV422;
+    if (ret != pdPASS)
+    {
+        printf_err("FreeRTOS: Failed to render task \n");
+        vTaskDelete(nullptr);
+        return;
+    }
+#endif
 
-                roi.x = 0;
-                roi.y = 0;
-                roi.w = RGB565Img.w;
-                roi.h = RGB565Img.h;
-                imlib_nvt_scale(&RGB565Img, &YUV422Img, &roi);
+    /* Capture stage, render hands each slot back once the frame is shown */
+    while (1)
+    {
+#if !defined (__USE_CCAP__)
+#if defined(__ZEPHYR__)
+        k_mutex_lock(&arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+        if (arm::app::yolofastest::record_ctrl_end) {
+            k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
+            s_frameSlots.Drain();
+            warn("Bye!\n");
+            return;
+        } else if (!arm::app::yolofastest::infer_ctrl_cont && !arm::app::yolofastest::infer_ctrl_oneshot) {
+            warn("Press 'od next' to resume object detection inference one-shot\n");
+            warn("Press 'od resume' to resume object detection inference continuously\n");
+            warn("Press 'od suspend' to suspend object detection inference\n");
+            warn("Press 'od exit' to exit program\n");
 
+		k_condvar_wait(&arm::app::yolofastest::condvar_infer_ctrl, &arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+            k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
+            continue;
+        } else if (arm::app::yolofastest::infer_ctrl_cont) {
+            __ASSERT_NO_MSG(!arm::app::yolofastest::infer_ctrl_oneshot);
+        } else if (arm::app::yolofastest::infer_ctrl_oneshot) {
+            __ASSERT_NO_MSG(!arm::app::yolofastest::infer_ctrl_cont);
+            arm::app::yolofastest::infer_ctrl_oneshot = false;
+        }
+        k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
 #else
-                image_t origImg;
-                image_t vflipImg;
-
-                origImg.w = infFramebuf->frameImage.w;
-                origImg.h = infFramebuf->frameImage.h;
-                origImg.data = (uint8_t *)infFramebuf->frameImage.data;
-                origImg.pixfmt = PIXFORMAT_RGB565;
+        info("Press 'n' to run next image inference \n");
+        info("Press 'q' to exit program \n");
 
-                vflipImg.w = origImg.w;
-                vflipImg.h = origImg.h;
-                vflipImg.data = (uint8_t *)infFramebuf->frameImage.data;
-                vflipImg.pixfmt = PIXFORMAT_RGB565;
-
-                imlib_nvt_vflip(&origImg, &vflipImg);
+        while ((chStdIn = getchar()))
+        {
+            if (chStdIn == 'q')
+            {
+                s_frameSlots.Drain();
+                vTaskDelete(nullptr);
+                return;
+            }
+            else if (chStdIn != 'n')
+            {
+                break;
+            }
+        }
 #endif
-                UVC_SendImage((uint32_t)infFramebuf->frameImage.data, IMAGE_FB_SIZE, uvcStatus.StillImage);
 
-            }
+#endif
 
+        /* On zephyr, apply topN, scheduling and tiling modes from shell */
+#if defined(__ZEPHYR__)
+        k_mutex_lock(&arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+        int topN = arm::app::yolofastest::infer_ctrl_topn;
+        bool bLatestFrameWins = arm::app::yolofastest::infer_ctrl_latest;
+        bool bMotionGate = arm::app::yolofastest::infer_ctrl_motion;
+        motionGate.Configure(arm::app::yolofastest::infer_ctrl_motion_pixel,
+                             arm::app::yolofastest::infer_ctrl_motion_permille,
+                             arm::app::yolofastest::infer_ctrl_motion_refresh);
+        int inferInterval = arm::app::yolofastest::infer_ctrl_interval;
+        bool bAdaptiveTiles = arm::app::yolofastest::infer_ctrl_adaptive_tiles;
+#if MODEL_SWITCHING
+        int modelIdx = arm::app::yolofastest::infer_ctrl_model;
+#endif
+        k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
+#else
+        int topN = TOP_N;
+        bool bLatestFrameWins = LATEST_FRAME_WINS;
+        bool bMotionGate = MOTION_GATE;
+        motionGate.Configure(MOTION_PIXEL_THRESHOLD, MOTION_CHANGED_PERMILLE, MOTION_REFRESH_FRAMES);
+        int inferInterval = INFER_INTERVAL;
+        bool bAdaptiveTiles = TILED_ADAPTIVE;
 #endif
 
-            u64PerfFrames ++;
+#if MODEL_SWITCHING
+        /* Switch models between frames, falling back to the current one if the new one does not fit */
+        if (modelIdx != curModelIdx)
+        {
+            s_frameSlots.Drain();
 
-            if ((uint64_t) pmu_get_systick_Count() > u64PerfCycle)
+            if (switch_model(model, modelIdx, inputImgCols, inputImgRows, bSignedInput, &inputQuantLut, postProcess))
             {
-                info("Total inference rate: %llu\n", u64PerfFrames / EACH_PERF_SEC);
-#if defined (__USE_DISPLAY__)
-                sprintf(szDisplayText, "Frame Rate %llu", u64PerfFrames / EACH_PERF_SEC);
-                //              sprintf(szDisplayText,"Time %llu",(uint64_t) pmu_get_systick_Count() / (uint64_t)SystemCoreClock);
-
-                sDispRect.u32TopLeftX = 0;
-                sDispRect.u32TopLeftY = (frameBuffer.h * IMAGE_DISP_UPSCALE_FACTOR);
-                sDispRect.u32BottonRightX = (frameBuffer.w * IMAGE_DISP_UPSCALE_FACTOR);
-                sDispRect.u32BottonRightY = ((frameBuffer.h * IMAGE_DISP_UPSCALE_FACTOR) + (FONT_DISP_UPSCALE_FACTOR * FONT_HTIGHT) - 1);
-                Display_ClearRect(C_WHITE, &sDispRect);
-                Display_PutText(
-                    szDisplayText,
-                    strlen(szDisplayText),
-                    0,
-                    frameBuffer.h * IMAGE_DISP_UPSCALE_FACTOR,
-                    C_BLUE,
-                    C_WHITE,
-                    false,
-                    FONT_DISP_UPSCALE_FACTOR
-                );
-#endif
-                u64PerfCycle = (uint64_t)pmu_get_systick_Count() + (uint64_t)(SystemCoreClock * EACH_PERF_SEC);
-                u64PerfFrames = 0;
+                info("Switched to %s-optimized model\n", arm::app::yolofastest::model_names[modelIdx]);
+                curModelIdx = modelIdx;
             }
+            else if (switch_model(model, curModelIdx, inputImgCols, inputImgRows, bSignedInput, &inputQuantLut, postProcess))
+            {
+                printf_err("Failed to switch to %s-optimized model\n", arm::app::yolofastest::model_names[modelIdx]);
 
-            PresentInferenceResult(infFramebuf->results, labels);
-            infFramebuf->eState = eFRAMEBUF_EMPTY;
-        }
-
-        emptyFramebuf = get_empty_framebuf();
-
-        if (emptyFramebuf)
-        {
-#if !defined (__USE_CCAP__)
-#if defined(__ZEPHYR__)
-            k_mutex_lock(&arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
-            if (arm::app::yolofastest::record_ctrl_end) {
-                k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
-                warn("Bye!\n");
-                return;
-            } else if (!arm::app::yolofastest::infer_ctrl_cont && !arm::app::yolofastest::infer_ctrl_oneshot) {
-                warn("Press 'od next' to resume object detection inference one-shot\n");
-                warn("Press 'od resume' to resume object detection inference continuously\n");
-                warn("Press 'od suspend' to suspend object detection inference\n");
-                warn("Press 'od exit' to exit program\n");
-
-		k_condvar_wait(&arm::app::yolofastest::condvar_infer_ctrl, &arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+                k_mutex_lock(&arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+                arm::app::yolofastest::infer_ctrl_model = curModelIdx;
                 k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
-                continue;
-            } else if (arm::app::yolofastest::infer_ctrl_cont) {
-                __ASSERT_NO_MSG(!arm::app::yolofastest::infer_ctrl_oneshot);
-            } else if (arm::app::yolofastest::infer_ctrl_oneshot) {
-                __ASSERT_NO_MSG(!arm::app::yolofastest::infer_ctrl_cont);
-                arm::app::yolofastest::infer_ctrl_oneshot = false;
             }
-            k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
-#else
-            info("Press 'n' to run next image inference \n");
-            info("Press 'q' to exit program \n");
-
-            while ((chStdIn = getchar()))
+            else
             {
-                if (chStdIn == 'q')
-                {
-                    vTaskDelete(nullptr);
-                    return;
-                }
-                else if (chStdIn != 'n')
+                printf_err("Failed to restore %s-optimized model\n", arm::app::yolofastest::model_names[curModelIdx]);
+
+                /*
+                 * No model to infer with. The slots stay drained, so no stage runs again; halt
+                 * here until 'od exit' rather than return while the stages still point at the
+                 * model and buffers of this task
+                 */
+                warn("Press 'od exit' to exit program\n");
+
+                k_mutex_lock(&arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
+                while (!arm::app::yolofastest::record_ctrl_end)
                 {
-                    break;
+                    k_condvar_wait(&arm::app::yolofastest::condvar_infer_ctrl,
+                                   &arm::app::yolofastest::mutex_infer_ctrl, K_FOREVER);
                 }
-            }
-#endif
-
-            const uint8_t *pu8ImgSrc = get_img_array(u8ImgIdx);
+                k_mutex_unlock(&arm::app::yolofastest::mutex_infer_ctrl);
 
-            if (nullptr == pu8ImgSrc)
-            {
-                printf_err("Failed to get image index %" PRIu32 " (max: %u)\n", u8ImgIdx,
-                           NUMBER_OF_FILES - 1);
-                /* On zephyr, context is main thread */
-#if !defined(__ZEPHYR__)	   
-                vTaskDelete(nullptr);
-#endif
+                warn("Bye!\n");
                 return;
             }
 
-            u8ImgIdx ++;
+            s_frameSlots.Refill();
+        }
+#endif
 
-            if (u8ImgIdx >= NUMBER_OF_FILES)
-                u8ImgIdx = 0;
+        /* Frames dropped for this one, with those they were dropped for in turn */
+        uint32_t u32SlotsDropped = 0;
+        uint32_t u32FramesDropped = 0;
 
-#endif
+        S_FRAMEBUF *emptyFramebuf = s_frameSlots.Acquire(bLatestFrameWins, u32SlotsDropped, u32FramesDropped);
 
-#if defined (__USE_CCAP__)
-            //capture frame from CCAP
+        //capture frame
 #if defined(__PROFILE__)
-            u64CCAPStartCycle = pmu_get_systick_Count();
+        u64CCAPStartCycle = pmu_get_systick_Count();
 #endif
 
-            ImageSensor_Capture((uint32_t)(emptyFramebuf->frameImage.data));
+        if (frameSource.Capture(&emptyFramebuf->frameImage, emptyFramebuf->modelStage) != 0)
+        {
+            printf_err("Failed to capture frame\n");
+            /* On zephyr, context is main thread */
+#if !defined(__ZEPHYR__)
+            vTaskDelete(nullptr);
+#endif
+            return;
+        }
 
 #if defined(__PROFILE__)
-            u64CCAPEndCycle = pmu_get_systick_Count();
-            info("ccap capture cycles %llu \n", (u64CCAPEndCycle - u64CCAPStartCycle));
+        u64CCAPEndCycle = pmu_get_systick_Count();
+        info("capture cycles %llu \n", (u64CCAPEndCycle - u64CCAPStartCycle));
 #endif
 
-#else
-            //copy source image to frame buffer
-            image_t srcImg;
+        s_u32FramesCaptured++;
 
-            srcImg.w = IMAGE_WIDTH;
-            srcImg.h = IMAGE_HEIGHT;
-            srcImg.data = (uint8_t *)pu8ImgSrc;
-            srcImg.pixfmt = PIXFORMAT_RGB888;
+        /* Latest frame wins: whatever still waits for inference is older than this frame */
+        if (bLatestFrameWins)
+            s_frameSlots.DropPending(u32SlotsDropped, u32FramesDropped);
 
-            roi.x = 0;
-            roi.y = 0;
-            roi.w = IMAGE_WIDTH;
-            roi.h = IMAGE_HEIGHT;
+        s_u32FramesDropped += u32SlotsDropped;
+
+        /* A dropped frame may have been the last inferred one, infer this one */
+        const bool bDropped = (u32FramesDropped > 0);
+
+        eJobResults eResults = eJOB_RESULTS_INFER;
 
-            imlib_nvt_scale(&srcImg, &emptyFramebuf->frameImage, &roi);
+        /* Sparse inference: the frames in between take the tracker's prediction */
+        if (!bDropped && (framesToInference > 0) && (framesToInference < inferInterval))
+        {
+            eResults = eJOB_RESULTS_PREDICT;
+            framesToInference--;
+            s_u32FramesPredicted++;
+        }
+        else
+        {
+            /* Motion gate: an unchanged scene reuses the last results and leaves the NPU idle */
+            if (bMotionGate)
+            {
+#if defined(__PROFILE__)
+                uint64_t u64MotionStartCycle = pmu_get_systick_Count();
+#endif
+                if (!motionGate.Check(&emptyFramebuf->frameImage, bDropped || !bMotionGateOn))
+                {
+                    eResults = eJOB_RESULTS_REUSE;
+                    s_u32FramesReused++;
+                }
+#if defined(__PROFILE__)
+                info("motion check cycles %llu \n", (pmu_get_systick_Count() - u64MotionStartCycle));
 #endif
-            emptyFramebuf->results.clear();
-            emptyFramebuf->eState = eFRAMEBUF_FULL;
+            }
+
+            bMotionGateOn = bMotionGate;
+            framesToInference = inferInterval - 1;
         }
 
-        /* On zephyr, check equivalent of FreeRTOS tick period in ms
-	 * (portTICK_PERIOD_MS in portmacro.h and configTICK_RATE_HZ in
-	 * FreeRTOSConfig.h).
-	 */
-#if defined(__ZEPHYR__)
-        k_msleep(1);
-#else
-        vTaskDelay(1);
-#endif
+        emptyFramebuf->results.clear();
+        emptyFramebuf->job.topN = topN;
+        emptyFramebuf->job.eResults = eResults;
+        emptyFramebuf->job.bAdaptiveTiles = bAdaptiveTiles;
+        emptyFramebuf->job.u32FramesDropped = u32FramesDropped;
+
+        //trigger inference
+        s_frameSlots.Submit(emptyFramebuf);
     }
 
 }
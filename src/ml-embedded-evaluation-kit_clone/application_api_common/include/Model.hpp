@@ -78,6 +78,22 @@ namespace app {
                   uint32_t nnModelSize,
                   tflite::MicroAllocator* allocator = nullptr);
 
+        /** @brief      Switch to another model, in the tensor arena Init was
+         *              given. The interpreter of the current model is torn
+         *              down and the tensors of the new one are allocated and
+         *              bound afresh, so all tensor pointers from before are
+         *              stale. The op resolver is kept, and must already hold
+         *              the operators of the new model.
+         *  @param[in]  nnModelAddr         Pointer to the model.
+         *  @param[in]  nnModelSize         Size of the model in bytes, if known.
+         *  @return     true if the new model is ready, false otherwise. If
+         *              the new model failed after the old one was torn down,
+         *              the object is left uninitialised until a switch to a
+         *              model that fits succeeds.
+        **/
+        bool SwitchModel(const uint8_t* nnModelAddr,
+                         uint32_t nnModelSize);
+
         /**
          * @brief       Gets the allocator pointer for this instance.
          * @return      Pointer to a tflite::MicroAllocator object, if
@@ -132,13 +148,29 @@ namespace app {
         /** @brief   Gets the total size of tensor arena available for use. */
         size_t GetActivationBufferSize();
 
+        /**
+         * @brief       Called at the end of Init, once the tensors have been
+         *              allocated, for the use case to derive data from them.
+         * @return      true if successful, false otherwise.
+         **/
+        virtual bool PostInit() { return true; }
+
     private:
+        /**
+         * @brief       Creates the interpreter of m_pModel on m_pAllocator,
+         *              allocates and binds its tensors and runs PostInit.
+         * @return      true if successful, false otherwise.
+         **/
+        bool CreateInterpreter();
+
         const tflite::Model* m_pModel{nullptr};            /* Tflite model pointer. */
         std::unique_ptr<tflite::MicroInterpreter> m_pInterpreter{nullptr}; /* Tflite interpreter. */
         tflite::MicroAllocator* m_pAllocator{nullptr};     /* Tflite micro allocator. */
         bool m_inited{false};                              /* Indicates whether this object has been initialised. */
         const uint8_t* m_modelAddr{nullptr};               /* Model address */
         uint32_t m_modelSize{0};                           /* Model size */
+        uint8_t* m_tensorArenaAddr{nullptr};               /* Tensor arena of the allocator Init created, if it did */
+        uint32_t m_tensorArenaSize{0};                     /* Tensor arena size */
 
         std::vector<TfLiteTensor*> m_input{};              /* Model's input tensor pointers. */
         std::vector<TfLiteTensor*> m_output{};             /* Model's output tensor pointers. */
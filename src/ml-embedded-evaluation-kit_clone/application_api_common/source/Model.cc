@@ -72,10 +72,62 @@ bool arm::app::Model::Init(uint8_t* tensorArenaAddr,
             return false;
         }
         debug("Created new allocator @ 0x%p\n", this->m_pAllocator);
+
+        this->m_tensorArenaAddr = tensorArenaAddr;
+        this->m_tensorArenaSize = tensorArenaSize;
     } else {
         debug("Using existing allocator @ 0x%p\n", this->m_pAllocator);
     }
 
+    return this->CreateInterpreter();
+}
+
+/* Switch to another model in the same tensor arena */
+bool arm::app::Model::SwitchModel(const uint8_t* nnModelAddr,
+                                  uint32_t nnModelSize)
+{
+    /* Also after a failed switch, which left the arena to switch again in */
+    if (!this->m_tensorArenaAddr) {
+        printf_err("Model switch needs the tensor arena of the allocator Init created\n");
+        return false;
+    }
+
+    debug("switching to model @ 0x%p\n", nnModelAddr);
+    debug("model size: %" PRIu32 " bytes.\n", nnModelSize);
+
+    const tflite::Model* pModel = ::tflite::GetModel(nnModelAddr);
+
+    if (pModel->version() != TFLITE_SCHEMA_VERSION) {
+        printf_err("Model's schema version %" PRIu32 " is not equal "
+                   "to supported version %d.",
+                   pModel->version(),
+                   TFLITE_SCHEMA_VERSION);
+        return false;
+    }
+
+    /* Tear down the current interpreter before its arena is handed out again */
+    this->m_inited = false;
+    this->m_pInterpreter.reset();
+    this->m_input.clear();
+    this->m_output.clear();
+
+    this->m_pModel = pModel;
+    this->m_modelAddr = nnModelAddr;
+    this->m_modelSize = nnModelSize;
+
+    /* A fresh allocator over the whole arena, nothing of the old model survives in it */
+    this->m_pAllocator = tflite::MicroAllocator::Create(this->m_tensorArenaAddr, this->m_tensorArenaSize);
+
+    if (!this->m_pAllocator) {
+        printf_err("Failed to create allocator\n");
+        return false;
+    }
+
+    return this->CreateInterpreter();
+}
+
+bool arm::app::Model::CreateInterpreter()
+{
     this->m_pInterpreter = std::make_unique<tflite::MicroInterpreter>(
         this->m_pModel, this->GetOpResolver(), this->m_pAllocator);
 
@@ -119,6 +171,11 @@ bool arm::app::Model::Init(uint8_t* tensorArenaAddr,
         this->LogInterpreterInfo();
     }
 
+    if (!this->PostInit()) {
+        printf_err("Model post-initialisation failed\n");
+        return false;
+    }
+
     this->m_inited = true;
     return true;
 }
@@ -0,0 +1,180 @@
+/**************************************************************************//**
+ * @file     BatchedNms.hpp
+ * @version  V1.00
+ * @brief    Batched multi-class non-maximum suppression header file
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef BATCHED_NMS_HPP
+#define BATCHED_NMS_HPP
+
+#include "DetectionPool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/**
+ * @brief   Non-maximum suppression scope.
+ */
+enum class NmsMode
+{
+    PerClass,       /* Boxes only suppress boxes of the same class */
+    PerClassSorted, /* PerClass, visiting every class by its own score */
+    ClassAgnostic   /* Boxes suppress overlapping boxes of any class */
+};
+
+/**
+ * @brief   Intersection over union test, for the pool value type.
+ */
+template <typename T>
+struct NmsOverlap;
+
+/* Float boxes: intersection / union > threshold */
+template <>
+struct NmsOverlap<float>
+{
+    using Area = float;
+
+    static bool Exceeds(float intersection, float boxesUnion, float threshold)
+    {
+        float iou = 0;
+
+        if (intersection != 0 && boxesUnion != 0)
+        {
+            iou = intersection / boxesUnion;
+        }
+
+        return iou > threshold;
+    }
+};
+
+/* Integer pixel boxes and a Q15 threshold, without division */
+template <>
+struct NmsOverlap<int32_t>
+{
+    using Area = int64_t;
+
+    static bool Exceeds(int64_t intersection, int64_t boxesUnion, int32_t threshold)
+    {
+        return boxesUnion > 0 && (intersection << 15) > threshold * boxesUnion;
+    }
+};
+
+/**
+ * @brief   Non-maximum suppression over a detection pool in a single pass.
+ *          Candidates are bucketed by their non-zero classes, only non-empty
+ *          classes are visited, by index, and box edges and areas are
+ *          computed once per frame. Scratch storage is allocated at
+ *          construction and grows along with the pool.
+ * @tparam  T   Pool value type: float, or int32_t for the fixed-point path.
+ */
+template <typename T>
+class BasicBatchedNms
+{
+public:
+    using Area = typename NmsOverlap<T>::Area;
+
+    /**
+     * @brief       Constructor.
+     * @param[in]   capacity     Capacity of the detection pool to process.
+     * @param[in]   numClasses   Number of class scores per candidate.
+     **/
+    BasicBatchedNms(int capacity, int numClasses);
+
+    /**
+     * @brief       Suppress class scores of overlapping candidates, with
+     *              the results of image::CalculateNMS on the pool order.
+     *              That sorts the list by the class 0 score before every
+     *              class: class 0 candidates are visited by descending score,
+     *              ties keeping the pool order, after which the class 0
+     *              survivors lead the order; the other classes are visited
+     *              in that order. NmsMode::PerClassSorted instead visits
+     *              every class by descending score, as if the sort were on
+     *              the class being suppressed. On return, the order array
+     *              lists the candidates in output order.
+     * @param[in,out]   detections    Detection pool.
+     * @param[in]       iouThreshold  Intersection over union threshold, in
+     *                                Q15 for the fixed-point path.
+     * @param[in]       mode          Suppression scope.
+     **/
+    void Run(BasicDetectionPool<T> &detections, T iouThreshold, NmsMode mode = NmsMode::PerClass);
+
+private:
+    int m_capacity;                     /* Capacity of the detection pool */
+    int m_numClasses;                   /* Class scores per candidate */
+
+    std::vector<T> m_left;              /* Box left edges */
+    std::vector<T> m_right;             /* Box right edges */
+    std::vector<T> m_top;               /* Box top edges */
+    std::vector<T> m_bottom;            /* Box bottom edges */
+    std::vector<Area> m_area;           /* Box areas */
+    std::vector<T> m_score;             /* Sort key of the bucket being processed */
+    std::vector<int> m_rank;            /* Position of each candidate in the order */
+    std::vector<int> m_orderTmp;        /* Order double buffer */
+    std::vector<uint8_t> m_inBucket;    /* Bucket membership flags */
+    std::vector<int> m_classStart;      /* Bucket offsets, one per class plus end */
+    std::vector<uint16_t> m_buckets;    /* Candidate indices, grouped by class */
+
+    /**
+     * @brief       Grow the scratch storage for a larger pool.
+     * @param[in]   capacity   Capacity of the detection pool to process.
+     **/
+    void Reserve(int capacity);
+
+    /**
+     * @brief       Sort a bucket by descending m_score, ties by ascending rank.
+     * @param[in,out]   bucket   Candidate indices.
+     * @param[in]       count    Number of candidates in the bucket.
+     **/
+    void SortBucket(uint16_t *bucket, int count);
+
+    /**
+     * @brief       Sort a bucket by ascending rank, i.e. in the current order.
+     * @param[in,out]   bucket   Candidate indices.
+     * @param[in]       count    Number of candidates in the bucket.
+     **/
+    void SortBucketByRank(uint16_t *bucket, int count);
+
+    /**
+     * @brief       Greedy suppression over a sorted bucket.
+     * @param[in]       detections    Detection pool.
+     * @param[in]       bucket        Candidate indices, sorted.
+     * @param[in]       count         Number of candidates in the bucket.
+     * @param[in]       iouThreshold  Intersection over union threshold.
+     * @param[in]       idxClass      Class to suppress, or -1 for all classes.
+     **/
+    void SuppressBucket(BasicDetectionPool<T> &detections, const uint16_t *bucket, int count,
+                        T iouThreshold, int idxClass);
+
+    /**
+     * @brief       Move a sorted bucket to the front of the order, keeping
+     *              the relative order of the other candidates.
+     * @param[in,out]   detections       Detection pool.
+     * @param[in]       bucket           Candidate indices, sorted.
+     * @param[in]       count            Number of candidates in the bucket.
+     * @param[in]       survivorsFirst   Move the candidates left unsuppressed
+     *                                   ahead of the suppressed ones.
+     **/
+    void PromoteBucket(BasicDetectionPool<T> &detections, const uint16_t *bucket, int count,
+                       bool survivorsFirst = false);
+};
+
+/* Float NMS */
+using BatchedNms = BasicBatchedNms<float>;
+
+/* Fixed-point NMS, integer IoU */
+using BatchedNmsQ = BasicBatchedNms<int32_t>;
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* BATCHED_NMS_HPP */
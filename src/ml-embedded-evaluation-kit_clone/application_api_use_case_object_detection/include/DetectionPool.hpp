@@ -0,0 +1,132 @@
+/**************************************************************************//**
+ * @file     DetectionPool.hpp
+ * @version  V1.00
+ * @brief    Detection candidate pool header file
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef DETECTION_POOL_HPP
+#define DETECTION_POOL_HPP
+
+#include "ImageUtils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/**
+ * @brief   Pool of detection candidates in structure-of-arrays layout. Boxes,
+ *          objectness and class scores share one contiguous buffer allocated
+ *          at construction. Filling and clearing the pool per frame only
+ *          touches the heap when a frame holds more candidates than any
+ *          before, as the buffer then doubles, unless the capacity is fixed.
+ * @tparam  T   Value type: float, or int32_t for the fixed-point path.
+ */
+template <typename T>
+class BasicDetectionPool
+{
+public:
+    /** @brief  Box centre and size. */
+    struct Box
+    {
+        T x;
+        T y;
+        T w;
+        T h;
+    };
+
+    /* Most candidates a pool holds, so that indices fit in 16 bits */
+    static constexpr int ms_maxCapacity = 65536;
+
+    /**
+     * @brief       Constructor.
+     * @param[in]   capacity     Number of candidates held.
+     * @param[in]   numClasses   Number of class scores per candidate.
+     * @param[in]   growable     Grow once full, instead of failing Append.
+     **/
+    BasicDetectionPool(int capacity, int numClasses, bool growable = false);
+
+    /** @brief  Drops all candidates, keeping the storage. */
+    void Clear();
+
+    /** @brief  Gets the number of candidates held. */
+    int Size() const;
+
+    /** @brief  Gets the number of candidates held before full. */
+    int Capacity() const;
+
+    /** @brief  Tells whether the pool grows once full. */
+    bool IsGrowable() const;
+
+    /** @brief  Gets the number of class scores per candidate. */
+    int NumClasses() const;
+
+    /**
+     * @brief       Appends an uninitialised candidate, growing the pool if
+     *              it is full and its capacity is not fixed.
+     * @return      Index of the new candidate, or -1 if the pool is full.
+     **/
+    int Append();
+
+    /** @brief  Gets the box of the candidate at given index. */
+    Box GetBox(int idx) const;
+
+    /** @brief  Sets the box of the candidate at given index. */
+    void SetBox(int idx, const Box &box);
+
+    /** @brief  Gets the objectness of the candidate at given index. */
+    T &Objectness(int idx);
+    T Objectness(int idx) const;
+
+    /** @brief  Gets the class scores of the candidate at given index. */
+    T *Probs(int idx);
+    const T *Probs(int idx) const;
+
+    /**
+     * @brief   Gets the candidate index scratch array. It holds Capacity()
+     *          entries and is free for post-processing to order candidates.
+     **/
+    int *Order();
+
+private:
+    int m_capacity;             /* Number of candidates held before full */
+    int m_numClasses;           /* Class scores per candidate */
+    bool m_growable;            /* Grow once full */
+    int m_size{0};              /* Number of candidates held */
+
+    std::vector<T> m_buffer;    /* Storage for all arrays below */
+    T *m_x;                     /* Box centre x */
+    T *m_y;                     /* Box centre y */
+    T *m_w;                     /* Box width */
+    T *m_h;                     /* Box height */
+    T *m_objectness;            /* Objectness */
+    T *m_probs;                 /* Class scores, m_numClasses per candidate */
+
+    std::vector<int> m_order;   /* Index scratch */
+
+    /**
+     * @brief       Reallocates the storage for a larger capacity, keeping
+     *              the candidates and the order array.
+     * @param[in]   capacity   New capacity.
+     **/
+    void Grow(int capacity);
+};
+
+/* Float pool */
+using DetectionPool = BasicDetectionPool<float>;
+
+/* Fixed-point pool: boxes in Q8 source image pixels, scores in Q31 */
+using DetectionPoolQ = BasicDetectionPool<int32_t>;
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* DETECTION_POOL_HPP */
@@ -59,6 +59,7 @@ public:
     int     m_w{0};
     int     m_h{0};
     int     m_cls{0};
+    int     m_trackId{-1};  /* DetectionTracker track, -1 if untracked */
 };
 
 } /* namespace object_detection */
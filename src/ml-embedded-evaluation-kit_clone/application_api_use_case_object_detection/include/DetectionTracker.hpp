@@ -0,0 +1,161 @@
+/**************************************************************************//**
+ * @file     DetectionTracker.hpp
+ * @version  V1.00
+ * @brief    Multi-object tracker over detection results header file
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef DETECTION_TRACKER_HPP
+#define DETECTION_TRACKER_HPP
+
+#include "DetectionResult.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/**
+ * @brief   Tracks detection boxes from frame to frame. Detections are matched
+ *          to tracks of the same class by intersection over union, greedily
+ *          from the best overlap, and each track filters its box centre and
+ *          size with a constant-velocity Kalman filter, one per coordinate.
+ *          Between inferred frames, Predict moves the tracks on by their
+ *          velocity, so boxes keep following objects while the detector
+ *          only runs every few frames. A detection missed for a few frames
+ *          keeps its track, and its box, rather than flicker.
+ *          One call of Update or Predict is one frame. All storage is
+ *          allocated at construction.
+ */
+class DetectionTracker
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param[in]   maxTracks       Number of objects tracked at once.
+     * @param[in]   maxDetections   Number of detections per Update call.
+     * @param[in]   frameWidth      Frame width, boxes are clipped to it.
+     * @param[in]   frameHeight     Frame height, boxes are clipped to it.
+     * @param[in]   iouThreshold    Overlap from which a detection matches a track.
+     * @param[in]   maxMisses       Updates a track survives without a detection.
+     * @param[in]   minHits         Detections before a track is reported.
+     **/
+    DetectionTracker(int maxTracks,
+                     int maxDetections,
+                     int frameWidth,
+                     int frameHeight,
+                     float iouThreshold = 0.3f,
+                     int maxMisses = 2,
+                     int minHits = 1);
+
+    /**
+     * @brief       Frame with detections: match them to the tracks, correct
+     *              the tracks, start new ones and drop lost ones.
+     * @param[in,out]   results   Detections of the frame in, the reported
+     *                            tracks out, with their track IDs.
+     **/
+    void Update(std::vector<DetectionResult> &results);
+
+    /**
+     * @brief       Frame without detections: move the tracks on by a frame.
+     * @param[out]  results   The reported tracks, with their track IDs.
+     **/
+    void Predict(std::vector<DetectionResult> &results);
+
+    /**
+     * @brief       Frames dropped unseen: move the tracks on by numFrames
+     *              frames, as that many Predict calls would, reporting nothing.
+     * @param[in]   numFrames   Number of frames.
+     **/
+    void Advance(int numFrames);
+
+    /**
+     * @brief       Drop all tracks. Track IDs carry on.
+     **/
+    void Reset();
+
+private:
+    /* Constant-velocity Kalman filter of one box coordinate */
+    struct Axis
+    {
+        float x;    /* Position */
+        float v;    /* Velocity, per frame */
+        float p00;  /* Covariance of x */
+        float p01;  /* Covariance of x and v */
+        float p11;  /* Covariance of v */
+    };
+
+    struct Track
+    {
+        Axis axes[4];           /* Centre x, centre y, width, height */
+        int id;
+        int cls;
+        double score;           /* Of the last matched detection */
+        int hits;               /* Detections matched */
+        int misses;             /* Updates since the last match */
+        bool active;
+    };
+
+    /* Candidate match of a track and a detection */
+    struct Match
+    {
+        float iou;
+        uint16_t track;
+        uint16_t detection;
+    };
+
+    int m_frameWidth;
+    int m_frameHeight;
+    float m_iouThreshold;
+    int m_maxMisses;
+    int m_minHits;
+    int m_nextId{0};
+
+    std::vector<Track> m_tracks;            /* Track slots, inactive ones free */
+    std::vector<Match> m_matches;           /* Candidate matches of an Update */
+    std::vector<DetectionResult> m_detections; /* Copy of the detections of an Update */
+    std::vector<uint8_t> m_detectionUsed;   /* Detections matched in an Update */
+    std::vector<uint8_t> m_trackUsed;       /* Tracks matched in an Update */
+
+    static void PredictAxis(Axis &axis, float qPos, float qVel);
+    static void CorrectAxis(Axis &axis, float z, float r);
+    static void InitAxis(Axis &axis, float z, float r);
+
+    /**
+     * @brief       Advance all tracks by a frame, dropping those that left it.
+     **/
+    void PredictTracks();
+
+    /**
+     * @brief       Append the reported tracks to results.
+     * @param[out]  results   Reported tracks.
+     **/
+    void Report(std::vector<DetectionResult> &results) const;
+
+    /**
+     * @brief       Box of a track, clipped to the frame.
+     * @param[in]   track   Track.
+     * @return      Detection result of the track.
+     **/
+    DetectionResult ToResult(const Track &track) const;
+
+    /**
+     * @brief       Intersection over union of a track and a detection.
+     * @param[in]   track       Track.
+     * @param[in]   detection   Detection.
+     * @return      Intersection over union.
+     **/
+    static float Iou(const Track &track, const DetectionResult &detection);
+};
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* DETECTION_TRACKER_HPP */
@@ -18,10 +18,15 @@
 #define DETECTOR_POST_PROCESSING_HPP
 
 #include "ImageUtils.hpp"
+#include "BatchedNms.hpp"
+#include "DetectionPool.hpp"
 #include "DetectionResult.hpp"
+#include "YoloDecodeTable.hpp"
 #include "YoloFastestModel.hpp"
+#include "YoloHeadScan.hpp"
 
-#include <forward_list>
+#include <array>
+#include <vector>
 
 namespace arm
 {
@@ -35,10 +40,12 @@ struct Branch
     int resolution;
     int numBox;
     const float *anchor;
-    int8_t *modelOutput;
+    const int8_t *modelOutput;  /* Data of the tensor the branch was built for */
     float scale;
     int zeroPoint;
     size_t size;
+    const YoloDecodeTable *table;
+    int8_t objCutoff;   /* Raw objectness below which no cell passes the threshold */
 };
 
 struct Network
@@ -46,10 +53,44 @@ struct Network
     int inputWidth;
     int inputHeight;
     int numClasses;
-    std::vector<Branch> branches;
+    std::array<Branch, 2> branches;
     int topN;
 };
 
+/* Output data of each branch of a Network, decoded with the branch's layout and quantization */
+using BranchOutputs = std::array<const int8_t *, 2>;
+
+/**
+ * @brief   Output head layout read from the Network at run time. A
+ *          compile-time layout, e.g. YoloFastestModelConfig, instead gives
+ *          non-zero counts and ms_anchors[branch][box * 2 + (0: w, 1: h)].
+ */
+struct DynamicHeadConfig
+{
+    static constexpr int ms_numBranches = 0;
+    static constexpr int ms_numBoxes    = 0;
+    static constexpr int ms_numClasses  = 0;
+};
+
+/**
+ * @brief   Decoding strategy for the YOLO output branches.
+ */
+enum class DecodeMode
+{
+    Float,          /* Dequantize and apply sigmoid to every cell's objectness */
+    Int8Prefilter,  /* Reject cells on raw int8 objectness before dequantization */
+    FixedPoint      /* Int8Prefilter, then integer decode and NMS: scores in Q31, boxes in Q8 */
+};
+
+/**
+ * @brief   Class scores kept for each box.
+ */
+enum class ClassMode
+{
+    AllClasses,     /* Every class scoring above the threshold */
+    BestClass       /* Only the highest scoring class */
+};
+
 /**
  * @brief   Helper class to manage tensor post-processing for "object_detection"
  *          output.
@@ -62,12 +103,78 @@ public:
      * @param[in]   threshold     Post-processing threshold.
      * @param[in]   nms           Non-maximum Suppression threshold.
      * @param[in]   numClasses    Number of classes.
-     * @param[in]   topN          Top N for each class.
+     * @param[in]   topN          Candidates with the highest objectness to
+     *                            keep, 0 for all of them.
+     * @param[in]   decodeMode    Decoding strategy for the output branches.
+     * @param[in]   maxDetections Capacity of the detection pool allocated up
+     *                            front. Once it is full, only the candidates
+     *                            with the highest objectness are kept,
+     *                            unless growPool is set.
+     * @param[in]   nmsMode       Non-maximum suppression scope.
+     * @param[in]   classMode     Class scores kept for each box.
+     * @param[in]   classMask     Class indices to detect, empty for all.
+     *                            Other classes are neither decoded nor
+     *                            considered by NMS.
+     * @param[in]   growPool      Grow the detection pool past maxDetections
+     *                            in crowded frames, keeping every candidate,
+     *                            at the cost of heap allocations.
      **/
     explicit DetectorPostprocessing(float threshold = 0.5f,
                                     float nms = 0.45f,
                                     int numClasses = 1,
-                                    int topN = 0);
+                                    int topN = 0,
+                                    DecodeMode decodeMode = DecodeMode::Float,
+                                    int maxDetections = 128,
+                                    NmsMode nmsMode = NmsMode::PerClass,
+                                    ClassMode classMode = ClassMode::AllClasses,
+                                    const std::vector<int> &classMask = {},
+                                    bool growPool = false);
+
+    /**
+     * @brief       Set the decode lookup tables of the output branches, e.g.
+     *              from YoloFastestModel::GetDecodeTable. Tables not matching
+     *              the output tensors' quantization are rebuilt on use.
+     * @param[in]   table0   Lookup table of output branch 0, or nullptr.
+     * @param[in]   table1   Lookup table of output branch 1, or nullptr.
+     **/
+    void SetDecodeTables(YoloDecodeTable *table0, YoloDecodeTable *table1);
+
+    /**
+     * @brief       Set the number of candidates kept per frame. Takes effect
+     *              from the next RunPostProcessing call.
+     * @param[in]   topN   Candidates with the highest objectness to keep,
+     *                     0 to keep all, up to a fixed pool's capacity.
+     **/
+    void SetTopN(int topN);
+
+    /**
+     * @brief       Set where the original image sits in a letterboxed network
+     *              input, so that boxes map back to the original image. Takes
+     *              effect from the next RunPostProcessing call.
+     * @param[in]   padCols       Columns of padding left of the image.
+     * @param[in]   padRows       Rows of padding above the image.
+     * @param[in]   contentCols   Columns the image spans in the network input,
+     *                            0 when the image fills the input, the default.
+     * @param[in]   contentRows   Rows the image spans in the network input,
+     *                            0 when the image fills the input.
+     **/
+    void SetLetterbox(int padCols, int padRows, int contentCols, int contentRows);
+
+    /**
+     * @brief       Prepare the output branches and their lookup tables for the
+     *              given output tensors, unless already done for them.
+     *              RunPostProcessing prepares on its first call otherwise; with
+     *              DecodeMode::FixedPoint, preparing beforehand keeps the
+     *              float table building out of the per-frame path.
+     * @param[in]   imgNetRows     Number of rows in the network input image.
+     * @param[in]   imgNetCols     Number of columns in the network input image.
+     * @param[in]   modelOutput0   Output tensor of branch 0.
+     * @param[in]   modelOutput1   Output tensor of branch 1.
+     **/
+    void InitNetwork(uint32_t imgNetRows,
+                     uint32_t imgNetCols,
+                     TfLiteTensor *modelOutput0,
+                     TfLiteTensor *modelOutput1);
 
     /**
      * @brief       Post processing part of YOLO object detection CNN.
@@ -86,32 +193,190 @@ public:
                            TfLiteTensor *modelOutput1,
                            std::vector<DetectionResult> &resultsOut);
 
+    /**
+     * @brief       Post processing of copies of the output tensors InitNetwork
+     *              prepared for, so that the tensors can be overwritten by the
+     *              next inference meanwhile.
+     * @param[in]   imgSrcRows   Number of rows in the orignal input image.
+     * @param[in]   imgSrcCols   Number of columns in the oringal input image.
+     * @param[in]   output0      Copy of the data of output tensor 0.
+     * @param[in]   output1      Copy of the data of output tensor 1.
+     * @param[out]  resultsOut   Vector of detected results.
+     **/
+    void RunPostProcessing(uint32_t imgSrcRows,
+                           uint32_t imgSrcCols,
+                           const int8_t *output0,
+                           const int8_t *output1,
+                           std::vector<DetectionResult> &resultsOut);
+
 private:
     float m_threshold;  /* Post-processing threshold */
     float m_nms;        /* NMS threshold */
     int   m_numClasses; /* Number of classes */
     int   m_topN;       /* TopN */
+    DecodeMode m_decodeMode; /* Decoding strategy */
+    ClassMode m_classMode;   /* Class scores kept for each box */
+    std::vector<int> m_classList; /* Detected classes, ascending; pool slot j holds class m_classList[j] */
+    DetectionPool m_pool;    /* Detection candidates, reused every frame */
+    BatchedNms m_batchedNms; /* NMS engine sized for m_pool */
+    DetectionPoolQ m_poolQ;  /* Fixed-point candidates, used with DecodeMode::FixedPoint */
+    BatchedNmsQ m_batchedNmsQ; /* NMS engine sized for m_poolQ */
+    int32_t m_thresholdQ31;  /* m_threshold in Q31 */
+    int32_t m_nmsQ15;        /* m_nms in Q15 */
+    NmsMode m_nmsMode;       /* NMS scope */
+    YoloDecodeTable *m_decodeTables[2]{nullptr, nullptr}; /* Per-branch lookup tables */
+    YoloDecodeTable m_ownTables[2];      /* Tables built when FixedPoint has none set */
+    std::vector<uint16_t> m_scanIndices; /* Boxes passing the objectness scan */
+    std::vector<int> m_topNKey;          /* Top N tie-break key of each pool slot */
+    Network m_net{};                     /* Output branches, built once per model */
+    TfLiteTensor *m_netOutputs[2]{nullptr, nullptr}; /* Output tensors m_net was built for */
+    const void *m_netQuantParams[2]{nullptr, nullptr}; /* Their quantization m_net was built for */
+    bool m_netIsModelHead{false};        /* m_net matches YoloFastestModelConfig */
+    int m_letterboxPad[2]{0, 0};         /* Padding columns and rows of a letterboxed input */
+    int m_letterboxContent[2]{0, 0};     /* Columns and rows of the image in it, 0 if not letterboxed */
+
+    /* Number of boxes scanned per ScanObjectness call */
+    static constexpr int ms_scanChunk = 256;
 
     /**
-     * @brief       Insert the given Detection in the list.
-     * @param[in]   detections   List of detections.
-     * @param[in]   det          Detection to be inserted.
+     * @brief       Get the raw int8 objectness below which a cell cannot pass
+     *              the threshold, i.e. the inverse sigmoid of the threshold
+     *              quantized with the branch's scale and zero point.
+     * @param[in]   threshold   Detections threshold.
+     * @param[in]   scale       Branch output quantization scale.
+     * @param[in]   zeroPoint   Branch output quantization zero point.
+     * @return      Int8 objectness cutoff. Cells below it are rejected.
      **/
-    void InsertTopNDetections(std::forward_list<image::Detection> &detections, image::Detection &det);
+    static int8_t GetObjectnessCutoff(float threshold, float scale, int zeroPoint);
+
+    /**
+     * @brief       Get the classes to detect from a class mask.
+     * @param[in]   numClasses   Number of classes of the model.
+     * @param[in]   classMask    Class indices to detect, empty for all.
+     * @return      Valid class indices of the mask, ascending and unique.
+     **/
+    static std::vector<int> GetClassList(int numClasses, const std::vector<int> &classMask);
+
+    /**
+     * @brief       Get the number of candidates to keep per frame.
+     * @param[in]   topN         Top N setting, 0 for all.
+     * @param[in]   detections   Detection pool.
+     * @return      topN, capped at the capacity of a fixed pool.
+     **/
+    template <typename T>
+    static int GetTopN(int topN, const BasicDetectionPool<T> &detections);
+
+    /**
+     * @brief       Compare two candidates for top N selection, by objectness
+     *              and, on ties, by their top N key.
+     * @param[in]   detections   Detection pool.
+     * @param[in]   a            Index of the first candidate.
+     * @param[in]   b            Index of the second candidate.
+     * @return      true if a is dropped before b.
+     **/
+    template <typename T>
+    bool IsLowerRanked(const BasicDetectionPool<T> &detections, int a, int b) const;
+
+    /**
+     * @brief       Turn the full detection pool order into a min-heap of
+     *              candidates, lowest ranked first.
+     * @param[in]   detections   Detection pool.
+     **/
+    template <typename T>
+    void MakeTopNHeap(BasicDetectionPool<T> &detections);
+
+    /**
+     * @brief       Insert a detection with the given objectness in the top N
+     *              heap by recycling the slot of the lowest ranked candidate.
+     * @param[in]   detections   Detection pool.
+     * @param[in]   objectness   Objectness of the detection to be inserted.
+     * @param[in]   key          Tie-break key of the detection, greater than
+     *                           the keys of all candidates in the heap.
+     * @return      Index of the slot to fill, or -1 if the detection is dropped.
+     **/
+    template <typename T>
+    int InsertTopNDetections(BasicDetectionPool<T> &detections, T objectness, int key);
+
+    /**
+     * @brief       Get the pool slot of a candidate passing the threshold,
+     *              appending while fewer than topN are held and recycling the
+     *              lowest ranked one after.
+     * @param[in]   detections   Detection pool.
+     * @param[in]   objectness   Objectness of the candidate.
+     * @param[in]   topN         Candidates to keep.
+     * @param[in,out] num        Candidates seen so far this frame.
+     * @return      Index of the slot to fill, or -1 if the candidate is dropped.
+     **/
+    template <typename T>
+    int AcquireDetection(BasicDetectionPool<T> &detections, T objectness, int topN, int &num);
+
+    /**
+     * @brief       Leave the pool order as NMS expects it to break score ties.
+     * @param[in]   detections   Detection pool.
+     * @param[in]   topN         Candidates kept.
+     * @param[in]   num          Candidates seen this frame.
+     **/
+    template <typename T>
+    void FinishDetections(BasicDetectionPool<T> &detections, int topN, int num);
 
     /**
      * @brief        Given a Network calculate the detection boxes.
+     * @tparam       Head          Output head layout, DynamicHeadConfig to
+     *                             read it from net.
      * @param[in]    net           Network.
+     * @param[in]    outputs       Output data of each branch.
      * @param[in]    imageWidth    Original image width.
      * @param[in]    imageHeight   Original image height.
      * @param[in]    threshold     Detections threshold.
      * @param[out]   detections    Detection boxes.
      **/
-    void GetNetworkBoxes(Network &net,
+    template <typename Head>
+    void GetNetworkBoxes(const Network &net,
+                         const BranchOutputs &outputs,
                          int imageWidth,
                          int imageHeight,
                          float threshold,
-                         std::forward_list<image::Detection> &detections);
+                         DetectionPool &detections);
+
+    /**
+     * @brief        Fixed-point GetNetworkBoxes: boxes in Q8 source image
+     *               pixels, scores in Q31 against m_thresholdQ31.
+     * @tparam       Head          Output head layout, DynamicHeadConfig to
+     *                             read it from net.
+     * @param[in]    net           Network, every branch with a table.
+     * @param[in]    outputs       Output data of each branch.
+     * @param[in]    imageWidth    Original image width.
+     * @param[in]    imageHeight   Original image height.
+     * @param[out]   detections    Detection boxes.
+     **/
+    template <typename Head>
+    void GetNetworkBoxesQ(const Network &net,
+                          const BranchOutputs &outputs,
+                          int imageWidth,
+                          int imageHeight,
+                          DetectionPoolQ &detections);
+
+    /**
+     * @brief       Decode, NMS and output of RunPostProcessing, from the
+     *              branches as prepared.
+     * @param[in]   imgSrcRows   Number of rows in the orignal input image.
+     * @param[in]   imgSrcCols   Number of columns in the oringal input image.
+     * @param[in]   outputs      Output data of each branch, the tensors' or copies of them.
+     * @param[out]  resultsOut   Vector of detected results.
+     **/
+    void RunPrepared(uint32_t imgSrcRows,
+                     uint32_t imgSrcCols,
+                     const BranchOutputs &outputs,
+                     std::vector<DetectionResult> &resultsOut);
+
+    /**
+     * @brief        Fixed-point decode, NMS and output of RunPostProcessing.
+     * @param[in]    outputs       Output data of each branch.
+     * @param[in]    imageWidth    Original image width.
+     * @param[in]    imageHeight   Original image height.
+     * @param[out]   resultsOut    Vector of detected results.
+     **/
+    void RunFixedPoint(const BranchOutputs &outputs, int imageWidth, int imageHeight, std::vector<DetectionResult> &resultsOut);
 
     /**
      * @brief       Draw on the given image a bounding box starting at (boxX, boxY).
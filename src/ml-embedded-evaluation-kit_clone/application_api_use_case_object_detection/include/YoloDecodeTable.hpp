@@ -0,0 +1,108 @@
+/**************************************************************************//**
+ * @file     YoloDecodeTable.hpp
+ * @version  V1.00
+ * @brief    YOLO output branch dequantization lookup table header file
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef YOLO_DECODE_TABLE_HPP
+#define YOLO_DECODE_TABLE_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/**
+ * @brief   Lookup tables for one YOLO output branch. An int8 output can only
+ *          take 256 values, so sigmoid(dequant(q)) and exp(dequant(q)) * anchor
+ *          are computed once per quantization parameters rather than per cell.
+ *          Entries are computed with the same float expressions as the direct
+ *          decoder, so both give identical results. Fixed-point copies serve
+ *          the fixed-point decoder.
+ */
+class YoloDecodeTable
+{
+public:
+    /**
+     * @brief       (Re)build the tables.
+     * @param[in]   scale       Branch output quantization scale.
+     * @param[in]   zeroPoint   Branch output quantization zero point.
+     * @param[in]   anchor      Branch anchors, width and height per box.
+     * @param[in]   numBox      Number of boxes (anchors) per cell.
+     **/
+    void Build(float scale, int zeroPoint, const float *anchor, int numBox);
+
+    /**
+     * @brief       Check the tables were built for the given parameters.
+     * @param[in]   scale       Branch output quantization scale.
+     * @param[in]   zeroPoint   Branch output quantization zero point.
+     * @param[in]   anchor      Branch anchors, width and height per box.
+     * @param[in]   numBox      Number of boxes (anchors) per cell.
+     * @return      true if the tables match, false if they must be rebuilt.
+     **/
+    bool Matches(float scale, int zeroPoint, const float *anchor, int numBox) const;
+
+    /** @brief  Gets sigmoid(dequant(q)). */
+    float Sigmoid(int8_t q) const
+    {
+        return m_sigmoid[q + 128];
+    }
+
+    /** @brief  Gets exp(dequant(q)) * anchor width of the given box. */
+    float ExpAnchorW(int box, int8_t q) const
+    {
+        return m_expAnchor[(box * 2) * 256 + q + 128];
+    }
+
+    /** @brief  Gets exp(dequant(q)) * anchor height of the given box. */
+    float ExpAnchorH(int box, int8_t q) const
+    {
+        return m_expAnchor[(box * 2 + 1) * 256 + q + 128];
+    }
+
+    /** @brief  Gets sigmoid(dequant(q)) in Q31, saturated below 1. */
+    int32_t SigmoidQ31(int8_t q) const
+    {
+        return m_sigmoidQ31[q + 128];
+    }
+
+    /** @brief  Gets exp(dequant(q)) * anchor width of the given box, in Q8. */
+    int32_t ExpAnchorWQ8(int box, int8_t q) const
+    {
+        return m_expAnchorQ8[(box * 2) * 256 + q + 128];
+    }
+
+    /** @brief  Gets exp(dequant(q)) * anchor height of the given box, in Q8. */
+    int32_t ExpAnchorHQ8(int box, int8_t q) const
+    {
+        return m_expAnchorQ8[(box * 2 + 1) * 256 + q + 128];
+    }
+
+    /* Fixed-point box sizes saturate here, 4096 pixels in Q8 */
+    static constexpr int32_t ms_maxSizeQ8 = 1 << 20;
+
+private:
+    bool m_built{false};            /* Tables are valid */
+    float m_scale{0};               /* Quantization scale built for */
+    int m_zeroPoint{0};             /* Quantization zero point built for */
+    const float *m_anchor{nullptr}; /* Anchors built for */
+    int m_numBox{0};                /* Number of boxes built for */
+
+    std::vector<float> m_sigmoid;   /* sigmoid(dequant(q)), indexed by q + 128 */
+    std::vector<float> m_expAnchor; /* exp(dequant(q)) * anchor, 256 per anchor dimension */
+    std::vector<int32_t> m_sigmoidQ31;  /* m_sigmoid in Q31 */
+    std::vector<int32_t> m_expAnchorQ8; /* m_expAnchor in Q8, saturated to ms_maxSizeQ8 */
+};
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* YOLO_DECODE_TABLE_HPP */
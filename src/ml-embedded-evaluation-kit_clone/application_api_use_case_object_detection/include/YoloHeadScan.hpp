@@ -0,0 +1,45 @@
+/**************************************************************************//**
+ * @file     YoloHeadScan.hpp
+ * @version  V1.00
+ * @brief    YOLO output branch scanning kernels header file
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef YOLO_HEAD_SCAN_HPP
+#define YOLO_HEAD_SCAN_HPP
+
+#include <cstdint>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/**
+ * @brief       Collect the boxes whose raw objectness passes a cutoff.
+ * @param[in]   objectness   Objectness of the first box.
+ * @param[in]   count        Number of boxes to scan, at most 65536.
+ * @param[in]   stride       Distance in bytes between consecutive boxes.
+ * @param[in]   cutoff       Boxes with objectness >= cutoff pass.
+ * @param[out]  indices      Indices of the passing boxes, ascending. Must hold
+ *                           count entries.
+ * @return      Number of passing boxes.
+ **/
+int ScanObjectness(const int8_t *objectness, int count, int stride, int8_t cutoff, uint16_t *indices);
+
+/**
+ * @brief       Gets the highest raw class score of a box.
+ * @param[in]   scores       Class scores.
+ * @param[in]   numClasses   Number of class scores.
+ * @return      Highest score, or INT8_MIN if numClasses is 0.
+ **/
+int8_t MaxClassScore(const int8_t *scores, int numClasses);
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
+
+#endif /* YOLO_HEAD_SCAN_HPP */
@@ -0,0 +1,322 @@
+/**************************************************************************//**
+ * @file     BatchedNms.cpp
+ * @version  V1.00
+ * @brief    Batched multi-class non-maximum suppression source code
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "BatchedNms.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+template <typename T>
+BasicBatchedNms<T>::BasicBatchedNms(int capacity, int numClasses)
+    :   m_capacity(capacity > 0 ? capacity : 0),
+        m_numClasses(numClasses > 0 ? numClasses : 0),
+        m_left(m_capacity),
+        m_right(m_capacity),
+        m_top(m_capacity),
+        m_bottom(m_capacity),
+        m_area(m_capacity),
+        m_score(m_capacity),
+        m_rank(m_capacity),
+        m_orderTmp(m_capacity),
+        m_inBucket(m_capacity, 0),
+        m_classStart(m_numClasses + 1),
+        m_buckets(static_cast<size_t>(m_capacity) * m_numClasses)
+{}
+
+template <typename T>
+void BasicBatchedNms<T>::Reserve(int capacity)
+{
+    m_capacity = capacity;
+    m_left.resize(capacity);
+    m_right.resize(capacity);
+    m_top.resize(capacity);
+    m_bottom.resize(capacity);
+    m_area.resize(capacity);
+    m_score.resize(capacity);
+    m_rank.resize(capacity);
+    m_orderTmp.resize(capacity);
+    m_inBucket.resize(capacity, 0);
+    m_buckets.resize(static_cast<size_t>(capacity) * m_numClasses);
+}
+
+template <typename T>
+void BasicBatchedNms<T>::Run(BasicDetectionPool<T> &detections, T iouThreshold, NmsMode mode)
+{
+    if (detections.Capacity() > m_capacity)
+    {
+        Reserve(detections.Capacity());
+    }
+
+    const int count = std::min(detections.Size(), m_capacity);
+    const int classes = std::min(detections.NumClasses(), m_numClasses);
+    const int *order = detections.Order();
+
+    /* Box edges and areas, computed the same way as image::CalculateBoxIOU */
+    for (int n = 0; n < count; ++n)
+    {
+        const auto box = detections.GetBox(n);
+
+        m_left[n] = box.x - box.w / 2;
+        m_right[n] = box.x + box.w / 2;
+        m_top[n] = box.y - box.h / 2;
+        m_bottom[n] = box.y + box.h / 2;
+        m_area[n] = static_cast<Area>(box.w) * box.h;
+        m_rank[order[n]] = n;
+    }
+
+    if (mode == NmsMode::ClassAgnostic)
+    {
+        /* One bucket, keyed by the best class score */
+        uint16_t *bucket = m_buckets.data();
+        int size = 0;
+
+        for (int n = 0; n < count; ++n)
+        {
+            const int idx = order[n];
+            const T *prob = detections.Probs(idx);
+            T best = 0;
+
+            for (int c = 0; c < classes; ++c)
+            {
+                best = std::max(best, prob[c]);
+            }
+
+            if (best > 0)
+            {
+                m_score[idx] = best;
+                bucket[size++] = static_cast<uint16_t>(idx);
+            }
+        }
+
+        SortBucket(bucket, size);
+        SuppressBucket(detections, bucket, size, iouThreshold, -1);
+        PromoteBucket(detections, bucket, size);
+        return;
+    }
+
+    /* Bucket candidates by their non-zero classes */
+    std::fill(m_classStart.begin(), m_classStart.end(), 0);
+
+    for (int n = 0; n < count; ++n)
+    {
+        const T *prob = detections.Probs(n);
+
+        for (int c = 0; c < classes; ++c)
+        {
+            if (prob[c] > 0)
+            {
+                m_classStart[c + 1]++;
+            }
+        }
+    }
+
+    for (int c = 0; c < classes; ++c)
+    {
+        m_classStart[c + 1] += m_classStart[c];
+    }
+
+    /* Fill using m_classStart[c] as cursor, it ends up at the bucket's end */
+    for (int n = 0; n < count; ++n)
+    {
+        const T *prob = detections.Probs(n);
+
+        for (int c = 0; c < classes; ++c)
+        {
+            if (prob[c] > 0)
+            {
+                m_buckets[m_classStart[c]++] = static_cast<uint16_t>(n);
+            }
+        }
+    }
+
+    for (int c = 0; c < classes; ++c)
+    {
+        const int begin = (c == 0) ? 0 : m_classStart[c - 1];
+        const int size = m_classStart[c] - begin;
+
+        /* Empty classes would leave the order untouched */
+        if (size == 0)
+        {
+            continue;
+        }
+
+        uint16_t *bucket = &m_buckets[begin];
+
+        for (int k = 0; k < size; ++k)
+        {
+            m_score[bucket[k]] = detections.Probs(bucket[k])[c];
+        }
+
+        if (mode == NmsMode::PerClassSorted)
+        {
+            SortBucket(bucket, size);
+            SuppressBucket(detections, bucket, size, iouThreshold, c);
+            PromoteBucket(detections, bucket, size);
+        }
+        else if (c == 0)
+        {
+            /* The class 0 sort of the next class pass leaves the survivors
+             * ahead of the suppressed candidates, the last pass has none */
+            SortBucket(bucket, size);
+            SuppressBucket(detections, bucket, size, iouThreshold, c);
+            PromoteBucket(detections, bucket, size, classes > 1);
+        }
+        else
+        {
+            /* The class 0 order holds from here on */
+            SortBucketByRank(bucket, size);
+            SuppressBucket(detections, bucket, size, iouThreshold, c);
+        }
+    }
+}
+
+template <typename T>
+void BasicBatchedNms<T>::SortBucket(uint16_t *bucket, int count)
+{
+    std::sort(bucket, bucket + count, [this](uint16_t a, uint16_t b)
+    {
+        if (m_score[a] != m_score[b])
+        {
+            return m_score[a] > m_score[b];
+        }
+
+        return m_rank[a] < m_rank[b];
+    });
+}
+
+template <typename T>
+void BasicBatchedNms<T>::SortBucketByRank(uint16_t *bucket, int count)
+{
+    std::sort(bucket, bucket + count, [this](uint16_t a, uint16_t b)
+    {
+        return m_rank[a] < m_rank[b];
+    });
+}
+
+template <typename T>
+void BasicBatchedNms<T>::SuppressBucket(BasicDetectionPool<T> &detections, const uint16_t *bucket, int count,
+                                        T iouThreshold, int idxClass)
+{
+    int alive = count;
+
+    for (int a = 0, kept = 0; a < count; ++a)
+    {
+        const int i = bucket[a];
+
+        if (m_score[i] == 0)
+        {
+            continue;
+        }
+
+        /* Nothing left to suppress after this one */
+        if (++kept >= alive)
+        {
+            break;
+        }
+
+        for (int b = a + 1; b < count; ++b)
+        {
+            const int j = bucket[b];
+
+            if (m_score[j] == 0)
+            {
+                continue;
+            }
+
+            bool overlaps = false;
+            T width = std::min(m_right[i], m_right[j]) - std::max(m_left[i], m_left[j]);
+
+            if (width >= 0)
+            {
+                T height = std::min(m_bottom[i], m_bottom[j]) - std::max(m_top[i], m_top[j]);
+
+                if (height >= 0)
+                {
+                    Area intersection = static_cast<Area>(width) * height;
+                    Area boxesUnion = m_area[i] + m_area[j] - intersection;
+
+                    overlaps = NmsOverlap<T>::Exceeds(intersection, boxesUnion, iouThreshold);
+                }
+            }
+
+            if (overlaps)
+            {
+                T *prob = detections.Probs(j);
+
+                if (idxClass < 0)
+                {
+                    std::memset(prob, 0, m_numClasses * sizeof(*prob));
+                }
+                else
+                {
+                    prob[idxClass] = 0;
+                }
+
+                m_score[j] = 0;
+                --alive;
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicBatchedNms<T>::PromoteBucket(BasicDetectionPool<T> &detections, const uint16_t *bucket, int count,
+                                       bool survivorsFirst)
+{
+    const int size = std::min(detections.Size(), m_capacity);
+    int *order = detections.Order();
+    int n = 0;
+
+    for (int k = 0; k < count; ++k)
+    {
+        m_inBucket[bucket[k]] = 1;
+
+        if (!survivorsFirst || m_score[bucket[k]] != 0)
+        {
+            m_orderTmp[n++] = bucket[k];
+        }
+    }
+
+    for (int k = 0; survivorsFirst && k < count; ++k)
+    {
+        if (m_score[bucket[k]] == 0)
+        {
+            m_orderTmp[n++] = bucket[k];
+        }
+    }
+
+    for (int k = 0; k < size; ++k)
+    {
+        if (!m_inBucket[order[k]])
+        {
+            m_orderTmp[n++] = order[k];
+        }
+    }
+
+    for (int k = 0; k < size; ++k)
+    {
+        order[k] = m_orderTmp[k];
+        m_rank[order[k]] = k;
+        m_inBucket[order[k]] = 0;
+    }
+}
+
+/* The float and fixed-point engines */
+template class BasicBatchedNms<float>;
+template class BasicBatchedNms<int32_t>;
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
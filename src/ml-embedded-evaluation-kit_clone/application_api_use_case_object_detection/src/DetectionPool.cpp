@@ -0,0 +1,164 @@
+/**************************************************************************//**
+ * @file     DetectionPool.cpp
+ * @version  V1.00
+ * @brief    Detection candidate pool source code
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "DetectionPool.hpp"
+
+#include <algorithm>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+template <typename T>
+BasicDetectionPool<T>::BasicDetectionPool(int capacity, int numClasses, bool growable)
+    :   m_capacity(std::min(std::max(capacity, 0), ms_maxCapacity)),
+        m_numClasses(numClasses > 0 ? numClasses : 0),
+        m_growable(growable),
+        m_buffer(static_cast<size_t>(m_capacity) * (5 + m_numClasses)),
+        m_order(m_capacity)
+{
+    m_x = m_buffer.data();
+    m_y = m_x + m_capacity;
+    m_w = m_y + m_capacity;
+    m_h = m_w + m_capacity;
+    m_objectness = m_h + m_capacity;
+    m_probs = m_objectness + m_capacity;
+}
+
+template <typename T>
+void BasicDetectionPool<T>::Grow(int capacity)
+{
+    std::vector<T> buffer(static_cast<size_t>(capacity) * (5 + m_numClasses));
+    T *x = buffer.data();
+    T *y = x + capacity;
+    T *w = y + capacity;
+    T *h = w + capacity;
+    T *objectness = h + capacity;
+    T *probs = objectness + capacity;
+
+    std::copy(m_x, m_x + m_size, x);
+    std::copy(m_y, m_y + m_size, y);
+    std::copy(m_w, m_w + m_size, w);
+    std::copy(m_h, m_h + m_size, h);
+    std::copy(m_objectness, m_objectness + m_size, objectness);
+    std::copy(m_probs, m_probs + static_cast<size_t>(m_size) * m_numClasses, probs);
+
+    m_buffer.swap(buffer);
+    m_x = x;
+    m_y = y;
+    m_w = w;
+    m_h = h;
+    m_objectness = objectness;
+    m_probs = probs;
+
+    m_order.resize(capacity);
+    m_capacity = capacity;
+}
+
+template <typename T>
+void BasicDetectionPool<T>::Clear()
+{
+    m_size = 0;
+}
+
+template <typename T>
+int BasicDetectionPool<T>::Size() const
+{
+    return m_size;
+}
+
+template <typename T>
+int BasicDetectionPool<T>::Capacity() const
+{
+    return m_capacity;
+}
+
+template <typename T>
+bool BasicDetectionPool<T>::IsGrowable() const
+{
+    return m_growable;
+}
+
+template <typename T>
+int BasicDetectionPool<T>::NumClasses() const
+{
+    return m_numClasses;
+}
+
+template <typename T>
+int BasicDetectionPool<T>::Append()
+{
+    if (m_size >= m_capacity)
+    {
+        if (!m_growable || m_capacity >= ms_maxCapacity)
+        {
+            return -1;
+        }
+
+        /* Double, as the candidates of a frame are not known up front */
+        Grow(std::min(std::max(m_capacity * 2, 16), ms_maxCapacity));
+    }
+
+    return m_size++;
+}
+
+template <typename T>
+typename BasicDetectionPool<T>::Box BasicDetectionPool<T>::GetBox(int idx) const
+{
+    return Box {m_x[idx], m_y[idx], m_w[idx], m_h[idx]};
+}
+
+template <typename T>
+void BasicDetectionPool<T>::SetBox(int idx, const Box &box)
+{
+    m_x[idx] = box.x;
+    m_y[idx] = box.y;
+    m_w[idx] = box.w;
+    m_h[idx] = box.h;
+}
+
+template <typename T>
+T &BasicDetectionPool<T>::Objectness(int idx)
+{
+    return m_objectness[idx];
+}
+
+template <typename T>
+T BasicDetectionPool<T>::Objectness(int idx) const
+{
+    return m_objectness[idx];
+}
+
+template <typename T>
+T *BasicDetectionPool<T>::Probs(int idx)
+{
+    return m_probs + static_cast<size_t>(idx) * m_numClasses;
+}
+
+template <typename T>
+const T *BasicDetectionPool<T>::Probs(int idx) const
+{
+    return m_probs + static_cast<size_t>(idx) * m_numClasses;
+}
+
+template <typename T>
+int *BasicDetectionPool<T>::Order()
+{
+    return m_order.data();
+}
+
+/* The float and fixed-point pools */
+template class BasicDetectionPool<float>;
+template class BasicDetectionPool<int32_t>;
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,316 @@
+/**************************************************************************//**
+ * @file     DetectionTracker.cpp
+ * @version  V1.00
+ * @brief    Multi-object tracker over detection results
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "DetectionTracker.hpp"
+
+#include <algorithm>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+/* Noise of the filters, in pixels squared: detections jitter by about 4
+ * pixels, objects accelerate by about 1 pixel per frame per frame */
+static constexpr float s_measurementNoise = 16.0f;
+static constexpr float s_positionNoise = 1.0f;
+static constexpr float s_velocityNoise = 1.0f;
+/* Velocity variance of a new track, which has no velocity measured yet */
+static constexpr float s_initialVelocityVariance = 100.0f;
+
+DetectionTracker::DetectionTracker(int maxTracks,
+                                   int maxDetections,
+                                   int frameWidth,
+                                   int frameHeight,
+                                   float iouThreshold,
+                                   int maxMisses,
+                                   int minHits) :
+    m_frameWidth(frameWidth),
+    m_frameHeight(frameHeight),
+    m_iouThreshold(iouThreshold),
+    m_maxMisses(maxMisses),
+    m_minHits(minHits),
+    m_tracks(maxTracks),
+    m_detectionUsed(maxDetections),
+    m_trackUsed(maxTracks)
+{
+    m_matches.reserve(static_cast<size_t>(maxTracks) * maxDetections);
+    m_detections.reserve(maxDetections);
+
+    Reset();
+}
+
+void DetectionTracker::Reset()
+{
+    for (auto &track : m_tracks)
+    {
+        track.active = false;
+    }
+}
+
+void DetectionTracker::InitAxis(Axis &axis, float z, float r)
+{
+    axis.x = z;
+    axis.v = 0;
+    axis.p00 = r;
+    axis.p01 = 0;
+    axis.p11 = s_initialVelocityVariance;
+}
+
+/* x += v, P = F P F' + Q */
+void DetectionTracker::PredictAxis(Axis &axis, float qPos, float qVel)
+{
+    axis.x += axis.v;
+    axis.p00 += 2 * axis.p01 + axis.p11 + qPos;
+    axis.p01 += axis.p11;
+    axis.p11 += qVel;
+}
+
+/* Measurement of the position z with variance r */
+void DetectionTracker::CorrectAxis(Axis &axis, float z, float r)
+{
+    const float innovation = z - axis.x;
+    const float s = axis.p00 + r;
+    const float k0 = axis.p00 / s;
+    const float k1 = axis.p01 / s;
+
+    axis.x += k0 * innovation;
+    axis.v += k1 * innovation;
+
+    axis.p11 -= k1 * axis.p01;
+    axis.p01 -= k0 * axis.p01;
+    axis.p00 -= k0 * axis.p00;
+}
+
+void DetectionTracker::PredictTracks()
+{
+    for (auto &track : m_tracks)
+    {
+        if (!track.active)
+        {
+            continue;
+        }
+
+        for (auto &axis : track.axes)
+        {
+            PredictAxis(axis, s_positionNoise, s_velocityNoise);
+        }
+
+        /* Keep sizes positive however fast they shrink */
+        for (int i = 2; i < 4; ++i)
+        {
+            if (track.axes[i].x < 1.0f)
+            {
+                track.axes[i].x = 1.0f;
+                track.axes[i].v = 0;
+            }
+        }
+
+        const DetectionResult box = ToResult(track);
+
+        if (box.m_w <= 0 || box.m_h <= 0)
+        {
+            track.active = false;
+        }
+    }
+}
+
+float DetectionTracker::Iou(const Track &track, const DetectionResult &detection)
+{
+    const float halfW = track.axes[2].x / 2;
+    const float halfH = track.axes[3].x / 2;
+    const float left = std::max(track.axes[0].x - halfW, static_cast<float>(detection.m_x0));
+    const float right = std::min(track.axes[0].x + halfW, static_cast<float>(detection.m_x0 + detection.m_w));
+    const float top = std::max(track.axes[1].x - halfH, static_cast<float>(detection.m_y0));
+    const float bottom = std::min(track.axes[1].x + halfH, static_cast<float>(detection.m_y0 + detection.m_h));
+
+    if (right <= left || bottom <= top)
+    {
+        return 0;
+    }
+
+    const float intersection = (right - left) * (bottom - top);
+    const float boxesUnion = track.axes[2].x * track.axes[3].x +
+                             static_cast<float>(detection.m_w) * detection.m_h - intersection;
+
+    return (boxesUnion > 0) ? intersection / boxesUnion : 0;
+}
+
+DetectionResult DetectionTracker::ToResult(const Track &track) const
+{
+    float xMin = track.axes[0].x - track.axes[2].x / 2;
+    float xMax = track.axes[0].x + track.axes[2].x / 2;
+    float yMin = track.axes[1].x - track.axes[3].x / 2;
+    float yMax = track.axes[1].x + track.axes[3].x / 2;
+
+    xMin = std::max(xMin, 0.0f);
+    yMin = std::max(yMin, 0.0f);
+    xMax = std::min(xMax, static_cast<float>(m_frameWidth));
+    yMax = std::min(yMax, static_cast<float>(m_frameHeight));
+
+    DetectionResult result(track.score, static_cast<int>(xMin), static_cast<int>(yMin),
+                           static_cast<int>(xMax - xMin), static_cast<int>(yMax - yMin), track.cls);
+    result.m_trackId = track.id;
+
+    return result;
+}
+
+void DetectionTracker::Report(std::vector<DetectionResult> &results) const
+{
+    for (const auto &track : m_tracks)
+    {
+        if (track.active && track.hits >= m_minHits)
+        {
+            results.push_back(ToResult(track));
+        }
+    }
+}
+
+void DetectionTracker::Predict(std::vector<DetectionResult> &results)
+{
+    PredictTracks();
+
+    results.clear();
+    Report(results);
+}
+
+void DetectionTracker::Advance(int numFrames)
+{
+    for (int i = 0; i < numFrames; ++i)
+    {
+        PredictTracks();
+    }
+}
+
+void DetectionTracker::Update(std::vector<DetectionResult> &results)
+{
+    const size_t numDetections = std::min(results.size(), m_detectionUsed.size());
+
+    PredictTracks();
+
+    m_detections.assign(results.begin(), results.begin() + numDetections);
+
+    /* Candidate matches, best overlap first, ties by track then detection */
+    m_matches.clear();
+
+    for (size_t t = 0; t < m_tracks.size(); ++t)
+    {
+        m_trackUsed[t] = 0;
+
+        if (!m_tracks[t].active)
+        {
+            continue;
+        }
+
+        for (size_t d = 0; d < numDetections; ++d)
+        {
+            if (m_detections[d].m_cls != m_tracks[t].cls)
+            {
+                continue;
+            }
+
+            const float iou = Iou(m_tracks[t], m_detections[d]);
+
+            if (iou >= m_iouThreshold)
+            {
+                m_matches.push_back({iou, static_cast<uint16_t>(t), static_cast<uint16_t>(d)});
+            }
+        }
+    }
+
+    std::sort(m_matches.begin(), m_matches.end(), [](const Match &a, const Match &b)
+    {
+        if (a.iou != b.iou)
+        {
+            return a.iou > b.iou;
+        }
+
+        return (a.track != b.track) ? (a.track < b.track) : (a.detection < b.detection);
+    });
+
+    std::fill(m_detectionUsed.begin(), m_detectionUsed.end(), 0);
+
+    for (const auto &match : m_matches)
+    {
+        if (m_trackUsed[match.track] || m_detectionUsed[match.detection])
+        {
+            continue;
+        }
+
+        Track &track = m_tracks[match.track];
+        const DetectionResult &detection = m_detections[match.detection];
+
+        CorrectAxis(track.axes[0], detection.m_x0 + detection.m_w / 2.0f, s_measurementNoise);
+        CorrectAxis(track.axes[1], detection.m_y0 + detection.m_h / 2.0f, s_measurementNoise);
+        CorrectAxis(track.axes[2], static_cast<float>(detection.m_w), s_measurementNoise);
+        CorrectAxis(track.axes[3], static_cast<float>(detection.m_h), s_measurementNoise);
+
+        track.score = detection.m_normalisedVal;
+        track.hits++;
+        track.misses = 0;
+
+        m_trackUsed[match.track] = 1;
+        m_detectionUsed[match.detection] = 1;
+    }
+
+    /* Tracks left unmatched miss, for too long they are lost */
+    for (size_t t = 0; t < m_tracks.size(); ++t)
+    {
+        Track &track = m_tracks[t];
+
+        if (track.active && !m_trackUsed[t] && (++track.misses > m_maxMisses))
+        {
+            track.active = false;
+        }
+    }
+
+    /* Detections left unmatched start tracks, in detection order, while there are free slots */
+    size_t free = 0;
+
+    for (size_t d = 0; d < numDetections; ++d)
+    {
+        if (m_detectionUsed[d])
+        {
+            continue;
+        }
+
+        while (free < m_tracks.size() && m_tracks[free].active)
+        {
+            ++free;
+        }
+
+        if (free == m_tracks.size())
+        {
+            break;
+        }
+
+        Track &track = m_tracks[free];
+        const DetectionResult &detection = m_detections[d];
+
+        InitAxis(track.axes[0], detection.m_x0 + detection.m_w / 2.0f, s_measurementNoise);
+        InitAxis(track.axes[1], detection.m_y0 + detection.m_h / 2.0f, s_measurementNoise);
+        InitAxis(track.axes[2], static_cast<float>(detection.m_w), s_measurementNoise);
+        InitAxis(track.axes[3], static_cast<float>(detection.m_h), s_measurementNoise);
+
+        track.id = m_nextId++;
+        track.cls = detection.m_cls;
+        track.score = detection.m_normalisedVal;
+        track.hits = 1;
+        track.misses = 0;
+        track.active = true;
+    }
+
+    results.clear();
+    Report(results);
+}
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
@@ -17,7 +17,9 @@
 #include "DetectorPostProcessing.hpp"
 #include "PlatformMath.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace arm
 {
@@ -26,17 +28,80 @@ namespace app
 namespace object_detection
 {
 
+/* Threshold in [0, 1] to Q15 */
+static int32_t ThresholdToQ15(float threshold)
+{
+    return static_cast<int32_t>(std::lround(std::min(std::max(threshold, 0.0f), 1.0f) * 32768.0f));
+}
+
+/* Threshold in [0, 1] to Q31, saturated below 1 */
+static int32_t ThresholdToQ31(float threshold)
+{
+    double q = std::min(std::max(threshold, 0.0f), 1.0f) * 2147483648.0;
+    return static_cast<int32_t>(std::min(std::llround(q), 2147483647LL));
+}
+
+/* Map a Q8 coordinate in a letterboxed network input back to the original image */
+static int32_t UnletterboxQ8(int32_t coordQ8, int pad, int imageSize, int contentSize)
+{
+    return static_cast<int32_t>(static_cast<int64_t>(coordQ8 - (pad << 8)) * imageSize / contentSize);
+}
+
 DetectorPostprocessing::DetectorPostprocessing(
     const float threshold,
     const float nms,
     int numClasses,
-    int topN)
+    int topN,
+    DecodeMode decodeMode,
+    int maxDetections,
+    NmsMode nmsMode,
+    ClassMode classMode,
+    const std::vector<int> &classMask,
+    bool growPool)
     :   m_threshold(threshold),
         m_nms(nms),
         m_numClasses(numClasses),
-        m_topN(topN)
+        m_topN(topN),
+        m_decodeMode(decodeMode),
+        m_classMode(classMode),
+        m_classList(GetClassList(numClasses, classMask)),
+        /* Only the pool of the selected decoding path holds any storage */
+        m_pool(decodeMode == DecodeMode::FixedPoint ? 0 : maxDetections, static_cast<int>(m_classList.size()), growPool),
+        m_batchedNms(decodeMode == DecodeMode::FixedPoint ? 0 : maxDetections, static_cast<int>(m_classList.size())),
+        m_poolQ(decodeMode == DecodeMode::FixedPoint ? maxDetections : 0, static_cast<int>(m_classList.size()), growPool),
+        m_batchedNmsQ(decodeMode == DecodeMode::FixedPoint ? maxDetections : 0, static_cast<int>(m_classList.size())),
+        m_thresholdQ31(ThresholdToQ31(threshold)),
+        m_nmsQ15(ThresholdToQ15(nms)),
+        m_nmsMode(nmsMode),
+        m_scanIndices(ms_scanChunk),
+        m_topNKey(std::max(maxDetections, 0))
 {}
 
+void DetectorPostprocessing::SetDecodeTables(YoloDecodeTable *table0, YoloDecodeTable *table1)
+{
+    m_decodeTables[0] = table0;
+    m_decodeTables[1] = table1;
+
+    /* Have InitNetwork pick them up */
+    m_netOutputs[0] = nullptr;
+    m_netOutputs[1] = nullptr;
+}
+
+void DetectorPostprocessing::SetTopN(int topN)
+{
+    m_topN = topN;
+}
+
+void DetectorPostprocessing::SetLetterbox(int padCols, int padRows, int contentCols, int contentRows)
+{
+    const bool letterbox = (contentCols > 0) && (contentRows > 0);
+
+    m_letterboxPad[0] = letterbox ? padCols : 0;
+    m_letterboxPad[1] = letterbox ? padRows : 0;
+    m_letterboxContent[0] = letterbox ? contentCols : 0;
+    m_letterboxContent[1] = letterbox ? contentRows : 0;
+}
+
 void DetectorPostprocessing::RunPostProcessing(
     uint32_t imgNetRows,
     uint32_t imgNetCols,
@@ -47,6 +112,275 @@ void DetectorPostprocessing::RunPostProcessing(
     std::vector<DetectionResult> &resultsOut    /* init postprocessing */
 )
 {
+    InitNetwork(imgNetRows, imgNetCols, modelOutput0, modelOutput1);
+
+    RunPrepared(imgSrcRows, imgSrcCols, {m_net.branches[0].modelOutput, m_net.branches[1].modelOutput}, resultsOut);
+}
+
+void DetectorPostprocessing::RunPostProcessing(
+    uint32_t imgSrcRows,
+    uint32_t imgSrcCols,
+    const int8_t *output0,
+    const int8_t *output1,
+    std::vector<DetectionResult> &resultsOut)
+{
+    /* Decode from the copies, with the branches otherwise as InitNetwork built them */
+    RunPrepared(imgSrcRows, imgSrcCols, {output0, output1}, resultsOut);
+}
+
+void DetectorPostprocessing::RunPrepared(uint32_t imgSrcRows,
+                                         uint32_t imgSrcCols,
+                                         const BranchOutputs &outputs,
+                                         std::vector<DetectionResult> &resultsOut)
+{
+    Network &net = m_net;
+    net.topN = m_topN;
+
+    /* Start postprocessing */
+    int originalImageWidth = imgSrcCols;
+    int originalImageHeight = imgSrcRows;
+
+    if (m_decodeMode == DecodeMode::FixedPoint)
+    {
+        RunFixedPoint(outputs, originalImageWidth, originalImageHeight, resultsOut);
+        return;
+    }
+
+    /* A letterboxed input decodes in network input pixels. NMS is unaffected by
+     * the scale and offset back to the original image, applied on output */
+    const bool letterbox = (m_letterboxContent[0] > 0);
+    const int decodeWidth = letterbox ? net.inputWidth : originalImageWidth;
+    const int decodeHeight = letterbox ? net.inputHeight : originalImageHeight;
+
+    m_pool.Clear();
+
+    /* The model's head layout is known at compile time, let the compiler specialize for it */
+    if (m_netIsModelHead)
+    {
+        GetNetworkBoxes<YoloFastestModelConfig>(net, outputs, decodeWidth, decodeHeight, m_threshold, m_pool);
+    }
+    else
+    {
+        GetNetworkBoxes<DynamicHeadConfig>(net, outputs, decodeWidth, decodeHeight, m_threshold, m_pool);
+    }
+
+    /* Do nms */
+    m_batchedNms.Run(m_pool, m_nms, m_nmsMode);
+
+    const int *order = m_pool.Order();
+
+    for (int n = 0; n < m_pool.Size(); ++n)
+    {
+        const int idx = order[n];
+        const DetectionPool::Box bbox = m_pool.GetBox(idx);
+        const float *prob = m_pool.Probs(idx);
+
+        float xMin = bbox.x - bbox.w / 2.0f;
+        float xMax = bbox.x + bbox.w / 2.0f;
+        float yMin = bbox.y - bbox.h / 2.0f;
+        float yMax = bbox.y + bbox.h / 2.0f;
+
+        if (letterbox)
+        {
+            const float scaleX = static_cast<float>(originalImageWidth) / m_letterboxContent[0];
+            const float scaleY = static_cast<float>(originalImageHeight) / m_letterboxContent[1];
+
+            xMin = (xMin - m_letterboxPad[0]) * scaleX;
+            xMax = (xMax - m_letterboxPad[0]) * scaleX;
+            yMin = (yMin - m_letterboxPad[1]) * scaleY;
+            yMax = (yMax - m_letterboxPad[1]) * scaleY;
+        }
+
+        if (xMin < 0)
+        {
+            xMin = 0;
+        }
+
+        if (yMin < 0)
+        {
+            yMin = 0;
+        }
+
+        if (xMax > originalImageWidth)
+        {
+            xMax = originalImageWidth;
+        }
+
+        if (yMax > originalImageHeight)
+        {
+            yMax = originalImageHeight;
+        }
+
+        float boxX = xMin;
+        float boxY = yMin;
+        float boxWidth = xMax - xMin;
+        float boxHeight = yMax - yMin;
+
+        for (size_t j = 0; j < m_classList.size(); ++j)
+        {
+            if (prob[j] > 0)
+            {
+
+                DetectionResult tmpResult = {};
+                tmpResult.m_normalisedVal = prob[j];
+                tmpResult.m_x0 = (int)boxX;
+                tmpResult.m_y0 = (int)boxY;
+                tmpResult.m_w = (int)boxWidth;
+                tmpResult.m_h = (int)boxHeight;
+                tmpResult.m_cls = m_classList[j];
+
+                resultsOut.push_back(tmpResult);
+            }
+        }
+    }
+}
+
+void DetectorPostprocessing::RunFixedPoint(const BranchOutputs &outputs, int imageWidth, int imageHeight, std::vector<DetectionResult> &resultsOut)
+{
+    /* As RunPostProcessing, a letterboxed input decodes in network input pixels */
+    const bool letterbox = (m_letterboxContent[0] > 0);
+    const int decodeWidth = letterbox ? m_net.inputWidth : imageWidth;
+    const int decodeHeight = letterbox ? m_net.inputHeight : imageHeight;
+
+    m_poolQ.Clear();
+
+    if (m_netIsModelHead)
+    {
+        GetNetworkBoxesQ<YoloFastestModelConfig>(m_net, outputs, decodeWidth, decodeHeight, m_poolQ);
+    }
+    else
+    {
+        GetNetworkBoxesQ<DynamicHeadConfig>(m_net, outputs, decodeWidth, decodeHeight, m_poolQ);
+    }
+
+    m_batchedNmsQ.Run(m_poolQ, m_nmsQ15, m_nmsMode);
+
+    const int *order = m_poolQ.Order();
+    const int32_t imageWidthQ8 = imageWidth << 8;
+    const int32_t imageHeightQ8 = imageHeight << 8;
+
+    for (int n = 0; n < m_poolQ.Size(); ++n)
+    {
+        const int idx = order[n];
+        const DetectionPoolQ::Box bbox = m_poolQ.GetBox(idx);
+        const int32_t *prob = m_poolQ.Probs(idx);
+
+        /* Box edges in Q8 pixels */
+        int32_t xMin = bbox.x - bbox.w / 2;
+        int32_t xMax = bbox.x + bbox.w / 2;
+        int32_t yMin = bbox.y - bbox.h / 2;
+        int32_t yMax = bbox.y + bbox.h / 2;
+
+        if (letterbox)
+        {
+            xMin = UnletterboxQ8(xMin, m_letterboxPad[0], imageWidth, m_letterboxContent[0]);
+            xMax = UnletterboxQ8(xMax, m_letterboxPad[0], imageWidth, m_letterboxContent[0]);
+            yMin = UnletterboxQ8(yMin, m_letterboxPad[1], imageHeight, m_letterboxContent[1]);
+            yMax = UnletterboxQ8(yMax, m_letterboxPad[1], imageHeight, m_letterboxContent[1]);
+        }
+
+        /* Clipped to the image */
+        xMin = std::max(xMin, 0);
+        xMax = std::min(xMax, imageWidthQ8);
+        yMin = std::max(yMin, 0);
+        yMax = std::min(yMax, imageHeightQ8);
+
+        for (size_t j = 0; j < m_classList.size(); ++j)
+        {
+            if (prob[j] > 0)
+            {
+                DetectionResult tmpResult = {};
+                tmpResult.m_normalisedVal = prob[j] / 2147483648.0;
+                tmpResult.m_x0 = xMin / 256;
+                tmpResult.m_y0 = yMin / 256;
+                tmpResult.m_w = (xMax - xMin) / 256;
+                tmpResult.m_h = (yMax - yMin) / 256;
+                tmpResult.m_cls = m_classList[j];
+
+                resultsOut.push_back(tmpResult);
+            }
+        }
+    }
+}
+
+std::vector<int> DetectorPostprocessing::GetClassList(int numClasses, const std::vector<int> &classMask)
+{
+    std::vector<int> classList;
+
+    if (classMask.empty())
+    {
+        for (int c = 0; c < numClasses; ++c)
+        {
+            classList.push_back(c);
+        }
+
+        return classList;
+    }
+
+    for (int c : classMask)
+    {
+        if (c >= 0 && c < numClasses)
+        {
+            classList.push_back(c);
+        }
+    }
+
+    std::sort(classList.begin(), classList.end());
+    classList.erase(std::unique(classList.begin(), classList.end()), classList.end());
+    return classList;
+}
+
+int8_t DetectorPostprocessing::GetObjectnessCutoff(float threshold, float scale, int zeroPoint)
+{
+    /* Every cell must go through the float compare */
+    if (threshold <= 0.0f || scale <= 0.0f)
+    {
+        return std::numeric_limits<int8_t>::min();
+    }
+
+    /* Sigmoid never exceeds 1, keep only the top code for the float compare */
+    if (threshold >= 1.0f)
+    {
+        return std::numeric_limits<int8_t>::max();
+    }
+
+    /* sigmoid((q - zeroPoint) * scale) > threshold <=> q > zeroPoint + logit(threshold) / scale.
+     * Step one code down so that expf rounding can never reject a passing cell;
+     * cells at or above the cutoff still go through the exact float compare. */
+    float cutoff = std::floor(zeroPoint + std::log(threshold / (1.0f - threshold)) / scale) - 1.0f;
+
+    if (cutoff < std::numeric_limits<int8_t>::min())
+    {
+        return std::numeric_limits<int8_t>::min();
+    }
+
+    if (cutoff > std::numeric_limits<int8_t>::max())
+    {
+        return std::numeric_limits<int8_t>::max();
+    }
+
+    return static_cast<int8_t>(cutoff);
+}
+
+void DetectorPostprocessing::InitNetwork(
+    uint32_t imgNetRows,
+    uint32_t imgNetCols,
+    TfLiteTensor *modelOutput0,
+    TfLiteTensor *modelOutput1)
+{
+    /* Nothing to do unless the model, or its output tensors, changed */
+    if (modelOutput0 == m_netOutputs[0] &&
+        modelOutput1 == m_netOutputs[1] &&
+        modelOutput0->quantization.params == m_netQuantParams[0] &&
+        modelOutput1->quantization.params == m_netQuantParams[1] &&
+        modelOutput0->data.int8 == m_net.branches[0].modelOutput &&
+        modelOutput1->data.int8 == m_net.branches[1].modelOutput &&
+        m_net.inputWidth == static_cast<int>(imgNetCols) &&
+        m_net.inputHeight == static_cast<int>(imgNetRows))
+    {
+        return;
+    }
+
 #if defined (__ICCARM__)
     Network net;
     net.inputWidth = static_cast<int>(imgNetCols);
@@ -57,24 +391,28 @@ void DetectorPostprocessing::RunPostProcessing(
     Branch branches0;
     Branch branches1;
     branches0.resolution = modelOutput0->dims->data[1];
-    branches0.numBox = 3;
+    branches0.numBox = YoloFastestModelConfig::ms_numBoxes;
     branches0.anchor = anchor1;
     branches0.modelOutput = modelOutput0->data.int8;
     branches0.scale = ((TfLiteAffineQuantization *)(modelOutput0->quantization.params))->scale->data[0];
     branches0.zeroPoint = ((TfLiteAffineQuantization *)(modelOutput0->quantization.params))->zero_point->data[0];
     branches0.size = modelOutput0->bytes;
+    branches0.table = m_decodeTables[0];
+    branches0.objCutoff = std::numeric_limits<int8_t>::min();
 
-    net.branches.push_back(branches0);
+    net.branches[0] = branches0;
 
     branches1.resolution = modelOutput1->dims->data[1];
-    branches1.numBox = 3;
+    branches1.numBox = YoloFastestModelConfig::ms_numBoxes;
     branches1.anchor = anchor2;
     branches1.modelOutput = modelOutput1->data.int8;
     branches1.scale = ((TfLiteAffineQuantization *)(modelOutput1->quantization.params))->scale->data[0];
     branches1.zeroPoint = ((TfLiteAffineQuantization *)(modelOutput1->quantization.params))->zero_point->data[0];
     branches1.size = modelOutput1->bytes;
+    branches1.table = m_decodeTables[1];
+    branches1.objCutoff = std::numeric_limits<int8_t>::min();
 
-    net.branches.push_back(branches1);
+    net.branches[1] = branches1;
     net.topN = m_topN;
 #else
     Network net
@@ -85,208 +423,482 @@ void DetectorPostprocessing::RunPostProcessing(
         .branches = {
             Branch {
                 .resolution = modelOutput0->dims->data[1],
-                .numBox = 3,
+                .numBox = YoloFastestModelConfig::ms_numBoxes,
                 .anchor = anchor1,
                 .modelOutput = modelOutput0->data.int8,
                 .scale = ((TfLiteAffineQuantization *)(modelOutput0->quantization.params))->scale->data[0],
                 .zeroPoint = ((TfLiteAffineQuantization *)(modelOutput0->quantization.params))->zero_point->data[0],
-                .size = modelOutput0->bytes
+                .size = modelOutput0->bytes,
+                .table = m_decodeTables[0],
+                .objCutoff = std::numeric_limits<int8_t>::min()     /* Set below, with the table */
             },
             Branch {
                 .resolution = modelOutput1->dims->data[1],
-                .numBox = 3,
+                .numBox = YoloFastestModelConfig::ms_numBoxes,
                 .anchor = anchor2,
                 .modelOutput = modelOutput1->data.int8,
                 .scale = ((TfLiteAffineQuantization *)(modelOutput1->quantization.params))->scale->data[0],
                 .zeroPoint = ((TfLiteAffineQuantization *)(modelOutput1->quantization.params))->zero_point->data[0],
-                .size = modelOutput1->bytes
+                .size = modelOutput1->bytes,
+                .table = m_decodeTables[1],
+                .objCutoff = std::numeric_limits<int8_t>::min()     /* Set below, with the table */
             }
         },
         .topN = m_topN
     };
 #endif
-    /* End init */
 
-    /* Start postprocessing */
-    int originalImageWidth = imgSrcCols;
-    int originalImageHeight = imgSrcRows;
-
-    std::forward_list<image::Detection> detections;
-    GetNetworkBoxes(net, originalImageWidth, originalImageHeight, m_threshold, detections);
-
-    /* Do nms */
-    CalculateNMS(detections, net.numClasses, m_nms);
-
-    for (auto &it : detections)
+    /* Rebuild lookup tables if the model or its quantization has changed */
+    for (size_t i = 0; i < net.branches.size(); ++i)
     {
-        float xMin = it.bbox.x - it.bbox.w / 2.0f;
-        float xMax = it.bbox.x + it.bbox.w / 2.0f;
-        float yMin = it.bbox.y - it.bbox.h / 2.0f;
-        float yMax = it.bbox.y + it.bbox.h / 2.0f;
+        Branch &branch = net.branches[i];
+        YoloDecodeTable *table = m_decodeTables[i];
 
-        if (xMin < 0)
+        /* The fixed-point path decodes through tables only */
+        if (!table && m_decodeMode == DecodeMode::FixedPoint)
         {
-            xMin = 0;
+            table = &m_ownTables[i];
         }
 
-        if (yMin < 0)
+        if (table && !table->Matches(branch.scale, branch.zeroPoint, branch.anchor, branch.numBox))
         {
-            yMin = 0;
+            table->Build(branch.scale, branch.zeroPoint, branch.anchor, branch.numBox);
         }
 
-        if (xMax > originalImageWidth)
-        {
-            xMax = originalImageWidth;
-        }
+        branch.table = table;
 
-        if (yMax > originalImageHeight)
-        {
-            yMax = originalImageHeight;
-        }
+        /* Past Float, reject cells on raw objectness with one integer compare */
+        branch.objCutoff = (m_decodeMode == DecodeMode::Float) ? std::numeric_limits<int8_t>::min() :
+                           GetObjectnessCutoff(m_threshold, branch.scale, branch.zeroPoint);
+    }
 
-        float boxX = xMin;
-        float boxY = yMin;
-        float boxWidth = xMax - xMin;
-        float boxHeight = yMax - yMin;
+    m_net = net;
+    m_netOutputs[0] = modelOutput0;
+    m_netOutputs[1] = modelOutput1;
+    m_netQuantParams[0] = modelOutput0->quantization.params;
+    m_netQuantParams[1] = modelOutput1->quantization.params;
 
-        for (int j = 0; j < net.numClasses; ++j)
-        {
-            if (it.prob[j] > 0)
-            {
+    /* Check the head against the compile-time layout of the model */
+    using Head = YoloFastestModelConfig;
+    m_netIsModelHead = (net.numClasses == Head::ms_numClasses) &&
+                       (static_cast<int>(net.branches.size()) == Head::ms_numBranches);
 
-                DetectionResult tmpResult = {};
-                tmpResult.m_normalisedVal = it.prob[j];
-                tmpResult.m_x0 = (int)boxX;
-                tmpResult.m_y0 = (int)boxY;
-                tmpResult.m_w = (int)boxWidth;
-                tmpResult.m_h = (int)boxHeight;
-                tmpResult.m_cls = j;
+    for (size_t i = 0; m_netIsModelHead && i < net.branches.size(); ++i)
+    {
+        m_netIsModelHead = (net.branches[i].numBox == Head::ms_numBoxes) &&
+                           std::equal(Head::ms_anchors[i], Head::ms_anchors[i] + Head::ms_numBoxes * 2,
+                                      net.branches[i].anchor);
+    }
+}
 
-                resultsOut.push_back(tmpResult);
-            }
-        }
+template <typename T>
+int DetectorPostprocessing::GetTopN(int topN, const BasicDetectionPool<T> &detections)
+{
+    /* A fixed pool keeps the highest objectness candidates once full */
+    if (!detections.IsGrowable() && (topN <= 0 || topN > detections.Capacity()))
+    {
+        return detections.Capacity();
     }
 
-#if defined (__ICCARM__)
-    net.branches.erase(net.branches.begin(), net.branches.end());
-#endif
+    return (topN > 0) ? topN : std::numeric_limits<int>::max();
 }
 
+template <typename T>
+bool DetectorPostprocessing::IsLowerRanked(const BasicDetectionPool<T> &detections, int a, int b) const
+{
+    if (detections.Objectness(a) != detections.Objectness(b))
+    {
+        return detections.Objectness(a) < detections.Objectness(b);
+    }
+
+    return m_topNKey[a] < m_topNKey[b];
+}
 
-void DetectorPostprocessing::InsertTopNDetections(std::forward_list<image::Detection> &detections, image::Detection &det)
+template <typename T>
+void DetectorPostprocessing::MakeTopNHeap(BasicDetectionPool<T> &detections)
 {
-    std::forward_list<image::Detection>::iterator it;
-    std::forward_list<image::Detection>::iterator last_it;
+    int *order = detections.Order();
 
-    for (it = detections.begin(); it != detections.end(); ++it)
+    if (m_topNKey.size() < static_cast<size_t>(detections.Capacity()))
     {
-        if (it->objectness > det.objectness)
-            break;
-
-        last_it = it;
+        m_topNKey.resize(detections.Capacity());
     }
 
-    if (it != detections.begin())
+    /* Among equal objectness, the most recent candidates are dropped first */
+    for (int n = 0; n < detections.Size(); ++n)
     {
-        detections.emplace_after(last_it, det);
-        detections.pop_front();
+        m_topNKey[order[n]] = -order[n];
     }
+
+    std::make_heap(order, order + detections.Size(), [&](int a, int b)
+    {
+        return IsLowerRanked(detections, b, a);
+    });
 }
 
-void DetectorPostprocessing::GetNetworkBoxes(Network &net, int imageWidth, int imageHeight, float threshold, std::forward_list<image::Detection> &detections)
+template <typename T>
+int DetectorPostprocessing::InsertTopNDetections(BasicDetectionPool<T> &detections, T objectness, int key)
 {
-    int numClasses = net.numClasses;
-    int num = 0;
-    auto det_objectness_comparator = [](image::Detection & pa, image::Detection & pb)
+    int *order = detections.Order();
+    auto heapCompare = [&](int a, int b)
     {
-        return pa.objectness < pb.objectness;
+        return IsLowerRanked(detections, b, a);
     };
 
-    for (size_t i = 0; i < net.branches.size(); ++i)
+    if (detections.Objectness(order[0]) > objectness)
     {
+        return -1;
+    }
+
+    /* Recycle the lowest ranked slot, O(log N) */
+    std::pop_heap(order, order + detections.Size(), heapCompare);
+
+    int idx = order[detections.Size() - 1];
+    detections.Objectness(idx) = objectness;
+    m_topNKey[idx] = key;
+
+    std::push_heap(order, order + detections.Size(), heapCompare);
+
+    return idx;
+}
+
+template <typename T>
+int DetectorPostprocessing::AcquireDetection(BasicDetectionPool<T> &detections, T objectness, int topN, int &num)
+{
+    int idx;
+
+    if (num < topN)
+    {
+        idx = detections.Append();
+
+        /* Only past ms_maxCapacity, as topN is within a fixed pool's capacity */
+        if (idx < 0)
+        {
+            return -1;
+        }
+
+        detections.Order()[num] = idx;
+    }
+    else
+    {
+        if (num == topN)
+        {
+            MakeTopNHeap(detections);
+        }
+
+        idx = InsertTopNDetections(detections, objectness, num);
+    }
+
+    num += 1;
+    return idx;
+}
+
+template <typename T>
+void DetectorPostprocessing::FinishDetections(BasicDetectionPool<T> &detections, int topN, int num)
+{
+    int *order = detections.Order();
+
+    /* Leave the order as NMS expects it to break score ties */
+    if (num > topN)
+    {
+        std::sort(order, order + detections.Size(), [&](int a, int b)
+        {
+            return IsLowerRanked(detections, a, b);
+        });
+    }
+    else
+    {
+        std::reverse(order, order + num);
+    }
+}
+
+template <typename Head>
+void DetectorPostprocessing::GetNetworkBoxes(const Network &net, const BranchOutputs &outputs, int imageWidth, int imageHeight, float threshold, DetectionPool &detections)
+{
+    /* Counts known at compile time become constant strides and divisors */
+    const int numClasses = (Head::ms_numClasses > 0) ? Head::ms_numClasses : net.numClasses;
+    const int numBranches = (Head::ms_numBranches > 0) ? Head::ms_numBranches : static_cast<int>(net.branches.size());
+    int num = 0;
+    int topN = GetTopN(net.topN, detections);
+
+    for (int i = 0; i < numBranches; ++i)
+    {
+        const int numBox = (Head::ms_numBoxes > 0) ? Head::ms_numBoxes : net.branches[i].numBox;
+        const float *anchor;
+
+        if constexpr (Head::ms_numBoxes > 0)
+        {
+            anchor = Head::ms_anchors[i];
+        }
+        else
+        {
+            anchor = net.branches[i].anchor;
+        }
+
         int height   = net.branches[i].resolution;
         int width    = net.branches[i].resolution;
-        int channel  = net.branches[i].numBox * (5 + numClasses);
+        int boxSize  = 5 + numClasses;
+        const YoloDecodeTable *table = net.branches[i].table;
+        const int8_t objCutoff = net.branches[i].objCutoff;
 
-        for (int h = 0; h < net.branches[i].resolution; h++)
+        int numBoxes = height * width * numBox;
+
+        for (int base = 0; base < numBoxes; base += ms_scanChunk)
         {
-            for (int w = 0; w < net.branches[i].resolution; w++)
+            int count = std::min(ms_scanChunk, numBoxes - base);
+            int passed = ScanObjectness(outputs[i] + base * boxSize + 4,
+                                        count, boxSize, objCutoff, m_scanIndices.data());
+
+            for (int k = 0; k < passed; k++)
             {
-                for (int anc = 0; anc < net.branches[i].numBox; anc++)
+                int box = base + m_scanIndices[k];
+                int anc = box % numBox;
+                int w   = (box / numBox) % width;
+                int h   = box / numBox / width;
+
+                /* Objectness score */
+                int bbox_obj_offset = box * boxSize + 4;
+
+                float objectness = table ? table->Sigmoid(outputs[i][bbox_obj_offset]) :
+                                   math::MathUtils::SigmoidF32(
+                                       (static_cast<float>(outputs[i][bbox_obj_offset])
+                                        - net.branches[i].zeroPoint
+                                       ) * net.branches[i].scale);
+
+                if (objectness > threshold)
                 {
+                    int idx = AcquireDetection(detections, objectness, topN, num);
+
+                    if (idx < 0)
+                    {
+                        continue;
+                    }
 
-                    /* Objectness score */
-                    int bbox_obj_offset = h * width * channel + w * channel + anc * (numClasses + 5) + 4;
-                    float objectness = math::MathUtils::SigmoidF32(
-                                           (static_cast<float>(net.branches[i].modelOutput[bbox_obj_offset])
-                                            - net.branches[i].zeroPoint
-                                           ) * net.branches[i].scale);
+                    DetectionPool::Box bbox;
+                    detections.Objectness(idx) = objectness;
+                    /* Get bbox prediction data for each anchor, each feature point */
+                    int bbox_x_offset = bbox_obj_offset - 4;
+                    int bbox_y_offset = bbox_x_offset + 1;
+                    int bbox_w_offset = bbox_x_offset + 2;
+                    int bbox_h_offset = bbox_x_offset + 3;
+                    int bbox_scores_offset = bbox_x_offset + 5;
 
-                    if (objectness > threshold)
+                    if (table)
+                    {
+                        /* Eliminate grid sensitivity trick involved in YOLOv4 */
+                        bbox.x = (table->Sigmoid(outputs[i][bbox_x_offset]) + w) / width;
+                        bbox.y = (table->Sigmoid(outputs[i][bbox_y_offset]) + h) / height;
+
+                        bbox.w = table->ExpAnchorW(anc, outputs[i][bbox_w_offset]) / net.inputWidth;
+                        bbox.h = table->ExpAnchorH(anc, outputs[i][bbox_h_offset]) / net.inputHeight;
+                    }
+                    else
                     {
-                        image::Detection det;
-                        det.objectness = objectness;
-                        /* Get bbox prediction data for each anchor, each feature point */
-                        int bbox_x_offset = bbox_obj_offset - 4;
-                        int bbox_y_offset = bbox_x_offset + 1;
-                        int bbox_w_offset = bbox_x_offset + 2;
-                        int bbox_h_offset = bbox_x_offset + 3;
-                        int bbox_scores_offset = bbox_x_offset + 5;
-
-                        det.bbox.x = (static_cast<float>(net.branches[i].modelOutput[bbox_x_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
-                        det.bbox.y = (static_cast<float>(net.branches[i].modelOutput[bbox_y_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
-                        det.bbox.w = (static_cast<float>(net.branches[i].modelOutput[bbox_w_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
-                        det.bbox.h = (static_cast<float>(net.branches[i].modelOutput[bbox_h_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
+                        bbox.x = (static_cast<float>(outputs[i][bbox_x_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
+                        bbox.y = (static_cast<float>(outputs[i][bbox_y_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
+                        bbox.w = (static_cast<float>(outputs[i][bbox_w_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
+                        bbox.h = (static_cast<float>(outputs[i][bbox_h_offset]) - net.branches[i].zeroPoint) * net.branches[i].scale;
 
                         float bbox_x, bbox_y;
 
                         /* Eliminate grid sensitivity trick involved in YOLOv4 */
-                        bbox_x = math::MathUtils::SigmoidF32(det.bbox.x);
-                        bbox_y = math::MathUtils::SigmoidF32(det.bbox.y);
-                        det.bbox.x = (bbox_x + w) / width;
-                        det.bbox.y = (bbox_y + h) / height;
+                        bbox_x = math::MathUtils::SigmoidF32(bbox.x);
+                        bbox_y = math::MathUtils::SigmoidF32(bbox.y);
+                        bbox.x = (bbox_x + w) / width;
+                        bbox.y = (bbox_y + h) / height;
 
-                        det.bbox.w = std::exp(det.bbox.w) * net.branches[i].anchor[anc * 2] / net.inputWidth;
-                        det.bbox.h = std::exp(det.bbox.h) * net.branches[i].anchor[anc * 2 + 1] / net.inputHeight;
+                        bbox.w = std::exp(bbox.w) * anchor[anc * 2] / net.inputWidth;
+                        bbox.h = std::exp(bbox.h) * anchor[anc * 2 + 1] / net.inputHeight;
+                    }
+
+                    float *prob = detections.Probs(idx);
+
+                    const int8_t *scores = outputs[i] + bbox_scores_offset;
+                    const int numKept = static_cast<int>(m_classList.size());
+                    int8_t maxScore;
+
+                    /* Every class score is below the best one, skip them all if it fails */
+                    if (numKept == numClasses)
+                    {
+                        maxScore = MaxClassScore(scores, numClasses);
+                    }
+                    else
+                    {
+                        maxScore = std::numeric_limits<int8_t>::min();
 
-                        for (int s = 0; s < numClasses; s++)
+                        for (int j = 0; j < numKept; j++)
                         {
-                            float sig = math::MathUtils::SigmoidF32(
-                                            (static_cast<float>(net.branches[i].modelOutput[bbox_scores_offset + s]) -
-                                             net.branches[i].zeroPoint) * net.branches[i].scale
-                                        ) * objectness;
-                            det.prob.emplace_back((sig > threshold) ? sig : 0);
+                            maxScore = std::max(maxScore, scores[m_classList[j]]);
                         }
+                    }
+
+                    float maxSig = (table ? table->Sigmoid(maxScore) :
+                                    math::MathUtils::SigmoidF32(
+                                        (static_cast<float>(maxScore) -
+                                         net.branches[i].zeroPoint) * net.branches[i].scale)
+                                   ) * objectness;
 
-                        /* Correct_YOLO_boxes */
-                        det.bbox.x *= imageWidth;
-                        det.bbox.w *= imageWidth;
-                        det.bbox.y *= imageHeight;
-                        det.bbox.h *= imageHeight;
+                    if (maxSig <= threshold)
+                    {
+                        std::fill(prob, prob + numKept, 0.0f);
+                    }
+                    else if (m_classMode == ClassMode::BestClass)
+                    {
+                        std::fill(prob, prob + numKept, 0.0f);
 
-                        if (num < net.topN || net.topN <= 0)
+                        /* First class with the best score, as argmax would pick */
+                        for (int j = 0; j < numKept; j++)
                         {
-                            detections.emplace_front(det);
-                            num += 1;
+                            if (scores[m_classList[j]] == maxScore)
+                            {
+                                prob[j] = maxSig;
+                                break;
+                            }
                         }
-                        else if (num == net.topN)
+                    }
+                    else
+                    {
+                        for (int j = 0; j < numKept; j++)
                         {
-                            detections.sort(det_objectness_comparator);
-                            InsertTopNDetections(detections, det);
-                            num += 1;
+                            float sig = (table ? table->Sigmoid(scores[m_classList[j]]) :
+                                         math::MathUtils::SigmoidF32(
+                                             (static_cast<float>(scores[m_classList[j]]) -
+                                              net.branches[i].zeroPoint) * net.branches[i].scale)
+                                        ) * objectness;
+                            prob[j] = (sig > threshold) ? sig : 0;
                         }
-                        else
+                    }
+
+                    /* Correct_YOLO_boxes */
+                    bbox.x *= imageWidth;
+                    bbox.w *= imageWidth;
+                    bbox.y *= imageHeight;
+                    bbox.h *= imageHeight;
+
+                    detections.SetBox(idx, bbox);
+                }
+            }
+        }
+    }
+
+    FinishDetections(detections, topN, num);
+}
+
+template <typename Head>
+void DetectorPostprocessing::GetNetworkBoxesQ(const Network &net, const BranchOutputs &outputs, int imageWidth, int imageHeight, DetectionPoolQ &detections)
+{
+    const int numClasses = (Head::ms_numClasses > 0) ? Head::ms_numClasses : net.numClasses;
+    const int numBranches = (Head::ms_numBranches > 0) ? Head::ms_numBranches : static_cast<int>(net.branches.size());
+    const int numKept = static_cast<int>(m_classList.size());
+    int num = 0;
+    int topN = GetTopN(net.topN, detections);
+
+    for (int i = 0; i < numBranches; ++i)
+    {
+        const Branch &branch = net.branches[i];
+        const int numBox = (Head::ms_numBoxes > 0) ? Head::ms_numBoxes : branch.numBox;
+        const YoloDecodeTable *table = branch.table;
+        int height   = branch.resolution;
+        int width    = branch.resolution;
+        int boxSize  = 5 + numClasses;
+        int numBoxes = height * width * numBox;
+
+        for (int base = 0; base < numBoxes; base += ms_scanChunk)
+        {
+            int count = std::min(ms_scanChunk, numBoxes - base);
+            int passed = ScanObjectness(outputs[i] + base * boxSize + 4,
+                                        count, boxSize, branch.objCutoff, m_scanIndices.data());
+
+            for (int k = 0; k < passed; k++)
+            {
+                int box = base + m_scanIndices[k];
+                int anc = box % numBox;
+                int w   = (box / numBox) % width;
+                int h   = box / numBox / width;
+
+                const int8_t *output = outputs[i] + box * boxSize;
+                int32_t objectness = table->SigmoidQ31(output[4]);
+
+                if (objectness <= m_thresholdQ31)
+                {
+                    continue;
+                }
+
+                int idx = AcquireDetection(detections, objectness, topN, num);
+
+                if (idx < 0)
+                {
+                    continue;
+                }
+
+                detections.Objectness(idx) = objectness;
+
+                /* Centre (sigmoid + cell) / grid and size exp * anchor / input,
+                 * both scaled to the original image in Q8 pixels */
+                DetectionPoolQ::Box bbox;
+                bbox.x = static_cast<int32_t>(static_cast<int64_t>((table->SigmoidQ31(output[0]) >> 16) + (w << 15)) *
+                                              imageWidth / (width << 7));
+                bbox.y = static_cast<int32_t>(static_cast<int64_t>((table->SigmoidQ31(output[1]) >> 16) + (h << 15)) *
+                                              imageHeight / (height << 7));
+                bbox.w = static_cast<int32_t>(std::min<int64_t>(
+                             static_cast<int64_t>(table->ExpAnchorWQ8(anc, output[2])) * imageWidth / net.inputWidth,
+                             YoloDecodeTable::ms_maxSizeQ8));
+                bbox.h = static_cast<int32_t>(std::min<int64_t>(
+                             static_cast<int64_t>(table->ExpAnchorHQ8(anc, output[3])) * imageHeight / net.inputHeight,
+                             YoloDecodeTable::ms_maxSizeQ8));
+
+                detections.SetBox(idx, bbox);
+
+                int32_t *prob = detections.Probs(idx);
+                const int8_t *scores = output + 5;
+                int8_t maxScore;
+
+                if (numKept == numClasses)
+                {
+                    maxScore = MaxClassScore(scores, numClasses);
+                }
+                else
+                {
+                    maxScore = std::numeric_limits<int8_t>::min();
+
+                    for (int j = 0; j < numKept; j++)
+                    {
+                        maxScore = std::max(maxScore, scores[m_classList[j]]);
+                    }
+                }
+
+                int32_t maxProb = static_cast<int32_t>((static_cast<int64_t>(table->SigmoidQ31(maxScore)) * objectness) >> 31);
+
+                if (maxProb <= m_thresholdQ31)
+                {
+                    std::fill(prob, prob + numKept, 0);
+                }
+                else if (m_classMode == ClassMode::BestClass)
+                {
+                    std::fill(prob, prob + numKept, 0);
+
+                    for (int j = 0; j < numKept; j++)
+                    {
+                        if (scores[m_classList[j]] == maxScore)
                         {
-                            InsertTopNDetections(detections, det);
+                            prob[j] = maxProb;
+                            break;
                         }
                     }
                 }
+                else
+                {
+                    for (int j = 0; j < numKept; j++)
+                    {
+                        int32_t p = static_cast<int32_t>((static_cast<int64_t>(table->SigmoidQ31(scores[m_classList[j]])) * objectness) >> 31);
+                        prob[j] = (p > m_thresholdQ31) ? p : 0;
+                    }
+                }
             }
         }
     }
 
-    if (num > net.topN)
-        num -= 1;
+    FinishDetections(detections, topN, num);
 }
 
 } /* namespace object_detection */
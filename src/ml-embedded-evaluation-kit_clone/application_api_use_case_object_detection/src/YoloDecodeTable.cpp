@@ -0,0 +1,72 @@
+/**************************************************************************//**
+ * @file     YoloDecodeTable.cpp
+ * @version  V1.00
+ * @brief    YOLO output branch dequantization lookup table source code
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "YoloDecodeTable.hpp"
+#include "PlatformMath.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+void YoloDecodeTable::Build(float scale, int zeroPoint, const float *anchor, int numBox)
+{
+    m_sigmoid.resize(256);
+    m_expAnchor.resize(static_cast<size_t>(numBox) * 2 * 256);
+    m_sigmoidQ31.resize(256);
+    m_expAnchorQ8.resize(m_expAnchor.size());
+
+    for (int q = -128; q < 128; ++q)
+    {
+        float dequant = (static_cast<float>(q) - zeroPoint) * scale;
+        float expDequant = std::exp(dequant);
+
+        m_sigmoid[q + 128] = math::MathUtils::SigmoidF32(dequant);
+
+        for (int anc = 0; anc < numBox; ++anc)
+        {
+            m_expAnchor[(anc * 2) * 256 + q + 128] = expDequant * anchor[anc * 2];
+            m_expAnchor[(anc * 2 + 1) * 256 + q + 128] = expDequant * anchor[anc * 2 + 1];
+        }
+    }
+
+    for (size_t n = 0; n < m_sigmoid.size(); ++n)
+    {
+        m_sigmoidQ31[n] = static_cast<int32_t>(std::min(std::llround(m_sigmoid[n] * 2147483648.0), 2147483647LL));
+    }
+
+    for (size_t n = 0; n < m_expAnchor.size(); ++n)
+    {
+        m_expAnchorQ8[n] = (m_expAnchor[n] * 256.0f < static_cast<float>(ms_maxSizeQ8)) ?
+                           static_cast<int32_t>(std::lround(m_expAnchor[n] * 256.0f)) : ms_maxSizeQ8;
+    }
+
+    m_scale = scale;
+    m_zeroPoint = zeroPoint;
+    m_anchor = anchor;
+    m_numBox = numBox;
+    m_built = true;
+}
+
+bool YoloDecodeTable::Matches(float scale, int zeroPoint, const float *anchor, int numBox) const
+{
+    return m_built &&
+           m_scale == scale &&
+           m_zeroPoint == zeroPoint &&
+           m_anchor == anchor &&
+           m_numBox == numBox;
+}
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
@@ -0,0 +1,52 @@
+/**************************************************************************//**
+ * @file     YoloHeadScan.cpp
+ * @version  V1.00
+ * @brief    YOLO output branch scanning kernels source code
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "YoloHeadScan.hpp"
+
+#include <limits>
+
+namespace arm
+{
+namespace app
+{
+namespace object_detection
+{
+
+int ScanObjectness(const int8_t *objectness, int count, int stride, int8_t cutoff, uint16_t *indices)
+{
+    int num = 0;
+
+    for (int n = 0; n < count; ++n)
+    {
+        if (objectness[n * stride] >= cutoff)
+        {
+            indices[num++] = static_cast<uint16_t>(n);
+        }
+    }
+
+    return num;
+}
+
+int8_t MaxClassScore(const int8_t *scores, int numClasses)
+{
+    int8_t best = std::numeric_limits<int8_t>::min();
+
+    for (int s = 0; s < numClasses; ++s)
+    {
+        if (scores[s] > best)
+        {
+            best = scores[s];
+        }
+    }
+
+    return best;
+}
+
+} /* namespace object_detection */
+} /* namespace app */
+} /* namespace arm */
@@ -1777,9 +1777,87 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
 void imlib_nvt_RGB888toRGB565_SIMD(image_t *src, image_t *dst);
 void imlib_nvt_RGB565toRGB888_SIMD(image_t *src, image_t *dst);
 void imlib_nvt_scale(image_t *src, image_t *dst, rectangle_t *roi);
+
+//Sampling of imlib_nvt_scale_ex and imlib_nvt_scale_int8
+typedef enum nvt_scale_mode {
+    NVT_SCALE_NEAREST,      //Nearest neighbour, as imlib_nvt_scale
+    NVT_SCALE_AREA,         //Average of the source pixels covered, bilinear when upscaling
+    NVT_SCALE_BILINEAR,     //Bilinear at pixel centres
+} nvt_scale_mode_t;
+
+//RGB565/RGB888 to RGB565/RGB888 for the filtered modes, other formats scale nearest
+void imlib_nvt_scale_ex(image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode);
 void imlib_nvt_vflip(image_t *src, image_t *dst);
 void imlib_nvt_RGB_blend(image_t *src0, image_t *src1, image_t *dst, float alpha);
 
+//Signed int8 value of each RGB565 channel code and of each 8-bit channel value, for quantized model input
+typedef struct rgb565_int8_lut {
+    int8_t r[32];
+    int8_t g[64];
+    int8_t b[32];
+    int8_t v[256];
+} rgb565_int8_lut_t;
+
+void imlib_nvt_RGB565toInt8_lut(rgb565_int8_lut_t *lut, float pixel_scale, float scale, int zero_point);
+void imlib_nvt_scale_int8(image_t *src, image_t *dst, rectangle_t *roi, const rgb565_int8_lut_t *lut, nvt_scale_mode_t mode);
+
+//Largest destination, and widest ROI of the filtered modes, a scale plan handles
+#define NVT_SCALE_PLAN_MAX_WIDTH    640
+#define NVT_SCALE_PLAN_MAX_HEIGHT   480
+
+typedef struct nvt_scale_plan nvt_scale_plan_t;
+
+//Produce destination row y from the ROI of the source
+typedef void (*nvt_scale_row_fn_t)(const nvt_scale_plan_t *plan, const uint8_t *roi, uint32_t y, uint8_t *dst_row);
+
+//Scaling of one source size, ROI, destination size and pixel format pair, resolved once
+//so that each frame only walks the tables. Built by imlib_nvt_scale_plan_init
+struct nvt_scale_plan {
+    uint32_t src_w;
+    uint32_t src_h;
+    uint32_t src_pixfmt;
+    uint32_t src_stride;                //Bytes per source row
+    uint32_t dst_w;
+    uint32_t dst_h;
+    uint32_t dst_pixfmt;
+    uint32_t dst_stride;                //Bytes per destination row
+    rectangle_t roi;
+    rectangle_t dst_rect;               //Part of dst the ROI scales into, all of it unless letterboxed
+    uint8_t pad[4];                     //Destination pixel filling dst around dst_rect
+    nvt_scale_mode_t mode;              //Requested sampling
+    nvt_scale_mode_t sampling;          //Sampling the tables hold, see imlib_nvt_scale_ex for the fallbacks
+    const rgb565_int8_lut_t *lut;       //int8 output through this table, NULL otherwise
+    nvt_scale_row_fn_t row_fn;          //NULL until the plan is built
+    uint16_t col_a[NVT_SCALE_PLAN_MAX_WIDTH];   //Per dst_rect column. Nearest: ROI column. Bilinear: left column.  Area: first column
+    uint16_t col_b[NVT_SCALE_PLAN_MAX_WIDTH];   //Bilinear: right column. Area: column past the last
+    uint16_t col_w[NVT_SCALE_PLAN_MAX_WIDTH];   //Bilinear: right weight, Q7. Area: 1 / columns, Q16
+    uint16_t row_a[NVT_SCALE_PLAN_MAX_HEIGHT];  //Per dst_rect row. Nearest: ROI row. Bilinear: upper row. Area: first row
+    uint16_t row_b[NVT_SCALE_PLAN_MAX_HEIGHT];  //Bilinear: lower row. Area: row past the last
+    uint16_t row_w[NVT_SCALE_PLAN_MAX_HEIGHT];  //Bilinear: lower weight, Q7. Area: 1 / rows, Q16
+};
+
+//Plan scaling roi of src into dst, into int8 RGB through lut if not NULL. Only the sizes and
+//formats of src and dst are used. Returns 0, or -1 if the sizes or the format pair are not supported
+int imlib_nvt_scale_plan_init(nvt_scale_plan_t *plan, image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode, const rgb565_int8_lut_t *lut);
+//As imlib_nvt_scale_plan_init, keeping the aspect ratio of roi: it scales into the centre of dst
+//and mid grey pads the rest. plan->dst_rect tells where it went
+int imlib_nvt_scale_plan_init_letterbox(nvt_scale_plan_t *plan, image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode, const rgb565_int8_lut_t *lut);
+//Scale src into dst as planned. Returns 0, or -1 if the plan is not built or src and dst do not match it
+int imlib_nvt_scale_plan_run(const nvt_scale_plan_t *plan, image_t *src, image_t *dst);
+
+//Convert planar YUV420, as the CCAP planar pipe writes it: dst->w x dst->h Y, then the half width, half height
+//U and V planes. Full range, as imlib_yuv_to_rgb. dst is RGB888, holding int8 RGB through lut if not NULL.
+//Returns 0, or -1 if dst is not RGB888 or not of even size
+int imlib_nvt_YUV420PtoRGB888(const uint8_t *planes, image_t *dst, const rgb565_int8_lut_t *lut);
+//As imlib_nvt_YUV420PtoRGB888, of the roi of width x height planes, e.g. a model input sized tile of a
+//larger frame. roi is the size of dst and starts on even pixels. Returns 0, or -1 if they do not fit
+int imlib_nvt_YUV420PtoRGB888_roi(const uint8_t *planes, uint32_t width, uint32_t height, const rectangle_t *roi,
+                                  image_t *dst, const rgb565_int8_lut_t *lut);
+
+//Count the pixels of two GRAYSCALE images of one size that differ by more than threshold, e.g. to tell
+//whether a scene changed between two frames. Returns the count, or -1 if the images do not match
+int32_t imlib_nvt_count_changed(const image_t *img0, const image_t *img1, uint8_t threshold);
+
 #ifdef __cplusplus
 }
 #endif
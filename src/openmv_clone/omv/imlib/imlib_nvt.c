@@ -7,6 +7,8 @@
  ******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 
 #include "imlib.h"
 #include "common.h"
@@ -992,6 +994,963 @@ void imlib_nvt_scale(image_t *src, image_t *dst, rectangle_t *roi)
 	}
 }
 
+/*
+ * Area-average and bilinear scaling
+ *
+ * Separable fixed-point filter, one destination row at a time: the source rows
+ * under the row are filtered vertically into per-channel column values, then
+ * horizontally into the destination pixels, then stored in the destination
+ * format. Area averages each destination pixel's box of source pixels, exact
+ * for integer ratios, and falls back to bilinear when upscaling. Bilinear
+ * samples pixel centres with Q7 weights.
+ */
+
+//Set to 1 to run the filtered scaler on its scalar reference kernels
+#ifndef NVT_SCALE_FILTER_SW
+#define NVT_SCALE_FILTER_SW	0
+#endif
+
+#define NVT_SCALE_Q7_ONE	128
+
+static uint16_t s_au16VertRow[3][NVT_SCALE_PLAN_MAX_WIDTH];	//Vertically filtered R, G, B of each ROI column
+static uint32_t s_au32PrefixRow[3][NVT_SCALE_PLAN_MAX_WIDTH + 1];	//Area: running sums of s_au16VertRow
+static uint8_t s_au8OutRow[3][NVT_SCALE_PLAN_MAX_WIDTH];	//Filtered R, G, B of each destination pixel
+
+//Q16 reciprocal, kept below 65536 for 16-bit lanes
+static uint16_t Q16Reciprocal(uint32_t u32N)
+{
+	uint32_t u32Recip = (65536 + u32N / 2) / u32N;
+
+	return (u32Recip > 0xFFFF) ? 0xFFFF : (uint16_t)u32Recip;
+}
+
+//Bilinear source position of a destination pixel centre, in Q7
+static void BilinearTap(uint32_t u32Dst, uint32_t u32DstSize, uint32_t u32SrcSize,
+						uint16_t *pu16Pos0, uint16_t *pu16Pos1, uint16_t *pu16Weight)
+{
+	int32_t i32Pos = (int32_t)(((2 * u32Dst + 1) * u32SrcSize * NVT_SCALE_Q7_ONE + u32DstSize) / (2 * u32DstSize)) - NVT_SCALE_Q7_ONE / 2;
+
+	if(i32Pos < 0)
+		i32Pos = 0;
+
+	*pu16Pos0 = (uint16_t)(i32Pos / NVT_SCALE_Q7_ONE);
+	*pu16Weight = (uint16_t)(i32Pos % NVT_SCALE_Q7_ONE);
+
+	if(*pu16Pos0 >= u32SrcSize - 1)
+	{
+		*pu16Pos0 = (uint16_t)(u32SrcSize - 1);
+		*pu16Weight = 0;
+	}
+
+	*pu16Pos1 = ((uint32_t)*pu16Pos0 + 1 < u32SrcSize) ? (*pu16Pos0 + 1) : *pu16Pos0;
+}
+
+/* ---- Scalar reference kernels ---- */
+
+static void LoadRGB_SW(const uint8_t *pu8Row, uint32_t u32Pixfmt, uint32_t x, uint16_t *pu16R, uint16_t *pu16G, uint16_t *pu16B)
+{
+	if(u32Pixfmt == PIXFORMAT_RGB565)
+	{
+		uint16_t u16Pixel = ((const uint16_t *)pu8Row)[x];
+		*pu16R = COLOR_RGB565_TO_R8(u16Pixel);
+		*pu16G = COLOR_RGB565_TO_G8(u16Pixel);
+		*pu16B = COLOR_RGB565_TO_B8(u16Pixel);
+	}
+	else
+	{
+		*pu16R = pu8Row[x * 3];
+		*pu16G = pu8Row[x * 3 + 1];
+		*pu16B = pu8Row[x * 3 + 2];
+	}
+}
+
+//Blend two source rows: (row0 * (1 - w) + row1 * w), w in Q7
+static void VertBilinear_SW(const uint8_t *pu8Row0, const uint8_t *pu8Row1, uint32_t u32Pixfmt, uint32_t u32Width, uint16_t u16Weight)
+{
+	uint16_t u16R0, u16G0, u16B0, u16R1, u16G1, u16B1;
+
+	for(uint32_t x = 0; x < u32Width; x ++)
+	{
+		LoadRGB_SW(pu8Row0, u32Pixfmt, x, &u16R0, &u16G0, &u16B0);
+		LoadRGB_SW(pu8Row1, u32Pixfmt, x, &u16R1, &u16G1, &u16B1);
+		s_au16VertRow[0][x] = (u16R0 * (NVT_SCALE_Q7_ONE - u16Weight) + u16R1 * u16Weight + NVT_SCALE_Q7_ONE / 2) >> 7;
+		s_au16VertRow[1][x] = (u16G0 * (NVT_SCALE_Q7_ONE - u16Weight) + u16G1 * u16Weight + NVT_SCALE_Q7_ONE / 2) >> 7;
+		s_au16VertRow[2][x] = (u16B0 * (NVT_SCALE_Q7_ONE - u16Weight) + u16B1 * u16Weight + NVT_SCALE_Q7_ONE / 2) >> 7;
+	}
+}
+
+//Average u32Rows source rows, u16Recip being 1 / u32Rows in Q16
+static void VertArea_SW(const uint8_t *pu8Row, uint32_t u32Stride, uint32_t u32Rows, uint32_t u32Pixfmt, uint32_t u32Width, uint16_t u16Recip)
+{
+	uint16_t u16R, u16G, u16B;
+
+	for(uint32_t x = 0; x < u32Width; x ++)
+	{
+		uint32_t u32SumR = 0, u32SumG = 0, u32SumB = 0;
+
+		for(uint32_t y = 0; y < u32Rows; y ++)
+		{
+			LoadRGB_SW(pu8Row + y * u32Stride, u32Pixfmt, x, &u16R, &u16G, &u16B);
+			u32SumR += u16R;
+			u32SumG += u16G;
+			u32SumB += u16B;
+		}
+
+		s_au16VertRow[0][x] = (u32SumR * u16Recip + 0x8000) >> 16;
+		s_au16VertRow[1][x] = (u32SumG * u16Recip + 0x8000) >> 16;
+		s_au16VertRow[2][x] = (u32SumB * u16Recip + 0x8000) >> 16;
+	}
+}
+
+static void HorzBilinear_SW(const nvt_scale_plan_t *psPlan)
+{
+	uint32_t u32DstWidth = psPlan->dst_rect.w;
+
+	for(int c = 0; c < 3; c ++)
+	{
+		for(uint32_t x = 0; x < u32DstWidth; x ++)
+		{
+			uint32_t u32Weight = psPlan->col_w[x];
+
+			s_au8OutRow[c][x] = (s_au16VertRow[c][psPlan->col_a[x]] * (NVT_SCALE_Q7_ONE - u32Weight) +
+								 s_au16VertRow[c][psPlan->col_b[x]] * u32Weight + NVT_SCALE_Q7_ONE / 2) >> 7;
+		}
+	}
+}
+
+static void PrefixRow(uint32_t u32Width)
+{
+	for(int c = 0; c < 3; c ++)
+	{
+		uint32_t u32Sum = 0;
+
+		s_au32PrefixRow[c][0] = 0;
+
+		for(uint32_t x = 0; x < u32Width; x ++)
+		{
+			u32Sum += s_au16VertRow[c][x];
+			s_au32PrefixRow[c][x + 1] = u32Sum;
+		}
+	}
+}
+
+static void HorzArea_SW(const nvt_scale_plan_t *psPlan)
+{
+	uint32_t u32DstWidth = psPlan->dst_rect.w;
+
+	for(int c = 0; c < 3; c ++)
+	{
+		for(uint32_t x = 0; x < u32DstWidth; x ++)
+		{
+			uint32_t u32Sum = s_au32PrefixRow[c][psPlan->col_b[x]] - s_au32PrefixRow[c][psPlan->col_a[x]];
+
+			s_au8OutRow[c][x] = (u32Sum * psPlan->col_w[x] + 0x8000) >> 16;
+		}
+	}
+}
+
+static void StoreRow_SW(uint8_t *pu8DstRow, uint32_t u32Pixfmt, uint32_t u32DstWidth, const rgb565_int8_lut_t *psLut)
+{
+	for(uint32_t x = 0; x < u32DstWidth; x ++)
+	{
+		uint8_t u8R = s_au8OutRow[0][x];
+		uint8_t u8G = s_au8OutRow[1][x];
+		uint8_t u8B = s_au8OutRow[2][x];
+
+		if(psLut)
+		{
+			pu8DstRow[x * 3] = (uint8_t)psLut->v[u8R];
+			pu8DstRow[x * 3 + 1] = (uint8_t)psLut->v[u8G];
+			pu8DstRow[x * 3 + 2] = (uint8_t)psLut->v[u8B];
+		}
+		else if(u32Pixfmt == PIXFORMAT_RGB565)
+		{
+			((uint16_t *)pu8DstRow)[x] = COLOR_R8_G8_B8_TO_RGB565(u8R, u8G, u8B);
+		}
+		else
+		{
+			pu8DstRow[x * 3] = u8R;
+			pu8DstRow[x * 3 + 1] = u8G;
+			pu8DstRow[x * 3 + 2] = u8B;
+		}
+	}
+}
+
+/* ---- Helium kernels, same arithmetic as the references ---- */
+
+//Expand 8 RGB565 pixels to R, G, B 16-bit lanes, as COLOR_RGB565_TO_R8/G8/B8
+static inline void ExpandRGB565_16x8_SIMD(uint16x8_t vsrc_16_8, uint16x8_t *pvr, uint16x8_t *pvg, uint16x8_t *pvb)
+{
+	*pvr = vorrq(vandq(vshrq_n_u16(vsrc_16_8, 8), vdupq_n_u16(0xF8)), vshrq_n_u16(vsrc_16_8, 13));
+	*pvg = vorrq(vandq(vshrq_n_u16(vsrc_16_8, 3), vdupq_n_u16(0xFC)), vandq(vshrq_n_u16(vsrc_16_8, 9), vdupq_n_u16(0x03)));
+	*pvb = vorrq(vandq(vshlq_n_u16(vsrc_16_8, 3), vdupq_n_u16(0xF8)), vandq(vshrq_n_u16(vsrc_16_8, 2), vdupq_n_u16(0x07)));
+}
+
+//Load 8 pixels from x as R, G, B 16-bit lanes
+static void LoadRGB_16x8_SIMD(const uint8_t *pu8Row, uint32_t u32Pixfmt, uint32_t x, mve_pred16_t p,
+							  uint16x8_t *pvr, uint16x8_t *pvg, uint16x8_t *pvb)
+{
+	if(u32Pixfmt == PIXFORMAT_RGB565)
+	{
+		ExpandRGB565_16x8_SIMD(vld1q_z_u16((const uint16_t *)pu8Row + x, p), pvr, pvg, pvb);
+	}
+	else
+	{
+		uint16x8_t offset_16_8_rgb = vmulq_n_u16(vidupq_n_u16(0, 1), 3);
+		const uint8_t *pu8Src = pu8Row + x * 3;
+
+		*pvr = vldrbq_gather_offset_z_u16(pu8Src, offset_16_8_rgb, p);
+		*pvg = vldrbq_gather_offset_z_u16(pu8Src + 1, offset_16_8_rgb, p);
+		*pvb = vldrbq_gather_offset_z_u16(pu8Src + 2, offset_16_8_rgb, p);
+	}
+}
+
+static void VertBilinear_SIMD(const uint8_t *pu8Row0, const uint8_t *pu8Row1, uint32_t u32Pixfmt, uint32_t u32Width, uint16_t u16Weight)
+{
+	uint16_t u16InvWeight = NVT_SCALE_Q7_ONE - u16Weight;
+
+	for(uint32_t x = 0; x < u32Width; x += 8)
+	{
+		mve_pred16_t p = vctp16q(u32Width - x);
+		uint16x8_t vr0, vg0, vb0, vr1, vg1, vb1;
+
+		LoadRGB_16x8_SIMD(pu8Row0, u32Pixfmt, x, p, &vr0, &vg0, &vb0);
+		LoadRGB_16x8_SIMD(pu8Row1, u32Pixfmt, x, p, &vr1, &vg1, &vb1);
+
+		vr0 = vshrq_n_u16(vaddq_n_u16(vmlaq_n_u16(vmulq_n_u16(vr0, u16InvWeight), vr1, u16Weight), NVT_SCALE_Q7_ONE / 2), 7);
+		vg0 = vshrq_n_u16(vaddq_n_u16(vmlaq_n_u16(vmulq_n_u16(vg0, u16InvWeight), vg1, u16Weight), NVT_SCALE_Q7_ONE / 2), 7);
+		vb0 = vshrq_n_u16(vaddq_n_u16(vmlaq_n_u16(vmulq_n_u16(vb0, u16InvWeight), vb1, u16Weight), NVT_SCALE_Q7_ONE / 2), 7);
+
+		vst1q_p_u16(&s_au16VertRow[0][x], vr0, p);
+		vst1q_p_u16(&s_au16VertRow[1][x], vg0, p);
+		vst1q_p_u16(&s_au16VertRow[2][x], vb0, p);
+	}
+}
+
+static void VertArea_SIMD(const uint8_t *pu8Row, uint32_t u32Stride, uint32_t u32Rows, uint32_t u32Pixfmt, uint32_t u32Width, uint16_t u16Recip)
+{
+	for(uint32_t x = 0; x < u32Width; x += 8)
+	{
+		mve_pred16_t p = vctp16q(u32Width - x);
+		uint16x8_t vsum_r = vdupq_n_u16(0), vsum_g = vdupq_n_u16(0), vsum_b = vdupq_n_u16(0);
+		uint16x8_t vr, vg, vb;
+
+		for(uint32_t y = 0; y < u32Rows; y ++)
+		{
+			LoadRGB_16x8_SIMD(pu8Row + y * u32Stride, u32Pixfmt, x, p, &vr, &vg, &vb);
+			vsum_r = vaddq_u16(vsum_r, vr);
+			vsum_g = vaddq_u16(vsum_g, vg);
+			vsum_b = vaddq_u16(vsum_b, vb);
+		}
+
+		//(sum * recip + 0x8000) >> 16
+		vst1q_p_u16(&s_au16VertRow[0][x], vrmulhq_u16(vsum_r, vdupq_n_u16(u16Recip)), p);
+		vst1q_p_u16(&s_au16VertRow[1][x], vrmulhq_u16(vsum_g, vdupq_n_u16(u16Recip)), p);
+		vst1q_p_u16(&s_au16VertRow[2][x], vrmulhq_u16(vsum_b, vdupq_n_u16(u16Recip)), p);
+	}
+}
+
+static void HorzBilinear_SIMD(const nvt_scale_plan_t *psPlan)
+{
+	uint32_t u32DstWidth = psPlan->dst_rect.w;
+
+	for(int c = 0; c < 3; c ++)
+	{
+		for(uint32_t x = 0; x < u32DstWidth; x += 8)
+		{
+			mve_pred16_t p = vctp16q(u32DstWidth - x);
+			uint16x8_t vweight = vld1q_z_u16(&psPlan->col_w[x], p);
+			uint16x8_t vleft = vldrhq_gather_shifted_offset_z_u16(s_au16VertRow[c], vld1q_z_u16(&psPlan->col_a[x], p), p);
+			uint16x8_t vright = vldrhq_gather_shifted_offset_z_u16(s_au16VertRow[c], vld1q_z_u16(&psPlan->col_b[x], p), p);
+			uint16x8_t vdst = vmulq_u16(vleft, vsubq_u16(vdupq_n_u16(NVT_SCALE_Q7_ONE), vweight));
+
+			vdst = vshrq_n_u16(vaddq_n_u16(vmlaq_u16(vdst, vright, vweight), NVT_SCALE_Q7_ONE / 2), 7);
+			vstrbq_p_u16(&s_au8OutRow[c][x], vdst, p);
+		}
+	}
+}
+
+static void HorzArea_SIMD(const nvt_scale_plan_t *psPlan)
+{
+	uint32_t u32DstWidth = psPlan->dst_rect.w;
+
+	for(int c = 0; c < 3; c ++)
+	{
+		for(uint32_t x = 0; x < u32DstWidth; x += 4)
+		{
+			mve_pred16_t p = vctp32q(u32DstWidth - x);
+			uint32x4_t vfirst = vldrwq_gather_shifted_offset_z_u32(s_au32PrefixRow[c], vldrhq_z_u32(&psPlan->col_a[x], p), p);
+			uint32x4_t vlast = vldrwq_gather_shifted_offset_z_u32(s_au32PrefixRow[c], vldrhq_z_u32(&psPlan->col_b[x], p), p);
+			uint32x4_t vdst = vmulq_u32(vsubq_u32(vlast, vfirst), vldrhq_z_u32(&psPlan->col_w[x], p));
+
+			vdst = vshrq_n_u32(vaddq_n_u32(vdst, 0x8000), 16);
+			vstrbq_p_u32(&s_au8OutRow[c][x], vdst, p);
+		}
+	}
+}
+
+static void StoreRow_SIMD(uint8_t *pu8DstRow, uint32_t u32Pixfmt, uint32_t u32DstWidth, const rgb565_int8_lut_t *psLut)
+{
+	if(psLut || (u32Pixfmt == PIXFORMAT_RGB888))
+	{
+		uint8x16_t offset_8_16_rgb = vmulq_n_u8(vidupq_n_u8(0, 1), 3);
+
+		for(uint32_t x = 0; x < u32DstWidth; x += 16)
+		{
+			mve_pred16_t p = vctp8q(u32DstWidth - x);
+			uint8x16_t vr = vld1q_z_u8(&s_au8OutRow[0][x], p);
+			uint8x16_t vg = vld1q_z_u8(&s_au8OutRow[1][x], p);
+			uint8x16_t vb = vld1q_z_u8(&s_au8OutRow[2][x], p);
+			uint8_t *pu8Dst = pu8DstRow + x * 3;
+
+			if(psLut)
+			{
+				vr = vreinterpretq_u8_s8(vldrbq_gather_offset_z_s8(psLut->v, vr, p));
+				vg = vreinterpretq_u8_s8(vldrbq_gather_offset_z_s8(psLut->v, vg, p));
+				vb = vreinterpretq_u8_s8(vldrbq_gather_offset_z_s8(psLut->v, vb, p));
+			}
+
+			vstrbq_scatter_offset_p_u8(pu8Dst, offset_8_16_rgb, vr, p);
+			vstrbq_scatter_offset_p_u8(pu8Dst + 1, offset_8_16_rgb, vg, p);
+			vstrbq_scatter_offset_p_u8(pu8Dst + 2, offset_8_16_rgb, vb, p);
+		}
+	}
+	else
+	{
+		for(uint32_t x = 0; x < u32DstWidth; x += 8)
+		{
+			mve_pred16_t p = vctp16q(u32DstWidth - x);
+			uint16x8_t vr = vldrbq_z_u16(&s_au8OutRow[0][x], p);
+			uint16x8_t vg = vldrbq_z_u16(&s_au8OutRow[1][x], p);
+			uint16x8_t vb = vldrbq_z_u16(&s_au8OutRow[2][x], p);
+			uint16x8_t vdst = vshlq_n_u16(vandq(vr, vdupq_n_u16(0xF8)), 8);
+
+			vdst = vorrq(vdst, vshlq_n_u16(vandq(vg, vdupq_n_u16(0xFC)), 3));
+			vdst = vorrq(vdst, vshrq_n_u16(vb, 3));
+			vst1q_p_u16((uint16_t *)pu8DstRow + x, vdst, p);
+		}
+	}
+}
+
+//Resolve a kernel to its scalar reference or Helium variant
+#define NVT_SCALE_KERNEL(name)	(NVT_SCALE_FILTER_SW ? name##_SW : name##_SIMD)
+
+//Filtered destination row y of a plan
+static void ScaleRowBilinear(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NVT_SCALE_KERNEL(VertBilinear)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride), pu8Roi + (psPlan->row_b[y] * psPlan->src_stride),
+								   psPlan->src_pixfmt, psPlan->roi.w, psPlan->row_w[y]);
+	NVT_SCALE_KERNEL(HorzBilinear)(psPlan);
+	NVT_SCALE_KERNEL(StoreRow)(pu8DstRow, psPlan->dst_pixfmt, psPlan->dst_rect.w, psPlan->lut);
+}
+
+static void ScaleRowArea(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NVT_SCALE_KERNEL(VertArea)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride), psPlan->src_stride, psPlan->row_b[y] - psPlan->row_a[y],
+							   psPlan->src_pixfmt, psPlan->roi.w, psPlan->row_w[y]);
+	PrefixRow(psPlan->roi.w);
+	NVT_SCALE_KERNEL(HorzArea)(psPlan);
+	NVT_SCALE_KERNEL(StoreRow)(pu8DstRow, psPlan->dst_pixfmt, psPlan->dst_rect.w, psPlan->lut);
+}
+
+void imlib_nvt_RGB565toInt8_lut(rgb565_int8_lut_t *lut, float pixel_scale, float scale, int zero_point)
+{
+	int i;
+
+	//q = round(value * pixel_scale / scale) + zero_point, value being the RGB888 expansion of each code
+	for(i = 0; i < 64; i ++)
+	{
+		uint16_t u16Pixel;
+		int32_t i32R, i32G, i32B;
+
+		if(i < 32)
+		{
+			u16Pixel = (uint16_t)(i << 11);
+			i32R = (int32_t)roundf(COLOR_RGB565_TO_R8(u16Pixel) * pixel_scale / scale) + zero_point;
+			lut->r[i] = (int8_t)((i32R < -128) ? -128 : ((i32R > 127) ? 127 : i32R));
+
+			u16Pixel = (uint16_t)i;
+			i32B = (int32_t)roundf(COLOR_RGB565_TO_B8(u16Pixel) * pixel_scale / scale) + zero_point;
+			lut->b[i] = (int8_t)((i32B < -128) ? -128 : ((i32B > 127) ? 127 : i32B));
+		}
+
+		u16Pixel = (uint16_t)(i << 5);
+		i32G = (int32_t)roundf(COLOR_RGB565_TO_G8(u16Pixel) * pixel_scale / scale) + zero_point;
+		lut->g[i] = (int8_t)((i32G < -128) ? -128 : ((i32G > 127) ? 127 : i32G));
+	}
+
+	for(i = 0; i < 256; i ++)
+	{
+		int32_t i32V = (int32_t)roundf(i * pixel_scale / scale) + zero_point;
+		lut->v[i] = (int8_t)((i32V < -128) ? -128 : ((i32V > 127) ? 127 : i32V));
+	}
+}
+
+//Convert u32Pixels RGB565 pixels, picked from a source row by au16SrcXPos, to int8 RGB
+static void RGB565toInt8_SIMD(
+	const uint16_t *pu16SrcRow,
+	int8_t *pi8DstData,
+	const uint16_t au16SrcXPos[],
+	uint32_t u32Pixels,
+	const rgb565_int8_lut_t *psLut
+)
+{
+	uint16x8_t offset_16_8_rgb = vmulq_n_u16(vidupq_n_u16(0, 1), 3);
+	int32_t i32Remain = u32Pixels;
+
+	while(i32Remain > 0)
+	{
+		mve_pred16_t p = vctp16q(i32Remain);
+
+		//Load RGB565 data from source row. Using vector gather load
+		uint16x8_t vpos_16_8 = vld1q_z_u16(au16SrcXPos, p);
+		uint16x8_t vsrc_16_8 = vldrhq_gather_shifted_offset_z_u16(pu16SrcRow, vpos_16_8, p);
+
+		//Look up the int8 value of each channel code
+		int16x8_t vdst_16_8_r = vldrbq_gather_offset_z_s16(psLut->r, vshrq_n_u16(vsrc_16_8, 11), p);
+		int16x8_t vdst_16_8_g = vldrbq_gather_offset_z_s16(psLut->g, vandq_u16(vshrq_n_u16(vsrc_16_8, 5), vdupq_n_u16(0x3F)), p);
+		int16x8_t vdst_16_8_b = vldrbq_gather_offset_z_s16(psLut->b, vandq_u16(vsrc_16_8, vdupq_n_u16(0x1F)), p);
+
+		//Store int8 RGB 8 pixel data. Using vector narrowing scatter store
+		vstrbq_scatter_offset_p_s16(pi8DstData, offset_16_8_rgb, vdst_16_8_r, p);
+		vstrbq_scatter_offset_p_s16(pi8DstData + 1, offset_16_8_rgb, vdst_16_8_g, p);
+		vstrbq_scatter_offset_p_s16(pi8DstData + 2, offset_16_8_rgb, vdst_16_8_b, p);
+
+		au16SrcXPos += 8;
+		pi8DstData += 8 * 3;
+		i32Remain -= 8;
+	}
+}
+
+/*
+ * Scale plans
+ *
+ * A plan holds the source column and row of every destination pixel and the
+ * kernel producing a destination row, resolved once for a source size, ROI,
+ * destination size and pixel format pair. Nearest rows gather their pixels
+ * through the column table, and copy the previous destination row when they
+ * sample the same source row.
+ */
+
+//Gather 8 pixels of a source row at the columns pu16Col, as R, G, B 16-bit lanes
+static inline void GatherRGB_16x8_SIMD(const uint8_t *pu8Row, uint32_t u32Pixfmt, const uint16_t *pu16Col, mve_pred16_t p,
+									   uint16x8_t *pvr, uint16x8_t *pvg, uint16x8_t *pvb)
+{
+	uint16x8_t vcol_16_8 = vld1q_z_u16(pu16Col, p);
+
+	if(u32Pixfmt == PIXFORMAT_RGB565)
+	{
+		ExpandRGB565_16x8_SIMD(vldrhq_gather_shifted_offset_z_u16((const uint16_t *)pu8Row, vcol_16_8, p), pvr, pvg, pvb);
+	}
+	else
+	{
+		uint16x8_t offset_16_8_rgb = vmulq_n_u16(vcol_16_8, 3);
+
+		*pvr = vldrbq_gather_offset_z_u16(pu8Row, offset_16_8_rgb, p);
+		*pvg = vldrbq_gather_offset_z_u16(pu8Row + 1, offset_16_8_rgb, p);
+		*pvb = vldrbq_gather_offset_z_u16(pu8Row + 2, offset_16_8_rgb, p);
+	}
+}
+
+//Store 8 pixels of R, G, B 16-bit lanes as RGB565, RGB888, or int8 RGB through psLut
+static inline void StoreRGB_16x8_SIMD(uint8_t *pu8Dst, uint32_t u32Pixfmt, const rgb565_int8_lut_t *psLut, mve_pred16_t p,
+									  uint16x8_t vr, uint16x8_t vg, uint16x8_t vb)
+{
+	if(u32Pixfmt == PIXFORMAT_RGB565)
+	{
+		uint16x8_t vdst = vshlq_n_u16(vandq(vr, vdupq_n_u16(0xF8)), 8);
+
+		vdst = vorrq(vdst, vshlq_n_u16(vandq(vg, vdupq_n_u16(0xFC)), 3));
+		vdst = vorrq(vdst, vshrq_n_u16(vb, 3));
+		vst1q_p_u16((uint16_t *)pu8Dst, vdst, p);
+	}
+	else
+	{
+		uint16x8_t offset_16_8_rgb = vmulq_n_u16(vidupq_n_u16(0, 1), 3);
+
+		if(psLut)
+		{
+			vr = vldrbq_gather_offset_z_u16((const uint8_t *)psLut->v, vr, p);
+			vg = vldrbq_gather_offset_z_u16((const uint8_t *)psLut->v, vg, p);
+			vb = vldrbq_gather_offset_z_u16((const uint8_t *)psLut->v, vb, p);
+		}
+
+		//Using vector narrowing scatter store
+		vstrbq_scatter_offset_p_u16(pu8Dst, offset_16_8_rgb, vr, p);
+		vstrbq_scatter_offset_p_u16(pu8Dst + 1, offset_16_8_rgb, vg, p);
+		vstrbq_scatter_offset_p_u16(pu8Dst + 2, offset_16_8_rgb, vb, p);
+	}
+}
+
+//Nearest RGB row, specialised by the constant formats of the callers below
+static inline void NearestRowRGB_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow,
+									  uint32_t u32SrcPixfmt, uint32_t u32DstPixfmt, const rgb565_int8_lut_t *psLut)
+{
+	const uint8_t *pu8SrcRow = pu8Roi + (psPlan->row_a[y] * psPlan->src_stride);
+	uint32_t u32DstBpp = (u32DstPixfmt == PIXFORMAT_RGB565) ? 2 : 3;
+
+	for(uint32_t x = 0; x < (uint32_t)psPlan->dst_rect.w; x += 8)
+	{
+		mve_pred16_t p = vctp16q(psPlan->dst_rect.w - x);
+		uint16x8_t vr, vg, vb;
+
+		GatherRGB_16x8_SIMD(pu8SrcRow, u32SrcPixfmt, &psPlan->col_a[x], p, &vr, &vg, &vb);
+		StoreRGB_16x8_SIMD(pu8DstRow + (x * u32DstBpp), u32DstPixfmt, psLut, p, vr, vg, vb);
+	}
+}
+
+static void RGB565toRGB565_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	const uint16_t *pu16SrcRow = (const uint16_t *)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride));
+
+	for(uint32_t x = 0; x < (uint32_t)psPlan->dst_rect.w; x += 8)
+	{
+		mve_pred16_t p = vctp16q(psPlan->dst_rect.w - x);
+		uint16x8_t vsrc_16_8 = vldrhq_gather_shifted_offset_z_u16(pu16SrcRow, vld1q_z_u16(&psPlan->col_a[x], p), p);
+
+		vst1q_p_u16((uint16_t *)pu8DstRow + x, vsrc_16_8, p);
+	}
+}
+
+static void RGB565toRGB888_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NearestRowRGB_SIMD(psPlan, pu8Roi, y, pu8DstRow, PIXFORMAT_RGB565, PIXFORMAT_RGB888, NULL);
+}
+
+static void RGB565toInt8_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	RGB565toInt8_SIMD((const uint16_t *)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride)), (int8_t *)pu8DstRow,
+					  psPlan->col_a, psPlan->dst_rect.w, psPlan->lut);
+}
+
+static void RGB888toRGB565_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NearestRowRGB_SIMD(psPlan, pu8Roi, y, pu8DstRow, PIXFORMAT_RGB888, PIXFORMAT_RGB565, NULL);
+}
+
+static void RGB888toRGB888_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NearestRowRGB_SIMD(psPlan, pu8Roi, y, pu8DstRow, PIXFORMAT_RGB888, PIXFORMAT_RGB888, NULL);
+}
+
+static void RGB888toInt8_Row_SIMD(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	NearestRowRGB_SIMD(psPlan, pu8Roi, y, pu8DstRow, PIXFORMAT_RGB888, PIXFORMAT_RGB888, psPlan->lut);
+}
+
+static void RGB565toGRAYSCALE_Row_SW(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	const uint16_t *pu16SrcRow = (const uint16_t *)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride));
+
+	for(uint32_t x = 0; x < (uint32_t)psPlan->dst_rect.w; x ++)
+	{
+		uint16_t u16RGB565Data = pu16SrcRow[psPlan->col_a[x]];
+
+		pu8DstRow[x] = COLOR_RGB565_TO_GRAYSCALE(u16RGB565Data);
+	}
+}
+
+static void GRAYSCALEtoRGB565_Row_SW(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	const uint8_t *pu8SrcRow = pu8Roi + (psPlan->row_a[y] * psPlan->src_stride);
+	uint16_t *pu16DestRow = (uint16_t *)pu8DstRow;
+
+	for(uint32_t x = 0; x < (uint32_t)psPlan->dst_rect.w; x ++)
+	{
+		uint8_t u8Gray = pu8SrcRow[psPlan->col_a[x]];
+
+		pu16DestRow[x] = COLOR_GRAYSCALE_TO_RGB565(u8Gray);
+	}
+}
+
+static void RGB565toYUYV_Row_SW(const nvt_scale_plan_t *psPlan, const uint8_t *pu8Roi, uint32_t y, uint8_t *pu8DstRow)
+{
+	const uint16_t *pu16SrcRow = (const uint16_t *)(pu8Roi + (psPlan->row_a[y] * psPlan->src_stride));
+	int32_t i32U = 0;
+	int32_t i32V = 0;
+
+	for(uint32_t x = 0; x < (uint32_t)psPlan->dst_rect.w; x ++)
+	{
+		uint16_t u16RGB565Data = pu16SrcRow[psPlan->col_a[x]];
+
+		int R = COLOR_RGB565_TO_R8(u16RGB565Data);
+		int G = COLOR_RGB565_TO_G8(u16RGB565Data);
+		int B = COLOR_RGB565_TO_B8(u16RGB565Data);
+
+		pu8DstRow[x * 2] = ((66 * R + 129 * G + 25 * B + 128) >> 8) + 16;
+
+		//U and V of each pixel pair come from its even pixel
+		if(x & 0x1L)
+		{
+			pu8DstRow[x * 2 + 1] = i32V;
+		}
+		else
+		{
+			i32U = ((-38 * R - 74 * G + 112 * B + 128) >> 8) + 128;
+			i32V = ((112 * R - 94 * G - 18 * B + 128) >> 8) + 128;
+			pu8DstRow[x * 2 + 1] = i32U;
+		}
+	}
+}
+
+//Nearest row kernel of a pixel format pair, NULL if the pair is not supported
+static nvt_scale_row_fn_t NearestRowKernel(uint32_t u32SrcPixfmt, uint32_t u32DstPixfmt, const rgb565_int8_lut_t *psLut)
+{
+	if(psLut)
+	{
+		if((u32SrcPixfmt == PIXFORMAT_RGB565) && (u32DstPixfmt == PIXFORMAT_RGB888))
+			return RGB565toInt8_Row_SIMD;
+		else if((u32SrcPixfmt == PIXFORMAT_RGB888) && (u32DstPixfmt == PIXFORMAT_RGB888))
+			return RGB888toInt8_Row_SIMD;
+	}
+	else if((u32SrcPixfmt == PIXFORMAT_RGB888) && (u32DstPixfmt == PIXFORMAT_RGB565))
+		return RGB888toRGB565_Row_SIMD;
+	else if((u32SrcPixfmt == PIXFORMAT_RGB565) && (u32DstPixfmt == PIXFORMAT_RGB888))
+		return RGB565toRGB888_Row_SIMD;
+	else if((u32SrcPixfmt == PIXFORMAT_RGB888) && (u32DstPixfmt == PIXFORMAT_RGB888))
+		return RGB888toRGB888_Row_SIMD;
+	else if((u32SrcPixfmt == PIXFORMAT_RGB565) && (u32DstPixfmt == PIXFORMAT_GRAYSCALE))
+		return RGB565toGRAYSCALE_Row_SW;
+	else if((u32SrcPixfmt == PIXFORMAT_GRAYSCALE) && (u32DstPixfmt == PIXFORMAT_RGB565))
+		return GRAYSCALEtoRGB565_Row_SW;
+	else if((u32SrcPixfmt == PIXFORMAT_RGB565) && (u32DstPixfmt == PIXFORMAT_YUV422))
+		return RGB565toYUYV_Row_SW;
+	else if((u32SrcPixfmt == PIXFORMAT_RGB565) && (u32DstPixfmt == PIXFORMAT_RGB565))
+		return RGB565toRGB565_Row_SIMD;
+
+	return NULL;
+}
+
+//Source position of each destination pixel, stepped by the same DDA as imlib_nvt_scale
+static void NearestTaps(uint16_t au16Pos[], uint32_t u32SrcSize, uint32_t u32DstSize)
+{
+	int32_t i32ScaleOutFac = u32DstSize / gcd(u32SrcSize, u32DstSize);
+	int32_t i32ScaleInFac = u32SrcSize / gcd(u32SrcSize, u32DstSize);
+	uint32_t u32Delta = 0;
+	uint32_t u32RepeatCnt;
+	uint32_t u32Pos = 0;
+
+	for(uint32_t u32Src = 0; (u32Src < u32SrcSize) && (u32Pos < u32DstSize); u32Src ++)
+	{
+		UTIL_DDA(i32ScaleOutFac, i32ScaleInFac, u32Delta, u32RepeatCnt);
+
+		while(u32RepeatCnt && (u32Pos < u32DstSize))
+		{
+			au16Pos[u32Pos ++] = (uint16_t)u32Src;
+			u32RepeatCnt --;
+		}
+	}
+
+	//Pixels the DDA falls short of repeat the last source pixel
+	while(u32Pos < u32DstSize)
+		au16Pos[u32Pos ++] = (uint16_t)(u32SrcSize - 1);
+}
+
+//Destination pixel of mid grey, into int8 RGB through psLut
+static void PaddingPixel(uint32_t u32Pixfmt, const rgb565_int8_lut_t *psLut, uint8_t au8Pad[4])
+{
+	uint16_t u16RGB565Data = COLOR_R8_G8_B8_TO_RGB565(128, 128, 128);
+
+	memset(au8Pad, psLut ? (uint8_t)psLut->v[128] : 128, 4);
+
+	if(u32Pixfmt == PIXFORMAT_RGB565)
+		memcpy(au8Pad, &u16RGB565Data, 2);
+	else if(u32Pixfmt == PIXFORMAT_YUV422)
+		au8Pad[0] = ((66 * 128 + 129 * 128 + 25 * 128 + 128) >> 8) + 16;	//Y as RGB565toYUYV_Row_SW, U and V stay 128
+}
+
+//Fill u32Pixels destination pixels with the plan's padding
+static void FillPadding(const nvt_scale_plan_t *psPlan, uint8_t *pu8Dst, uint32_t u32Bpp, uint32_t u32Pixels)
+{
+	for(uint32_t i = 0; i < u32Pixels; i ++)
+	{
+		memcpy(pu8Dst, psPlan->pad, u32Bpp);
+		pu8Dst += u32Bpp;
+	}
+}
+
+static int ScalePlanInit(nvt_scale_plan_t *plan, image_t *src, image_t *dst, rectangle_t *roi, rectangle_t *psDstRect,
+						 nvt_scale_mode_t mode, const rgb565_int8_lut_t *lut)
+{
+	uint32_t u32RoiW = roi->w;
+	uint32_t u32RoiH = roi->h;
+	uint32_t u32OutW = psDstRect->w;
+	uint32_t u32OutH = psDstRect->h;
+	nvt_scale_mode_t eSampling = mode;
+	nvt_scale_row_fn_t pfnRow;
+
+	plan->row_fn = NULL;
+	plan->src_w = src->w;
+	plan->src_h = src->h;
+	plan->src_pixfmt = src->pixfmt;
+	plan->src_stride = src->w * src->bpp;
+	plan->dst_w = dst->w;
+	plan->dst_h = dst->h;
+	plan->dst_pixfmt = dst->pixfmt;
+	plan->dst_stride = dst->w * dst->bpp;
+	plan->roi = *roi;
+	plan->dst_rect = *psDstRect;
+	plan->mode = mode;
+	plan->lut = lut;
+	PaddingPixel(dst->pixfmt, lut, plan->pad);
+
+	if((roi->x < 0) || (roi->y < 0) || (roi->w <= 0) || (roi->h <= 0) ||
+	   ((roi->x + u32RoiW) > src->w) || ((roi->y + u32RoiH) > src->h))
+		return -1;
+
+	if((dst->w > NVT_SCALE_PLAN_MAX_WIDTH) || (dst->h > NVT_SCALE_PLAN_MAX_HEIGHT))
+		return -1;
+
+	if((psDstRect->x < 0) || (psDstRect->y < 0) || (psDstRect->w <= 0) || (psDstRect->h <= 0) ||
+	   ((psDstRect->x + u32OutW) > dst->w) || ((psDstRect->y + u32OutH) > dst->h))
+		return -1;
+
+	//Gathers use 16-bit byte offsets into a source row
+	if((u32RoiW * src->bpp) > 0x10000)
+		return -1;
+
+	//Filtered sampling reads RGB565/RGB888 into RGB565/RGB888 or int8 RGB, other pairs sample nearest
+	if(((src->pixfmt != PIXFORMAT_RGB565) && (src->pixfmt != PIXFORMAT_RGB888)) ||
+	   ((dst->pixfmt != PIXFORMAT_RGB565) && (dst->pixfmt != PIXFORMAT_RGB888)) ||
+	   (u32RoiW > NVT_SCALE_PLAN_MAX_WIDTH))
+		eSampling = NVT_SCALE_NEAREST;
+
+	//Area averaging only shrinks; 257 rows at most keep the 16-bit column sums
+	if((eSampling == NVT_SCALE_AREA) && ((u32OutW > u32RoiW) || (u32OutH > u32RoiH) || (u32RoiH / u32OutH >= 257)))
+		eSampling = NVT_SCALE_BILINEAR;
+
+	if(lut && (dst->pixfmt != PIXFORMAT_RGB888))
+		return -1;
+
+	if(eSampling == NVT_SCALE_NEAREST)
+	{
+		pfnRow = NearestRowKernel(src->pixfmt, dst->pixfmt, lut);
+
+		if(pfnRow == NULL)
+			return -1;
+
+		NearestTaps(plan->col_a, u32RoiW, u32OutW);
+		NearestTaps(plan->row_a, u32RoiH, u32OutH);
+	}
+	else if(eSampling == NVT_SCALE_AREA)
+	{
+		for(uint32_t x = 0; x < u32OutW; x ++)
+		{
+			plan->col_a[x] = (uint16_t)((x * u32RoiW) / u32OutW);
+			plan->col_b[x] = (uint16_t)(((x + 1) * u32RoiW) / u32OutW);
+			plan->col_w[x] = Q16Reciprocal(plan->col_b[x] - plan->col_a[x]);
+		}
+
+		for(uint32_t y = 0; y < u32OutH; y ++)
+		{
+			plan->row_a[y] = (uint16_t)((y * u32RoiH) / u32OutH);
+			plan->row_b[y] = (uint16_t)(((y + 1) * u32RoiH) / u32OutH);
+			plan->row_w[y] = Q16Reciprocal(plan->row_b[y] - plan->row_a[y]);
+		}
+
+		pfnRow = ScaleRowArea;
+	}
+	else
+	{
+		for(uint32_t x = 0; x < u32OutW; x ++)
+			BilinearTap(x, u32OutW, u32RoiW, &plan->col_a[x], &plan->col_b[x], &plan->col_w[x]);
+
+		for(uint32_t y = 0; y < u32OutH; y ++)
+			BilinearTap(y, u32OutH, u32RoiH, &plan->row_a[y], &plan->row_b[y], &plan->row_w[y]);
+
+		pfnRow = ScaleRowBilinear;
+	}
+
+	plan->sampling = eSampling;
+	plan->row_fn = pfnRow;
+	return 0;
+}
+
+int imlib_nvt_scale_plan_init(nvt_scale_plan_t *plan, image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode, const rgb565_int8_lut_t *lut)
+{
+	rectangle_t sDstRect;
+
+	sDstRect.x = 0;
+	sDstRect.y = 0;
+	sDstRect.w = dst->w;
+	sDstRect.h = dst->h;
+
+	return ScalePlanInit(plan, src, dst, roi, &sDstRect, mode, lut);
+}
+
+int imlib_nvt_scale_plan_init_letterbox(nvt_scale_plan_t *plan, image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode, const rgb565_int8_lut_t *lut)
+{
+	rectangle_t sDstRect;
+
+	if((roi->w <= 0) || (roi->h <= 0))
+	{
+		plan->row_fn = NULL;
+		return -1;
+	}
+
+	//The side limiting the scale fills dst, the other one rounds to the nearest pixel
+	if((dst->w * roi->h) <= (dst->h * roi->w))
+	{
+		sDstRect.w = dst->w;
+		sDstRect.h = (dst->w * roi->h + roi->w / 2) / roi->w;
+	}
+	else
+	{
+		sDstRect.w = (dst->h * roi->w + roi->h / 2) / roi->h;
+		sDstRect.h = dst->h;
+	}
+
+	sDstRect.x = (dst->w - sDstRect.w) / 2;
+	sDstRect.y = (dst->h - sDstRect.h) / 2;
+
+	return ScalePlanInit(plan, src, dst, roi, &sDstRect, mode, lut);
+}
+
+int imlib_nvt_scale_plan_run(const nvt_scale_plan_t *plan, image_t *src, image_t *dst)
+{
+	const uint8_t *pu8Roi;
+	uint8_t *pu8DstRow;
+	uint32_t u32Bpp = dst->bpp;
+	uint32_t u32RectX = plan->dst_rect.x;
+	uint32_t u32RectY = plan->dst_rect.y;
+	uint32_t u32RectW = plan->dst_rect.w;
+	uint32_t u32RectH = plan->dst_rect.h;
+	uint32_t u32RightPad = plan->dst_w - u32RectX - u32RectW;
+
+	if(plan->row_fn == NULL)
+		return -1;
+
+	if((src->w != plan->src_w) || (src->h != plan->src_h) || (src->pixfmt != plan->src_pixfmt) ||
+	   (dst->w != plan->dst_w) || (dst->h != plan->dst_h) || (dst->pixfmt != plan->dst_pixfmt))
+		return -1;
+
+	pu8Roi = src->data + (plan->roi.y * plan->src_stride) + (plan->roi.x * src->bpp);
+	pu8DstRow = dst->data;
+
+	for(uint32_t y = 0; y < plan->dst_h; y ++)
+	{
+		uint8_t *pu8Out = pu8DstRow + (u32RectX * u32Bpp);
+		uint32_t u32OutY = y - u32RectY;
+
+		if((y < u32RectY) || (u32OutY >= u32RectH))
+		{
+			FillPadding(plan, pu8DstRow, u32Bpp, plan->dst_w);
+		}
+		else
+		{
+			FillPadding(plan, pu8DstRow, u32Bpp, u32RectX);
+			FillPadding(plan, pu8Out + (u32RectW * u32Bpp), u32Bpp, u32RightPad);
+
+			//Upscaled nearest rows repeat the previous one
+			if((plan->sampling == NVT_SCALE_NEAREST) && (u32OutY > 0) && (plan->row_a[u32OutY] == plan->row_a[u32OutY - 1]))
+				memcpy(pu8Out, pu8Out - plan->dst_stride, u32RectW * u32Bpp);
+			else
+				plan->row_fn(plan, pu8Roi, u32OutY, pu8Out);
+		}
+
+		pu8DstRow += plan->dst_stride;
+	}
+
+	return 0;
+}
+
+//Plan of the latest imlib_nvt_scale_ex or imlib_nvt_scale_int8 call, rebuilt when the call changes
+static nvt_scale_plan_t s_sScalePlan;
+
+static int ScaleCached(image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t eMode, const rgb565_int8_lut_t *psLut)
+{
+	if((s_sScalePlan.mode == eMode) && (s_sScalePlan.lut == psLut) &&
+	   (s_sScalePlan.roi.x == roi->x) && (s_sScalePlan.roi.y == roi->y) &&
+	   (s_sScalePlan.roi.w == roi->w) && (s_sScalePlan.roi.h == roi->h) &&
+	   (imlib_nvt_scale_plan_run(&s_sScalePlan, src, dst) == 0))
+		return 0;
+
+	if(imlib_nvt_scale_plan_init(&s_sScalePlan, src, dst, roi, eMode, psLut) != 0)
+		return -1;
+
+	return imlib_nvt_scale_plan_run(&s_sScalePlan, src, dst);
+}
+
+void imlib_nvt_scale_ex(image_t *src, image_t *dst, rectangle_t *roi, nvt_scale_mode_t mode)
+{
+	if(ScaleCached(src, dst, roi, mode, NULL) != 0)
+		imlib_nvt_scale(src, dst, roi);
+}
+
+//Scale RGB565 into int8 RGB, converting and quantizing in the same pass.
+//dst is PIXFORMAT_RGB888 holding int8 data, e.g. a model input tensor. Nearest sampling matches imlib_nvt_scale.
+void imlib_nvt_scale_int8(image_t *src, image_t *dst, rectangle_t *roi, const rgb565_int8_lut_t *lut, nvt_scale_mode_t mode)
+{
+	if((src->pixfmt != PIXFORMAT_RGB565) || (dst->pixfmt != PIXFORMAT_RGB888))
+		return;
+
+	ScaleCached(src, dst, roi, mode, lut);
+}
+
+//Clamp 16-bit lanes to a channel value
+static inline uint16x8_t ClampU8_16x8_SIMD(int16x8_t v)
+{
+	return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(v, vdupq_n_s16(0)), vdupq_n_s16(255)));
+}
+
+int imlib_nvt_YUV420PtoRGB888_roi(const uint8_t *planes, uint32_t width, uint32_t height, const rectangle_t *roi,
+								  image_t *dst, const rgb565_int8_lut_t *lut)
+{
+	uint32_t u32Width = dst->w;
+	uint32_t u32Height = dst->h;
+	const uint8_t *pu8UPlane = planes + (width * height);
+	const uint8_t *pu8VPlane = pu8UPlane + ((width / 2) * (height / 2));
+	uint16x8_t offset_16_8_uv = vshrq_n_u16(vidupq_n_u16(0, 1), 1);
+
+	if((dst->pixfmt != PIXFORMAT_RGB888) || (u32Width & 0x1) || (u32Height & 0x1) || (width & 0x1) || (height & 0x1))
+		return -1;
+
+	//Chroma is shared by 2x2 pixels, so the roi starts on even pixels
+	if((roi->x < 0) || (roi->y < 0) || (roi->x & 0x1) || (roi->y & 0x1) ||
+	   ((uint32_t)roi->w != u32Width) || ((uint32_t)roi->h != u32Height) ||
+	   ((uint32_t)(roi->x + roi->w) > width) || ((uint32_t)(roi->y + roi->h) > height))
+		return -1;
+
+	for(uint32_t y = 0; y < u32Height; y ++)
+	{
+		uint32_t u32SrcY = roi->y + y;
+		const uint8_t *pu8YRow = planes + (u32SrcY * width) + roi->x;
+		const uint8_t *pu8URow = pu8UPlane + ((u32SrcY / 2) * (width / 2)) + (roi->x / 2);
+		const uint8_t *pu8VRow = pu8VPlane + ((u32SrcY / 2) * (width / 2)) + (roi->x / 2);
+		uint8_t *pu8DstRow = dst->data + (y * u32Width * 3);
+
+		for(uint32_t x = 0; x < u32Width; x += 8)
+		{
+			mve_pred16_t p = vctp16q(u32Width - x);
+			int16x8_t vy = vreinterpretq_s16_u16(vldrbq_z_u16(pu8YRow + x, p));
+			int16x8_t vu = vsubq_n_s16(vreinterpretq_s16_u16(vldrbq_gather_offset_z_u16(pu8URow + (x / 2), offset_16_8_uv, p)), 128);
+			int16x8_t vv = vsubq_n_s16(vreinterpretq_s16_u16(vldrbq_gather_offset_z_u16(pu8VRow + (x / 2), offset_16_8_uv, p)), 128);
+
+			//R = Y + 1.402V, G = Y - 0.344U - 0.714V, B = Y + 1.772U, the fractions in Q15
+			int16x8_t vr = vaddq_s16(vaddq_s16(vy, vv), vqrdmulhq_n_s16(vv, 13173));
+			int16x8_t vg = vsubq_s16(vy, vaddq_s16(vqrdmulhq_n_s16(vu, 11277), vqrdmulhq_n_s16(vv, 23401)));
+			int16x8_t vb = vaddq_s16(vaddq_s16(vy, vu), vqrdmulhq_n_s16(vu, 25297));
+
+			StoreRGB_16x8_SIMD(pu8DstRow + (x * 3), PIXFORMAT_RGB888, lut, p,
+							   ClampU8_16x8_SIMD(vr), ClampU8_16x8_SIMD(vg), ClampU8_16x8_SIMD(vb));
+		}
+	}
+
+	return 0;
+}
+
+int imlib_nvt_YUV420PtoRGB888(const uint8_t *planes, image_t *dst, const rgb565_int8_lut_t *lut)
+{
+	rectangle_t roi;
+
+	roi.x = 0;
+	roi.y = 0;
+	roi.w = dst->w;
+	roi.h = dst->h;
+
+	return imlib_nvt_YUV420PtoRGB888_roi(planes, dst->w, dst->h, &roi, dst, lut);
+}
+
 void imlib_nvt_vflip(image_t *src, image_t *dst)
 {
 	int32_t i32Loops = src->h / 2;
@@ -1165,3 +2124,28 @@ void imlib_nvt_RGB_blend(image_t *src0, image_t *src1, image_t *dst, float alpha
 	}
 }
 
+
+int32_t imlib_nvt_count_changed(const image_t *img0, const image_t *img1, uint8_t threshold)
+{
+	const uint8_t *pu8Src0 = img0->data;
+	const uint8_t *pu8Src1 = img1->data;
+	uint32_t u32Pixels = img0->w * img0->h;
+	uint32_t u32Changed = 0;
+
+	if((img0->pixfmt != PIXFORMAT_GRAYSCALE) || (img1->pixfmt != PIXFORMAT_GRAYSCALE) ||
+	   (img0->w != img1->w) || (img0->h != img1->h))
+		return -1;
+
+	//One predicate bit per 8-bit lane set where the difference exceeds threshold
+	for(uint32_t i = 0; i < u32Pixels; i += 16)
+	{
+		mve_pred16_t p = vctp8q(u32Pixels - i);
+		uint8x16_t vsrc0 = vld1q_z_u8(pu8Src0 + i, p);
+		uint8x16_t vsrc1 = vld1q_z_u8(pu8Src1 + i, p);
+		mve_pred16_t pChanged = vcmphiq_m_n_u8(vabdq_u8(vsrc0, vsrc1), threshold, p);
+
+		u32Changed += __builtin_popcount(pChanged);
+	}
+
+	return (int32_t)u32Changed;
+}
@@ -0,0 +1,194 @@
+/**************************************************************************//**
+ * @file     ImageSensorCaptureTest.cpp
+ * @version  V1.00
+ * @brief    Image sensor capture arming, completion and timeout, on a
+ *           simulated CCAP
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "ImageSensor.h"
+#include "NuMicro.h"
+#include "SimulatedCcap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Ops = std::vector<std::string>;
+
+/* What the completion of an ImageSensor_CaptureAsync was called with */
+struct Completion
+{
+    int calls = 0;
+    int result = 1;
+    void *userData = nullptr;
+};
+
+void OnCaptureDone(int result, void *userData)
+{
+    Completion *completion = static_cast<Completion *>(userData);
+
+    completion->calls++;
+    completion->result = result;
+    completion->userData = userData;
+}
+
+class ImageSensorCaptureTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_ccap.Reset();
+        ASSERT_EQ(ImageSensor_SetBackend(m_ccap.GetBackend()), 0);
+    }
+
+    /* Until the capture path has started CCAP from another thread */
+    bool WaitRunning()
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (!m_ccap.IsRunning())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+
+    test::SimulatedCcap &m_ccap = test::SimulatedCcap::Get();
+};
+
+} /* namespace */
+
+TEST_F(ImageSensorCaptureTest, ArmCompleteRearm)
+{
+    Completion first;
+    Completion second;
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x1000, 0, OnCaptureDone, &first), 0);
+    EXPECT_EQ(m_ccap.GetOps(), (Ops{"SetBufs", "Start"}));
+    EXPECT_EQ(m_ccap.GetFrameBufAddr(), 0x1000u);
+    EXPECT_EQ(m_ccap.GetPlanarBufAddr(), 0u);
+    EXPECT_TRUE(m_ccap.IsRunning());
+
+    /* One frame in flight at a time */
+    EXPECT_EQ(ImageSensor_CaptureAsync(0x2000, 0, OnCaptureDone, &second), -1);
+    EXPECT_EQ(ImageSensor_SetBackend(m_ccap.GetBackend()), -1);
+    EXPECT_EQ(m_ccap.GetOps(), (Ops{"SetBufs", "Start"}));
+
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(first.calls, 1);
+    EXPECT_EQ(first.result, 0);
+    EXPECT_EQ(first.userData, &first);
+    EXPECT_EQ(second.calls, 0);
+
+    /* The completion is reported once */
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(first.calls, 1);
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x2000, 0x3000, OnCaptureDone, &second), 0);
+    EXPECT_EQ(m_ccap.GetFrameBufAddr(), 0x2000u);
+    EXPECT_EQ(m_ccap.GetPlanarBufAddr(), 0x3000u);
+
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(second.calls, 1);
+    EXPECT_EQ(second.result, 0);
+    EXPECT_EQ(first.calls, 1);
+    EXPECT_EQ(m_ccap.GetOps(), (Ops{"SetBufs", "Start", "SetBufs", "Start"}));
+}
+
+TEST_F(ImageSensorCaptureTest, RejectsMissingCompletion)
+{
+    EXPECT_EQ(ImageSensor_CaptureAsync(0x1000, 0, nullptr, nullptr), -1);
+    EXPECT_TRUE(m_ccap.GetOps().empty());
+}
+
+TEST_F(ImageSensorCaptureTest, IgnoresEventsWithNothingArmed)
+{
+    m_ccap.RaiseFrameEnd();
+    EXPECT_TRUE(m_ccap.GetOps().empty());
+
+    Completion completion;
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x1000, 0, OnCaptureDone, &completion), 0);
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(completion.calls, 1);
+}
+
+/* MEINTF stops CCAP and fails the frame, and the next one can be armed */
+TEST_F(ImageSensorCaptureTest, MemErrorStopsAndFails)
+{
+    Completion completion;
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x1000, 0, OnCaptureDone, &completion), 0);
+    m_ccap.RaiseMemError();
+
+    EXPECT_EQ(completion.calls, 1);
+    EXPECT_EQ(completion.result, -1);
+    EXPECT_FALSE(m_ccap.IsRunning());
+    EXPECT_EQ(m_ccap.GetOps(), (Ops{"SetBufs", "Start", "Stop"}));
+
+    Completion next;
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x1000, 0, OnCaptureDone, &next), 0);
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(next.result, 0);
+}
+
+/* The blocking captures sleep until VINTF, and return its result */
+TEST_F(ImageSensorCaptureTest, BlockingCaptureWaitsForFrameEnd)
+{
+    std::future<int> result = std::async(std::launch::async, []()
+    {
+        return ImageSensor_CaptureDualPipe(0x1000, 0x2000);
+    });
+
+    ASSERT_TRUE(WaitRunning());
+    EXPECT_EQ(m_ccap.GetFrameBufAddr(), 0x1000u);
+    EXPECT_EQ(m_ccap.GetPlanarBufAddr(), 0x2000u);
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(result.get(), 0);
+
+    result = std::async(std::launch::async, []()
+    {
+        return ImageSensor_Capture(0x3000);
+    });
+
+    ASSERT_TRUE(WaitRunning());
+    m_ccap.RaiseMemError();
+    EXPECT_EQ(result.get(), -1);
+}
+
+/* A frame that never ends is disarmed with the interrupt masked, and CCAP stopped */
+TEST_F(ImageSensorCaptureTest, TimeoutDisarms)
+{
+    EXPECT_EQ(ImageSensor_Capture(0x1000), CCAP_ERR_TIMEOUT);
+    EXPECT_EQ(m_ccap.GetOps(), (Ops{"SetBufs", "Start", "DisableIRQ", "EnableIRQ", "Stop"}));
+    EXPECT_FALSE(m_ccap.IsRunning());
+
+    /* A late VINTF does not complete the next capture */
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(ImageSensor_TriggerCapture(0x2000), 0);
+    EXPECT_EQ(ImageSensor_WaitCaptureDone(), CCAP_ERR_TIMEOUT);
+
+    /* The capture can be armed again */
+    Completion completion;
+
+    ASSERT_EQ(ImageSensor_CaptureAsync(0x3000, 0, OnCaptureDone, &completion), 0);
+    m_ccap.RaiseFrameEnd();
+    EXPECT_EQ(completion.calls, 1);
+    EXPECT_EQ(completion.result, 0);
+}
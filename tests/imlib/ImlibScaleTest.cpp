@@ -0,0 +1,446 @@
+/**************************************************************************//**
+ * @file     ImlibScaleTest.cpp
+ * @version  V1.00
+ * @brief    imlib_nvt scale plans against imlib_nvt_scale, int8 conversion
+ *           and double references of area and bilinear sampling
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "imlib.h"
+#include "ImageUtils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct Image
+{
+    Image(uint32_t w, uint32_t h, uint32_t pixfmt) : data(w * h * 4)
+    {
+        img.w = w;
+        img.h = h;
+        img.pixfmt = pixfmt;
+        img.size = 0;
+        img.data = data.data();
+    }
+
+    Image(const Image &) = delete;
+    Image &operator=(const Image &) = delete;
+
+    /* Bytes of the image, not of the spare end of the buffer */
+    std::vector<uint8_t> Bytes() const
+    {
+        return std::vector<uint8_t>(data.begin(), data.begin() + img.w * img.h * img.bpp);
+    }
+
+    std::vector<uint8_t> data;
+    image_t img{};
+};
+
+void Fill(Image &image, uint32_t seed)
+{
+    std::mt19937 random(seed);
+
+    for (uint8_t &byte : image.data)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+}
+
+/* Channel c of pixel x, y in 8 bits, RGB565 expanded as imlib does */
+int Channel(const image_t &image, uint32_t x, uint32_t y, int c)
+{
+    if (image.pixfmt == PIXFORMAT_RGB565)
+    {
+        const uint16_t pixel = reinterpret_cast<const uint16_t *>(image.data)[y * image.w + x];
+        const int value = (c == 0) ? ((pixel >> 8) & 0xF8) : (c == 1) ? ((pixel >> 3) & 0xFC) : ((pixel << 3) & 0xF8);
+
+        return value | (value >> ((c == 1) ? 6 : 5));
+    }
+
+    return image.data[(y * image.w + x) * 3 + c];
+}
+
+/* Channel c of pixel x, y in the bits of the format */
+int Code(const image_t &image, uint32_t x, uint32_t y, int c)
+{
+    if (image.pixfmt == PIXFORMAT_RGB565)
+    {
+        const uint16_t pixel = reinterpret_cast<const uint16_t *>(image.data)[y * image.w + x];
+
+        return (c == 0) ? (pixel >> 11) : (c == 1) ? ((pixel >> 5) & 0x3F) : (pixel & 0x1F);
+    }
+
+    return image.data[(y * image.w + x) * 3 + c];
+}
+
+/* The format's code of an 8-bit channel value */
+int ToCode(double value, uint32_t pixfmt, int c)
+{
+    const int rounded = static_cast<int>(std::lround(std::min(std::max(value, 0.0), 255.0)));
+
+    if (pixfmt == PIXFORMAT_RGB565)
+    {
+        return rounded >> ((c == 1) ? 2 : 3);
+    }
+
+    return rounded;
+}
+
+/* Bilinear source position of a destination pixel centre */
+void BilinearTap(uint32_t dst, uint32_t dstSize, uint32_t srcSize, uint32_t &pos0, uint32_t &pos1, double &weight)
+{
+    const double pos = std::max((dst + 0.5) * srcSize / dstSize - 0.5, 0.0);
+
+    pos0 = static_cast<uint32_t>(pos);
+    weight = pos - pos0;
+
+    if (pos0 >= srcSize - 1)
+    {
+        pos0 = srcSize - 1;
+        weight = 0;
+    }
+
+    pos1 = std::min(pos0 + 1, srcSize - 1);
+}
+
+/* Channel c of destination pixel x, y, scaling roi into a dstW x dstH image */
+double Reference(const image_t &src, const rectangle_t &roi, uint32_t dstW, uint32_t dstH,
+                 nvt_scale_mode_t mode, uint32_t x, uint32_t y, int c)
+{
+    if (mode == NVT_SCALE_AREA)
+    {
+        const uint32_t x0 = x * roi.w / dstW;
+        const uint32_t x1 = (x + 1) * roi.w / dstW;
+        const uint32_t y0 = y * roi.h / dstH;
+        const uint32_t y1 = (y + 1) * roi.h / dstH;
+        double sum = 0;
+
+        for (uint32_t sy = y0; sy < y1; ++sy)
+        {
+            for (uint32_t sx = x0; sx < x1; ++sx)
+            {
+                sum += Channel(src, roi.x + sx, roi.y + sy, c);
+            }
+        }
+
+        return sum / ((x1 - x0) * (y1 - y0));
+    }
+
+    uint32_t x0, x1, y0, y1;
+    double wx, wy;
+
+    BilinearTap(x, dstW, roi.w, x0, x1, wx);
+    BilinearTap(y, dstH, roi.h, y0, y1, wy);
+
+    const double top = Channel(src, roi.x + x0, roi.y + y0, c) * (1 - wx) + Channel(src, roi.x + x1, roi.y + y0, c) * wx;
+    const double bottom = Channel(src, roi.x + x0, roi.y + y1, c) * (1 - wx) + Channel(src, roi.x + x1, roi.y + y1, c) * wx;
+
+    return top * (1 - wy) + bottom * wy;
+}
+
+/* Every channel of dst within one code of the double reference, up to 2 in 8 bits for the Q7 and Q16 steps */
+void ExpectNearReference(const image_t &src, const rectangle_t &roi, const image_t &dst, nvt_scale_mode_t mode)
+{
+    const int tolerance = (dst.pixfmt == PIXFORMAT_RGB565) ? 1 : 2;
+    int failures = 0;
+
+    for (uint32_t y = 0; y < dst.h; ++y)
+    {
+        for (uint32_t x = 0; x < dst.w; ++x)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const int expected = ToCode(Reference(src, roi, dst.w, dst.h, mode, x, y, c), dst.pixfmt, c);
+
+                if (std::abs(Code(dst, x, y, c) - expected) > tolerance && failures++ < 8)
+                {
+                    ADD_FAILURE() << "pixel " << x << "," << y << " channel " << c << ": "
+                                  << Code(dst, x, y, c) << " vs " << expected;
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(failures, 0);
+}
+
+struct Size
+{
+    rectangle_t roi;
+    uint32_t srcW;
+    uint32_t srcH;
+    uint32_t dstW;
+    uint32_t dstH;
+};
+
+/* Down, up and uneven sizes, of the whole source and of an ROI */
+const std::vector<Size> s_sizes = {
+    {{0, 0, 64, 48}, 64, 48, 32, 24},
+    {{0, 0, 64, 48}, 64, 48, 96, 72},
+    {{0, 0, 64, 48}, 64, 48, 17, 13},
+    {{5, 3, 40, 30}, 64, 48, 24, 18},
+    {{7, 9, 33, 21}, 64, 48, 50, 40},
+    {{0, 0, 160, 120}, 160, 120, 48, 48},
+};
+
+struct Formats
+{
+    uint32_t src;
+    uint32_t dst;
+};
+
+/* The pairs imlib_nvt_scale converts */
+const std::vector<Formats> s_nearestFormats = {
+    {PIXFORMAT_RGB888, PIXFORMAT_RGB565},
+    {PIXFORMAT_RGB565, PIXFORMAT_RGB888},
+    {PIXFORMAT_RGB888, PIXFORMAT_RGB888},
+    {PIXFORMAT_RGB565, PIXFORMAT_GRAYSCALE},
+    {PIXFORMAT_GRAYSCALE, PIXFORMAT_RGB565},
+    {PIXFORMAT_RGB565, PIXFORMAT_YUV422},
+    {PIXFORMAT_RGB565, PIXFORMAT_RGB565},
+};
+
+/* The pairs of the filtered modes */
+const std::vector<Formats> s_filteredFormats = {
+    {PIXFORMAT_RGB888, PIXFORMAT_RGB565},
+    {PIXFORMAT_RGB565, PIXFORMAT_RGB888},
+    {PIXFORMAT_RGB888, PIXFORMAT_RGB888},
+    {PIXFORMAT_RGB565, PIXFORMAT_RGB565},
+};
+
+/* Values v map to v - 128, as ConvertImgToInt8 */
+rgb565_int8_lut_t MakeLut()
+{
+    rgb565_int8_lut_t lut;
+
+    imlib_nvt_RGB565toInt8_lut(&lut, 1 / 255.f, 1 / 255.f, -128);
+    return lut;
+}
+
+nvt_scale_plan_t s_plan;
+
+} /* namespace */
+
+TEST(ScalePlanTest, NearestMatchesScale)
+{
+    for (const Formats &formats : s_nearestFormats)
+    {
+        for (const Size &size : s_sizes)
+        {
+            SCOPED_TRACE(testing::Message() << "formats " << formats.src << " to " << formats.dst
+                                            << ", size " << size.dstW << "x" << size.dstH);
+            Image src(size.srcW, size.srcH, formats.src);
+            Image expected(size.dstW, size.dstH, formats.dst);
+            Image planned(size.dstW, size.dstH, formats.dst);
+            Image scaled(size.dstW, size.dstH, formats.dst);
+            rectangle_t roi = size.roi;
+
+            Fill(src, size.dstW);
+            imlib_nvt_scale(&src.img, &expected.img, &roi);
+
+            ASSERT_EQ(imlib_nvt_scale_plan_init(&s_plan, &src.img, &planned.img, &roi, NVT_SCALE_NEAREST, nullptr), 0);
+            ASSERT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &planned.img), 0);
+            EXPECT_EQ(planned.Bytes(), expected.Bytes());
+
+            imlib_nvt_scale_ex(&src.img, &scaled.img, &roi, NVT_SCALE_NEAREST);
+            EXPECT_EQ(scaled.Bytes(), expected.Bytes());
+        }
+    }
+}
+
+/* Filtered modes of other format pairs sample nearest */
+TEST(ScalePlanTest, FilteredFallsBackToNearest)
+{
+    const Size &size = s_sizes[3];
+
+    for (const Formats &formats : {Formats {PIXFORMAT_RGB565, PIXFORMAT_GRAYSCALE}, Formats {PIXFORMAT_GRAYSCALE, PIXFORMAT_RGB565}})
+    {
+        Image src(size.srcW, size.srcH, formats.src);
+        Image expected(size.dstW, size.dstH, formats.dst);
+        Image scaled(size.dstW, size.dstH, formats.dst);
+        rectangle_t roi = size.roi;
+
+        Fill(src, 1);
+        imlib_nvt_scale(&src.img, &expected.img, &roi);
+        imlib_nvt_scale_ex(&src.img, &scaled.img, &roi, NVT_SCALE_BILINEAR);
+        EXPECT_EQ(scaled.Bytes(), expected.Bytes());
+    }
+}
+
+TEST(ScalePlanTest, Int8MatchesScaleAndConvert)
+{
+    const rgb565_int8_lut_t lut = MakeLut();
+
+    for (uint32_t srcPixfmt : {PIXFORMAT_RGB565, PIXFORMAT_RGB888})
+    {
+        for (nvt_scale_mode_t mode : {NVT_SCALE_NEAREST, NVT_SCALE_AREA, NVT_SCALE_BILINEAR})
+        {
+            for (const Size &size : s_sizes)
+            {
+                SCOPED_TRACE(testing::Message() << "format " << srcPixfmt << ", mode " << mode
+                                                << ", size " << size.dstW << "x" << size.dstH);
+                Image src(size.srcW, size.srcH, srcPixfmt);
+                Image expected(size.dstW, size.dstH, PIXFORMAT_RGB888);
+                Image planned(size.dstW, size.dstH, PIXFORMAT_RGB888);
+                rectangle_t roi = size.roi;
+
+                Fill(src, size.dstH);
+                imlib_nvt_scale_ex(&src.img, &expected.img, &roi, mode);
+                arm::app::image::ConvertImgToInt8(expected.img.data, size.dstW * size.dstH * 3);
+
+                ASSERT_EQ(imlib_nvt_scale_plan_init(&s_plan, &src.img, &planned.img, &roi, mode, &lut), 0);
+                ASSERT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &planned.img), 0);
+                EXPECT_EQ(planned.Bytes(), expected.Bytes());
+
+                if (srcPixfmt == PIXFORMAT_RGB565)
+                {
+                    Image scaled(size.dstW, size.dstH, PIXFORMAT_RGB888);
+
+                    imlib_nvt_scale_int8(&src.img, &scaled.img, &roi, &lut, mode);
+                    EXPECT_EQ(scaled.Bytes(), expected.Bytes());
+                }
+            }
+        }
+    }
+}
+
+TEST(ScalePlanTest, FilteredMatchesReference)
+{
+    for (const Formats &formats : s_filteredFormats)
+    {
+        for (nvt_scale_mode_t mode : {NVT_SCALE_AREA, NVT_SCALE_BILINEAR})
+        {
+            for (const Size &size : s_sizes)
+            {
+                SCOPED_TRACE(testing::Message() << "formats " << formats.src << " to " << formats.dst << ", mode "
+                                                << mode << ", size " << size.dstW << "x" << size.dstH);
+                Image src(size.srcW, size.srcH, formats.src);
+                Image planned(size.dstW, size.dstH, formats.dst);
+                Image scaled(size.dstW, size.dstH, formats.dst);
+                rectangle_t roi = size.roi;
+                const bool upscale = (size.dstW > static_cast<uint32_t>(roi.w)) || (size.dstH > static_cast<uint32_t>(roi.h));
+
+                Fill(src, size.srcW + size.dstW);
+
+                ASSERT_EQ(imlib_nvt_scale_plan_init(&s_plan, &src.img, &planned.img, &roi, mode, nullptr), 0);
+                EXPECT_EQ(s_plan.sampling, (upscale ? NVT_SCALE_BILINEAR : mode));
+                ASSERT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &planned.img), 0);
+                ExpectNearReference(src.img, roi, planned.img, s_plan.sampling);
+
+                imlib_nvt_scale_ex(&src.img, &scaled.img, &roi, mode);
+                EXPECT_EQ(scaled.Bytes(), planned.Bytes());
+            }
+        }
+    }
+}
+
+/* A plan is reused on other frames of its sizes and formats, and refuses others */
+TEST(ScalePlanTest, RunChecksImages)
+{
+    const Size &size = s_sizes[3];
+    Image src(size.srcW, size.srcH, PIXFORMAT_RGB565);
+    Image planned(size.dstW, size.dstH, PIXFORMAT_RGB888);
+    Image expected(size.dstW, size.dstH, PIXFORMAT_RGB888);
+    Image other(size.dstW, size.dstH, PIXFORMAT_RGB565);
+    rectangle_t roi = size.roi;
+
+    ASSERT_EQ(imlib_nvt_scale_plan_init(&s_plan, &src.img, &planned.img, &roi, NVT_SCALE_BILINEAR, nullptr), 0);
+
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        Fill(src, frame);
+        ASSERT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &planned.img), 0);
+        ExpectNearReference(src.img, roi, planned.img, NVT_SCALE_BILINEAR);
+    }
+
+    EXPECT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &other.img), -1);
+
+    rectangle_t outside = {40, 30, 40, 30};
+
+    EXPECT_EQ(imlib_nvt_scale_plan_init(&s_plan, &src.img, &planned.img, &outside, NVT_SCALE_BILINEAR, nullptr), -1);
+    EXPECT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &planned.img), -1);
+}
+
+TEST(ScalePlanTest, LetterboxCentresAndPads)
+{
+    const rgb565_int8_lut_t lut = MakeLut();
+
+    struct Letterbox
+    {
+        rectangle_t roi;
+        rectangle_t dstRect;
+    };
+
+    /* A wide ROI pads above and below, a tall one left and right */
+    const std::vector<Letterbox> letterboxes = {
+        {{0, 0, 64, 48}, {0, 5, 40, 30}},
+        {{10, 4, 30, 40}, {5, 0, 30, 40}},
+    };
+
+    for (uint32_t dstPixfmt : {PIXFORMAT_RGB565, PIXFORMAT_RGB888})
+    {
+        for (const rgb565_int8_lut_t *planLut : {static_cast<const rgb565_int8_lut_t *>(nullptr), &lut})
+        {
+            if (planLut && (dstPixfmt != PIXFORMAT_RGB888))
+            {
+                continue;
+            }
+
+            for (nvt_scale_mode_t mode : {NVT_SCALE_NEAREST, NVT_SCALE_AREA, NVT_SCALE_BILINEAR})
+            {
+                for (const Letterbox &letterbox : letterboxes)
+                {
+                    SCOPED_TRACE(testing::Message() << "format " << dstPixfmt << ", lut " << (planLut != nullptr)
+                                                    << ", mode " << mode << ", roi " << letterbox.roi.w << "x" << letterbox.roi.h);
+                    const rectangle_t &rect = letterbox.dstRect;
+                    Image src(64, 48, PIXFORMAT_RGB565);
+                    Image boxed(40, 40, dstPixfmt);
+                    Image content(rect.w, rect.h, dstPixfmt);
+                    Image grey(1, 1, PIXFORMAT_RGB888);
+                    rectangle_t roi = letterbox.roi;
+                    nvt_scale_plan_t plain;
+
+                    Fill(src, rect.x);
+                    std::fill(grey.data.begin(), grey.data.end(), planLut ? 0 : 128);
+
+                    ASSERT_EQ(imlib_nvt_scale_plan_init_letterbox(&s_plan, &src.img, &boxed.img, &roi, mode, planLut), 0);
+                    EXPECT_EQ(s_plan.dst_rect.x, rect.x);
+                    EXPECT_EQ(s_plan.dst_rect.y, rect.y);
+                    EXPECT_EQ(s_plan.dst_rect.w, rect.w);
+                    EXPECT_EQ(s_plan.dst_rect.h, rect.h);
+                    ASSERT_EQ(imlib_nvt_scale_plan_run(&s_plan, &src.img, &boxed.img), 0);
+
+                    ASSERT_EQ(imlib_nvt_scale_plan_init(&plain, &src.img, &content.img, &roi, mode, planLut), 0);
+                    ASSERT_EQ(imlib_nvt_scale_plan_run(&plain, &src.img, &content.img), 0);
+
+                    for (uint32_t y = 0; y < boxed.img.h; ++y)
+                    {
+                        for (uint32_t x = 0; x < boxed.img.w; ++x)
+                        {
+                            const bool inside = (x >= static_cast<uint32_t>(rect.x)) && (x < static_cast<uint32_t>(rect.x + rect.w)) &&
+                                                (y >= static_cast<uint32_t>(rect.y)) && (y < static_cast<uint32_t>(rect.y + rect.h));
+
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                const int expected = inside ? Code(content.img, x - rect.x, y - rect.y, c)
+                                                            : ToCode(Code(grey.img, 0, 0, c), dstPixfmt, c);
+
+                                ASSERT_EQ(Code(boxed.img, x, y, c), expected) << "pixel " << x << "," << y << " channel " << c;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,314 @@
+/**************************************************************************//**
+ * @file     FrameSlotRingTest.cpp
+ * @version  V1.00
+ * @brief    Frame slots of the main loop going round capture -> inference ->
+ *           render on the Pattern images, with and without latest frame wins
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "FrameSlotRing.hpp"
+#include "InputFiles.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include <vector>
+
+using arm::app::object_detection::DetectionResult;
+
+namespace
+{
+
+constexpr int s_numSlots = 3;
+constexpr uint32_t s_inputSize = 192;
+
+/* The Pattern image a capture shows, RGB565 */
+std::vector<uint16_t> PatternFrame(uint32_t capture)
+{
+    const uint8_t *rgb = get_img_array(capture % NUMBER_OF_FILES);
+    std::vector<uint16_t> frame(IMAGE_WIDTH * IMAGE_HEIGHT);
+
+    for (size_t i = 0; i < frame.size(); i++, rgb += 3)
+    {
+        frame[i] = static_cast<uint16_t>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+    }
+
+    return frame;
+}
+
+class FrameSlotRingTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_inputData.resize(s_inputSize * s_inputSize * 3);
+        m_input.w = s_inputSize;
+        m_input.h = s_inputSize;
+        m_input.pixfmt = PIXFORMAT_RGB888;
+        m_input.data = m_inputData.data();
+
+        k_fifo_init(&m_processQueue);
+        k_fifo_init(&m_responseQueue);
+
+        for (int i = 0; i < s_numSlots; i++)
+        {
+            S_FRAMEBUF &slot = m_slots[i];
+
+            m_frameData[i].resize(IMAGE_WIDTH * IMAGE_HEIGHT);
+            slot.frameImage.w = IMAGE_WIDTH;
+            slot.frameImage.h = IMAGE_HEIGHT;
+            slot.frameImage.pixfmt = PIXFORMAT_RGB565;
+            slot.frameImage.data = reinterpret_cast<uint8_t *>(m_frameData[i].data());
+            slot.modelStage = nullptr;
+            slot.job.responseQueue = &m_responseQueue;
+            slot.job.pFrameSource = &m_frameSource;
+            slot.job.frame = &slot.frameImage;
+            slot.job.modelStage = nullptr;
+            slot.job.u32FramesDropped = 0;
+            slot.job.results = &slot.results;
+            slot.job.pvOwner = &slot;
+        }
+
+        rectangle_t roi = {0, 0, IMAGE_WIDTH, IMAGE_HEIGHT};
+
+        ASSERT_EQ(imlib_nvt_scale_plan_init(&m_inputPlan, &m_slots[0].frameImage, &m_input, &roi,
+                                            NVT_SCALE_NEAREST, nullptr), 0);
+        ASSERT_EQ(m_frameSource.Init(&m_slots[0].frameImage, &m_input), 0);
+        ASSERT_EQ(m_ring.Init(m_slots, s_numSlots, &m_processQueue), 0);
+    }
+
+    /* The capture stage of the main loop, returning the slot */
+    S_FRAMEBUF *Capture(bool bLatestFrameWins)
+    {
+        S_FRAMEBUF *slot = m_ring.Acquire(bLatestFrameWins, m_u32SlotsDropped, m_u32FramesDropped);
+
+        EXPECT_EQ(m_frameSource.Capture(&slot->frameImage, slot->modelStage), 0);
+
+        if (bLatestFrameWins)
+            m_ring.DropPending(m_u32SlotsDropped, m_u32FramesDropped);
+
+        m_captureOf[slot] = m_u32Captured++;
+        slot->results.clear();
+        slot->job.u32FramesDropped = m_u32FramesDropped;
+        m_u32FramesDropped = 0;
+        m_ring.Submit(slot);
+        return slot;
+    }
+
+    /* Inference takes the next job, nullptr if none waits */
+    xInferenceJob *StartInference()
+    {
+        return static_cast<xInferenceJob *>(k_fifo_get(&m_processQueue, K_NO_WAIT));
+    }
+
+    /* Inference fills the model input from its frame, and hands back a result naming the capture */
+    void FinishInference(xInferenceJob *job)
+    {
+        S_FRAMEBUF *slot = static_cast<S_FRAMEBUF *>(job->pvOwner);
+        const uint32_t capture = m_captureOf[slot];
+        std::vector<uint16_t> expectedFrame = PatternFrame(capture);
+        std::vector<uint8_t> expectedData(m_inputData.size());
+        image_t expected = m_input;
+        image_t pattern = slot->frameImage;
+        DetectionResult result = {};
+
+        expected.data = expectedData.data();
+        pattern.data = reinterpret_cast<uint8_t *>(expectedFrame.data());
+
+        ASSERT_EQ(job->pFrameSource->ToModelInput(job->frame, job->modelStage, &m_input), 0);
+        ASSERT_EQ(imlib_nvt_scale_plan_run(&m_inputPlan, &pattern, &expected), 0);
+        EXPECT_EQ(m_inputData, expectedData) << "capture " << capture;
+
+        result.m_cls = static_cast<int>(capture);
+        job->results->push_back(result);
+        k_fifo_put(job->responseQueue, job);
+    }
+
+    /* Render shows the next result with its frame, and hands the slot back; the capture it showed */
+    uint32_t Render()
+    {
+        xInferenceJob *job = static_cast<xInferenceJob *>(k_fifo_get(&m_responseQueue, K_NO_WAIT));
+        uint32_t capture = UINT32_MAX;
+
+        EXPECT_NE(job, nullptr);
+
+        if (job != nullptr)
+        {
+            S_FRAMEBUF *slot = static_cast<S_FRAMEBUF *>(job->pvOwner);
+            const uint16_t *frame = reinterpret_cast<const uint16_t *>(slot->frameImage.data);
+
+            capture = m_captureOf[slot];
+            EXPECT_EQ(std::vector<uint16_t>(frame, frame + IMAGE_WIDTH * IMAGE_HEIGHT), PatternFrame(capture))
+                << "capture " << capture;
+            EXPECT_EQ(slot->results.size(), 1u);
+            EXPECT_EQ(slot->results.empty() ? -1 : slot->results[0].m_cls, static_cast<int>(capture));
+            m_ring.PutFree(slot);
+        }
+
+        return capture;
+    }
+
+    S_FRAMEBUF m_slots[s_numSlots];
+    std::vector<uint16_t> m_frameData[s_numSlots];
+    std::vector<uint8_t> m_inputData;
+    image_t m_input{};
+    nvt_scale_plan_t m_inputPlan;
+    ImageFrameSource m_frameSource{&m_inputPlan};
+    struct k_fifo m_processQueue;
+    struct k_fifo m_responseQueue;
+    FrameSlotRing m_ring;
+
+    std::map<const S_FRAMEBUF *, uint32_t> m_captureOf;
+    uint32_t m_u32Captured{0};
+    uint32_t m_u32SlotsDropped{0};
+    uint32_t m_u32FramesDropped{0};
+};
+
+} /* namespace */
+
+/* Inference keeping up: every frame is inferred and shown, in order, through all the Pattern images */
+TEST_F(FrameSlotRingTest, EveryFrameGoesRoundInOrder)
+{
+    const uint32_t frames = 2 * NUMBER_OF_FILES + s_numSlots;
+    uint32_t shown = 0;
+
+    for (int i = 0; i < s_numSlots; i++)
+    {
+        Capture(false);
+    }
+
+    while (shown < frames)
+    {
+        xInferenceJob *job = StartInference();
+
+        ASSERT_NE(job, nullptr);
+        EXPECT_EQ(job->u32FramesDropped, 0u);
+        FinishInference(job);
+        ASSERT_EQ(Render(), shown);
+        shown++;
+
+        if (m_u32Captured < frames)
+            Capture(false);
+    }
+
+    EXPECT_EQ(StartInference(), nullptr);
+    EXPECT_EQ(m_u32SlotsDropped, 0u);
+}
+
+/* Inference busy: each capture drops the frame still waiting, the next inferred one counts them all */
+TEST_F(FrameSlotRingTest, LatestFrameWinsDropsWaitingFrames)
+{
+    Capture(true);
+    xInferenceJob *busy = StartInference();
+
+    ASSERT_NE(busy, nullptr);
+
+    for (int i = 0; i < 4; i++)
+    {
+        Capture(true);
+    }
+
+    /* Captures 1 to 3 were dropped, each for the next */
+    EXPECT_EQ(m_u32SlotsDropped, 3u);
+
+    FinishInference(busy);
+    EXPECT_EQ(Render(), 0u);
+
+    xInferenceJob *job = StartInference();
+
+    ASSERT_NE(job, nullptr);
+    EXPECT_EQ(job->u32FramesDropped, 3u);
+    FinishInference(job);
+    EXPECT_EQ(Render(), 4u);
+    EXPECT_EQ(StartInference(), nullptr);
+
+    /* Every slot came back */
+    m_ring.Drain();
+    EXPECT_EQ(m_ring.GetFree(false), nullptr);
+}
+
+/* No slot free: capture takes the one waiting for inference rather than wait */
+TEST_F(FrameSlotRingTest, LatestFrameWinsReusesWaitingSlot)
+{
+    Capture(true);
+    FinishInference(StartInference());
+    Capture(true);
+    xInferenceJob *busy = StartInference();
+    S_FRAMEBUF *waiting = Capture(true);
+
+    /* Slots in render, inference and waiting for inference */
+    ASSERT_EQ(m_ring.GetFree(false), nullptr);
+
+    EXPECT_EQ(Capture(true), waiting);
+    EXPECT_EQ(m_u32SlotsDropped, 1u);
+
+    EXPECT_EQ(Render(), 0u);
+    FinishInference(busy);
+    EXPECT_EQ(Render(), 1u);
+
+    xInferenceJob *job = StartInference();
+
+    ASSERT_NE(job, nullptr);
+    EXPECT_EQ(job->pvOwner, waiting);
+    EXPECT_EQ(job->u32FramesDropped, 1u);
+    FinishInference(job);
+    EXPECT_EQ(Render(), 3u);
+}
+
+/* Without latest frame wins, capture waits for render to hand a slot back, and drops nothing */
+TEST_F(FrameSlotRingTest, CaptureWaitsForFreeSlot)
+{
+    for (int i = 0; i < s_numSlots; i++)
+    {
+        Capture(false);
+    }
+
+    std::atomic<S_FRAMEBUF *> acquired{nullptr};
+    uint32_t u32SlotsDropped = 0;
+    uint32_t u32FramesDropped = 0;
+    std::thread capture([&]
+    {
+        acquired = m_ring.Acquire(false, u32SlotsDropped, u32FramesDropped);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(acquired.load(), nullptr);
+
+    xInferenceJob *job = StartInference();
+
+    ASSERT_NE(job, nullptr);
+    FinishInference(job);
+    EXPECT_EQ(Render(), 0u);
+    capture.join();
+
+    EXPECT_EQ(acquired.load(), job->pvOwner);
+    EXPECT_EQ(u32SlotsDropped, 0u);
+    EXPECT_EQ(u32FramesDropped, 0u);
+}
+
+/* Drain takes every slot out of the ring until Refill, as around a model switch */
+TEST_F(FrameSlotRingTest, DrainAndRefill)
+{
+    m_ring.Drain();
+    EXPECT_EQ(m_ring.GetFree(false), nullptr);
+
+    m_ring.Refill();
+
+    std::vector<S_FRAMEBUF *> slots;
+
+    for (int i = 0; i < s_numSlots; i++)
+    {
+        slots.push_back(m_ring.GetFree(false));
+    }
+
+    EXPECT_EQ(m_ring.GetFree(false), nullptr);
+
+    std::sort(slots.begin(), slots.end());
+    EXPECT_EQ(slots, (std::vector<S_FRAMEBUF *>{&m_slots[0], &m_slots[1], &m_slots[2]}));
+}
@@ -0,0 +1,233 @@
+/**************************************************************************//**
+ * @file     MotionGateTest.cpp
+ * @version  V1.00
+ * @brief    imlib_nvt_count_changed against a scalar reference, and the
+ *           MotionGate decisions on static, changed and refreshed scenes
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "MotionGate.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t s_frameWidth = 320;
+constexpr uint32_t s_frameHeight = 240;
+
+/* Changed thumbnail pixels, in 1/1000, above which the scene changed: 48 of 4800 */
+constexpr int s_changedPermille = 10;
+constexpr int s_pixelThreshold = 20;
+
+image_t GrayImage(std::vector<uint8_t> &data, uint32_t w, uint32_t h)
+{
+    image_t img{};
+
+    img.w = w;
+    img.h = h;
+    img.pixfmt = PIXFORMAT_GRAYSCALE;
+    img.data = data.data();
+    return img;
+}
+
+int32_t CountChanged(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint8_t threshold)
+{
+    int32_t changed = 0;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        changed += (std::abs(a[i] - b[i]) > threshold) ? 1 : 0;
+    }
+
+    return changed;
+}
+
+/* A dark RGB565 frame, so that white blocks change its gray level well past the threshold */
+class Frame
+{
+public:
+    Frame() : m_pixels(s_frameWidth * s_frameHeight)
+    {
+        std::mt19937 random(1);
+
+        for (uint16_t &pixel : m_pixels)
+        {
+            pixel = static_cast<uint16_t>(((random() % 12) << 11) | ((random() % 24) << 5) | (random() % 12));
+        }
+
+        m_img.w = s_frameWidth;
+        m_img.h = s_frameHeight;
+        m_img.pixfmt = PIXFORMAT_RGB565;
+        m_img.data = reinterpret_cast<uint8_t *>(m_pixels.data());
+    }
+
+    /* Whiten the 16 x 16 block of block coordinates bx, by, 4 x 4 thumbnail pixels */
+    void Whiten(uint32_t bx, uint32_t by)
+    {
+        for (uint32_t y = by * 16; y < (by + 1) * 16; ++y)
+        {
+            for (uint32_t x = bx * 16; x < (bx + 1) * 16; ++x)
+            {
+                m_pixels[y * s_frameWidth + x] = 0xFFFF;
+            }
+        }
+    }
+
+    image_t *Image()
+    {
+        return &m_img;
+    }
+
+private:
+    std::vector<uint16_t> m_pixels;
+    image_t m_img{};
+};
+
+class MotionGateTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(m_gate.Init(m_frame.Image()), 0);
+        m_gate.Configure(s_pixelThreshold, s_changedPermille, 0);
+        ASSERT_TRUE(m_gate.Check(m_frame.Image(), false));
+    }
+
+    MotionGate m_gate;
+    Frame m_frame;
+};
+
+} /* namespace */
+
+/* Lengths around the 16-pixel vectors, and thumbnail sized */
+TEST(CountChangedTest, MatchesScalarReference)
+{
+    std::mt19937 random(7);
+
+    for (uint32_t w : {1u, 15u, 16u, 17u, 31u, 33u, 80u})
+    {
+        for (uint32_t h : {1u, 3u, 60u})
+        {
+            std::vector<uint8_t> a(w * h);
+            std::vector<uint8_t> b(w * h);
+
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                a[i] = static_cast<uint8_t>(random());
+                b[i] = (random() & 1) ? a[i] : static_cast<uint8_t>(random());
+            }
+
+            const image_t img0 = GrayImage(a, w, h);
+            const image_t img1 = GrayImage(b, w, h);
+
+            for (uint8_t threshold : {0, 20, 128, 255})
+            {
+                EXPECT_EQ(imlib_nvt_count_changed(&img0, &img1, threshold), CountChanged(a, b, threshold))
+                    << w << "x" << h << ", threshold " << static_cast<int>(threshold);
+            }
+        }
+    }
+}
+
+/* Bytes past the image differ, and must not count */
+TEST(CountChangedTest, IgnoresBytesPastTheImage)
+{
+    std::vector<uint8_t> a(32, 0);
+    std::vector<uint8_t> b(32, 0);
+
+    std::fill(b.begin() + 17, b.end(), 255);
+
+    const image_t img0 = GrayImage(a, 17, 1);
+    const image_t img1 = GrayImage(b, 17, 1);
+
+    EXPECT_EQ(imlib_nvt_count_changed(&img0, &img1, 0), 0);
+}
+
+TEST(CountChangedTest, RejectsMismatchedImages)
+{
+    std::vector<uint8_t> a(64);
+    std::vector<uint8_t> b(64);
+    const image_t img0 = GrayImage(a, 8, 8);
+    image_t img1 = GrayImage(b, 16, 4);
+
+    EXPECT_EQ(imlib_nvt_count_changed(&img0, &img1, 0), -1);
+
+    img1 = GrayImage(b, 8, 8);
+    img1.pixfmt = PIXFORMAT_RGB565;
+    EXPECT_EQ(imlib_nvt_count_changed(&img0, &img1, 0), -1);
+}
+
+TEST_F(MotionGateTest, StaticSceneReusesResults)
+{
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        EXPECT_FALSE(m_gate.Check(m_frame.Image(), false)) << "frame " << frame;
+    }
+}
+
+TEST_F(MotionGateTest, ChangedSceneInfers)
+{
+    /* 4 blocks, 64 thumbnail pixels, past the 48 of 10 permille */
+    for (uint32_t bx = 0; bx < 4; ++bx)
+    {
+        m_frame.Whiten(bx, 2);
+    }
+
+    EXPECT_TRUE(m_gate.Check(m_frame.Image(), false));
+
+    /* It became the reference */
+    EXPECT_FALSE(m_gate.Check(m_frame.Image(), false));
+}
+
+/* Each frame changes less than the threshold, but the reference stays until the changes add up */
+TEST_F(MotionGateTest, SlowChangesAddUp)
+{
+    for (uint32_t bx = 0; bx < 3; ++bx)
+    {
+        m_frame.Whiten(bx, 5);
+        EXPECT_FALSE(m_gate.Check(m_frame.Image(), false)) << "block " << bx;
+    }
+
+    m_frame.Whiten(3, 5);
+    EXPECT_TRUE(m_gate.Check(m_frame.Image(), false));
+}
+
+TEST_F(MotionGateTest, ForceInfers)
+{
+    EXPECT_TRUE(m_gate.Check(m_frame.Image(), true));
+    EXPECT_FALSE(m_gate.Check(m_frame.Image(), false));
+}
+
+TEST_F(MotionGateTest, RefreshInfersStaticScene)
+{
+    constexpr int refreshFrames = 5;
+
+    m_gate.Configure(s_pixelThreshold, s_changedPermille, refreshFrames);
+
+    for (int period = 0; period < 2; ++period)
+    {
+        for (int frame = 1; frame < refreshFrames; ++frame)
+        {
+            EXPECT_FALSE(m_gate.Check(m_frame.Image(), false)) << "frame " << frame;
+        }
+
+        EXPECT_TRUE(m_gate.Check(m_frame.Image(), false)) << "period " << period;
+    }
+}
+
+/* Frames the thumbnail plan does not fit are inferred */
+TEST_F(MotionGateTest, OtherFrameSizeInfers)
+{
+    image_t other = *m_frame.Image();
+
+    other.w = s_frameWidth / 2;
+    EXPECT_TRUE(m_gate.Check(&other, false));
+}
@@ -0,0 +1,299 @@
+/**************************************************************************//**
+ * @file     NpuSchedulerTest.cpp
+ * @version  V1.00
+ * @brief    NpuScheduler policy on a simulated NPU and clock: priority,
+ *           earliest deadline, expiry and failures
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "MockNpuBackend.hpp"
+#include "NpuScheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/* Stand-ins for the models, which the simulated NPU never touches */
+char s_videoModel;
+char s_audioModel;
+
+arm::app::Model *VideoModel()
+{
+    return reinterpret_cast<arm::app::Model *>(&s_videoModel);
+}
+
+arm::app::Model *AudioModel()
+{
+    return reinterpret_cast<arm::app::Model *>(&s_audioModel);
+}
+
+/* A job that records when and how it finished */
+struct Job
+{
+    xNpuJob job{};
+    std::string name;
+    std::vector<std::string> *done;
+};
+
+void OnJobDone(xNpuJob *job)
+{
+    Job *owner = static_cast<Job *>(job->pvOwner);
+
+    owner->done->push_back(owner->name);
+}
+
+class NpuSchedulerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(m_npu.SetInvokeUs(VideoModel(), 3000), 0);
+        ASSERT_EQ(m_npu.SetInvokeUs(AudioModel(), 1000), 0);
+
+        m_video = m_scheduler.AddClient(VideoModel(), "video");
+        m_audio = m_scheduler.AddClient(AudioModel(), "audio");
+        ASSERT_GE(m_video, 0);
+        ASSERT_GE(m_audio, 0);
+
+        m_jobs.reserve(16);
+    }
+
+    /* Submit a job, deadlineUs 0 for none */
+    Job *Submit(const char *name, int client, int priority, uint32_t deadlineUs = 0)
+    {
+        m_jobs.push_back(Job{});
+
+        Job *job = &m_jobs.back();
+
+        job->name = name;
+        job->done = &m_done;
+        job->job.client = client;
+        job->job.priority = priority;
+        job->job.u32DeadlineUs = deadlineUs;
+        job->job.pfnDone = OnJobDone;
+        job->job.pvOwner = job;
+
+        EXPECT_EQ(m_scheduler.Submit(&job->job), 0);
+        return job;
+    }
+
+    /* Dispatch until nothing is pending */
+    void RunAll()
+    {
+        while (m_scheduler.RunNext(false))
+        {
+        }
+    }
+
+    test::MockNpuBackend m_npu;
+    NpuScheduler m_scheduler{&m_npu};
+    int m_video = -1;
+    int m_audio = -1;
+    std::vector<Job> m_jobs;
+    std::vector<std::string> m_done;
+};
+
+} /* namespace */
+
+/* The mock's clock moves by the inference time of each model */
+TEST(MockNpuBackendTest, SimulatesInferenceTime)
+{
+    test::MockNpuBackend npu;
+
+    ASSERT_EQ(npu.SetInvokeUs(VideoModel(), 3000), 0);
+    ASSERT_EQ(npu.SetInvokeUs(VideoModel(), 2000), 0);
+
+    EXPECT_TRUE(npu.Invoke(VideoModel()));
+    EXPECT_EQ(npu.NowUs(), 2000u);
+
+    /* A model without a time takes none */
+    EXPECT_TRUE(npu.Invoke(AudioModel()));
+    EXPECT_EQ(npu.NowUs(), 2000u);
+
+    npu.Advance(500);
+    EXPECT_EQ(npu.NowUs(), 2500u);
+
+    npu.FailNext(2);
+    EXPECT_FALSE(npu.Invoke(VideoModel()));
+    EXPECT_FALSE(npu.Invoke(VideoModel()));
+    EXPECT_TRUE(npu.Invoke(VideoModel()));
+    EXPECT_EQ(npu.Invocations(), 5u);
+    EXPECT_EQ(npu.NowUs(), 8500u);
+}
+
+TEST(MockNpuBackendTest, ModelsAreBounded)
+{
+    test::MockNpuBackend npu;
+    char models[test::MockNpuBackend::ms_maxModels + 1];
+
+    for (int i = 0; i < test::MockNpuBackend::ms_maxModels; ++i)
+    {
+        EXPECT_EQ(npu.SetInvokeUs(reinterpret_cast<arm::app::Model *>(&models[i]), 100), 0);
+    }
+
+    EXPECT_LT(npu.SetInvokeUs(reinterpret_cast<arm::app::Model *>(&models[test::MockNpuBackend::ms_maxModels]), 100), 0);
+}
+
+/* The highest priority runs first, whatever the submission order */
+TEST_F(NpuSchedulerTest, HigherPriorityFirst)
+{
+    Submit("v1", m_video, 0);
+    Submit("a1", m_audio, 1);
+    Submit("v2", m_video, 2);
+
+    RunAll();
+
+    EXPECT_EQ(m_done, (std::vector<std::string>{"v2", "a1", "v1"}));
+    EXPECT_EQ(m_npu.Invocations(), 3u);
+}
+
+/* Within a priority the earliest deadline runs first, no deadline last, then submission order */
+TEST_F(NpuSchedulerTest, EarliestDeadlineBreaksTies)
+{
+    Submit("none1", m_video, 0);
+    Submit("late", m_video, 0, 50000);
+    Submit("early", m_audio, 0, 20000);
+    Submit("none2", m_audio, 0);
+    Submit("late2", m_audio, 0, 50000);
+    Submit("high", m_video, 1, 90000);
+
+    RunAll();
+
+    EXPECT_EQ(m_done, (std::vector<std::string>{"high", "early", "late", "late2", "none1", "none2"}));
+}
+
+/* A job not started by its deadline expires, uninvoked; one started on it runs */
+TEST_F(NpuSchedulerTest, DeadlineExpiry)
+{
+    Job *audio = Submit("a1", m_audio, 1);
+    Job *onTime = Submit("v1", m_video, 0, 1000);
+    Job *late = Submit("v2", m_video, 0, 999);
+
+    /* The audio job runs first, for 1000 us */
+    EXPECT_TRUE(m_scheduler.RunNext(false));
+    EXPECT_EQ(audio->job.eStatus, eNPU_JOB_DONE);
+
+    EXPECT_TRUE(m_scheduler.RunNext(false));
+    EXPECT_EQ(late->job.eStatus, eNPU_JOB_EXPIRED);
+    EXPECT_EQ(onTime->job.eStatus, eNPU_JOB_DONE);
+    EXPECT_FALSE(m_scheduler.RunNext(false));
+
+    /* Expired jobs are reported before the job run */
+    EXPECT_EQ(m_done, (std::vector<std::string>{"a1", "v2", "v1"}));
+    EXPECT_EQ(m_npu.Invocations(), 2u);
+
+    NpuScheduler::ClientStats stats;
+
+    ASSERT_STREQ(m_scheduler.GetStats(m_video, &stats), "video");
+    EXPECT_EQ(stats.u32Run, 1u);
+    EXPECT_EQ(stats.u32Expired, 1u);
+    EXPECT_EQ(stats.u32Failed, 0u);
+    EXPECT_EQ(stats.u64QueueUsTotal, 1000u);
+    EXPECT_EQ(stats.u64QueueUsMax, 1000u);
+    EXPECT_EQ(stats.u64InvokeUsTotal, 3000u);
+}
+
+/* Expiry takes the time of dispatch, so time passing without inferences counts */
+TEST_F(NpuSchedulerTest, IdleTimeExpires)
+{
+    Job *job = Submit("v1", m_video, 0, 500);
+
+    m_npu.Advance(501);
+
+    EXPECT_TRUE(m_scheduler.RunNext(false));
+    EXPECT_EQ(job->job.eStatus, eNPU_JOB_EXPIRED);
+    EXPECT_EQ(m_npu.Invocations(), 0u);
+}
+
+/* A failed inference is run and reported failed, the next one is unaffected */
+TEST_F(NpuSchedulerTest, FailedInference)
+{
+    Job *first = Submit("v1", m_video, 0);
+    Job *second = Submit("v2", m_video, 0);
+
+    m_npu.FailNext(1);
+    RunAll();
+
+    EXPECT_EQ(first->job.eStatus, eNPU_JOB_FAILED);
+    EXPECT_EQ(second->job.eStatus, eNPU_JOB_DONE);
+
+    NpuScheduler::ClientStats stats;
+
+    ASSERT_NE(m_scheduler.GetStats(m_video, &stats), nullptr);
+    EXPECT_EQ(stats.u32Run, 2u);
+    EXPECT_EQ(stats.u32Failed, 1u);
+    EXPECT_EQ(stats.u64QueueUsTotal, 3000u);
+    EXPECT_EQ(stats.u64QueueUsMax, 3000u);
+    EXPECT_EQ(stats.u64InvokeUsTotal, 6000u);
+}
+
+/* Video and audio interleaved: audio of higher priority goes ahead of the video pending, which still meets its deadlines */
+TEST_F(NpuSchedulerTest, InterleavesClients)
+{
+    Submit("v1", m_video, 0, 4000);
+    Submit("a1", m_audio, 1, 30000);
+    EXPECT_TRUE(m_scheduler.RunNext(false));
+
+    Submit("v2", m_video, 0, 4000);
+    Submit("a2", m_audio, 1, 30000);
+    Submit("v3", m_video, 0);
+    RunAll();
+
+    EXPECT_EQ(m_done, (std::vector<std::string>{"a1", "a2", "v1", "v2", "v3"}));
+
+    NpuScheduler::ClientStats video;
+    NpuScheduler::ClientStats audio;
+
+    ASSERT_NE(m_scheduler.GetStats(m_video, &video), nullptr);
+    ASSERT_NE(m_scheduler.GetStats(m_audio, &audio), nullptr);
+    EXPECT_EQ(video.u32Run, 3u);
+    EXPECT_EQ(video.u32Expired, 0u);
+    EXPECT_EQ(video.u64QueueUsMax, 7000u);
+    EXPECT_EQ(audio.u32Run, 2u);
+    EXPECT_EQ(audio.u64QueueUsMax, 0u);
+}
+
+TEST_F(NpuSchedulerTest, UnknownClients)
+{
+    xNpuJob job{};
+
+    job.client = 2;
+    job.pfnDone = OnJobDone;
+    EXPECT_LT(m_scheduler.Submit(&job), 0);
+
+    job.client = -1;
+    EXPECT_LT(m_scheduler.Submit(&job), 0);
+
+    NpuScheduler::ClientStats stats;
+
+    EXPECT_EQ(m_scheduler.GetStats(2, &stats), nullptr);
+
+    while (m_scheduler.NumClients() < NpuScheduler::ms_maxClients)
+    {
+        EXPECT_GE(m_scheduler.AddClient(VideoModel(), "more"), 0);
+    }
+
+    EXPECT_LT(m_scheduler.AddClient(VideoModel(), "one too many"), 0);
+}
+
+/* The dispatching thread sleeps until a job is submitted from another thread */
+TEST_F(NpuSchedulerTest, DispatcherWaitsForSubmission)
+{
+    std::thread dispatcher([this]()
+    {
+        m_scheduler.RunNext(true);
+    });
+
+    Job *job = Submit("v1", m_video, 0);
+
+    dispatcher.join();
+
+    EXPECT_EQ(job->job.eStatus, eNPU_JOB_DONE);
+    EXPECT_EQ(m_done, (std::vector<std::string>{"v1"}));
+}
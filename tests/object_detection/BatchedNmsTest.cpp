@@ -0,0 +1,196 @@
+/**************************************************************************//**
+ * @file     BatchedNmsTest.cpp
+ * @version  V1.00
+ * @brief    Per-class and class-agnostic non-maximum suppression on
+ *           synthetic boxes and the Pattern images
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "BatchedNms.hpp"
+#include "DetectorPostProcessing.hpp"
+#include "PatternFrames.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using arm::app::object_detection::BasicBatchedNms;
+using arm::app::object_detection::BasicDetectionPool;
+using arm::app::object_detection::DecodeMode;
+using arm::app::object_detection::DetectionResult;
+using arm::app::object_detection::DetectorPostprocessing;
+using arm::app::object_detection::NmsMode;
+
+namespace
+{
+
+constexpr float s_threshold = 0.5f;
+/* Low enough for the Pattern images to hold overlapping boxes of different classes */
+constexpr float s_nms = 0.1f;
+constexpr int s_numClasses = 2;
+
+struct Candidate
+{
+    int x;
+    int y;
+    int w;
+    int h;
+    int cls;
+    float score;
+};
+
+/*
+ * 0 and 1 overlap with different classes, 3 overlaps 0 with the same class,
+ * 2 is apart.
+ */
+const std::vector<Candidate> s_candidates = {
+    {100, 100, 40, 40, 0, 0.9f},
+    {104, 100, 40, 40, 1, 0.8f},
+    {300, 200, 40, 40, 1, 0.7f},
+    {100, 104, 40, 40, 0, 0.6f},
+};
+
+template <typename T>
+T Score(float score);
+
+template <>
+float Score<float>(float score)
+{
+    return score;
+}
+
+template <>
+int32_t Score<int32_t>(float score)
+{
+    return static_cast<int32_t>(score * (1 << 15));
+}
+
+/* Candidates left with a non-zero class score after NMS, by pool index */
+template <typename T>
+std::vector<int> RunNms(NmsMode mode)
+{
+    const int count = static_cast<int>(s_candidates.size());
+    BasicDetectionPool<T> detections(count, s_numClasses);
+    BasicBatchedNms<T> nms(count, s_numClasses);
+
+    for (int n = 0; n < count; ++n)
+    {
+        const Candidate &candidate = s_candidates[n];
+        const int idx = detections.Append();
+        T *prob = detections.Probs(idx);
+
+        detections.SetBox(idx, {static_cast<T>(candidate.x), static_cast<T>(candidate.y),
+                                static_cast<T>(candidate.w), static_cast<T>(candidate.h)});
+        detections.Objectness(idx) = Score<T>(candidate.score);
+        std::fill(prob, prob + s_numClasses, T(0));
+        prob[candidate.cls] = Score<T>(candidate.score);
+        detections.Order()[n] = idx;
+    }
+
+    nms.Run(detections, Score<T>(s_nms), mode);
+
+    std::vector<int> survivors;
+
+    for (int n = 0; n < count; ++n)
+    {
+        const T *prob = detections.Probs(n);
+
+        if (std::any_of(prob, prob + s_numClasses, [](T score) { return score > 0; }))
+        {
+            survivors.push_back(n);
+        }
+    }
+
+    return survivors;
+}
+
+std::vector<DetectionResult> RunPattern(uint32_t image, DecodeMode decodeMode, NmsMode nmsMode)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+    DetectorPostprocessing postProcess(s_threshold, s_nms, numClasses, 0, decodeMode, 128, nmsMode);
+    std::vector<DetectionResult> results;
+
+    postProcess.RunPostProcessing(frames.GetInputRows(), frames.GetInputCols(),
+                                  test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                  frames.GetOutput(image, 0), frames.GetOutput(image, 1), results);
+    return results;
+}
+
+float Iou(const DetectionResult &a, const DetectionResult &b)
+{
+    const int width = std::min(a.m_x0 + a.m_w, b.m_x0 + b.m_w) - std::max(a.m_x0, b.m_x0);
+    const int height = std::min(a.m_y0 + a.m_h, b.m_y0 + b.m_h) - std::max(a.m_y0, b.m_y0);
+
+    if (width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+
+    const float intersection = static_cast<float>(width) * height;
+
+    return intersection / (a.m_w * a.m_h + b.m_w * b.m_h - intersection);
+}
+
+/* Pairs of results overlapping past the NMS threshold, up to pixel rounding */
+int CountOverlaps(const std::vector<DetectionResult> &results)
+{
+    int overlaps = 0;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        for (size_t j = i + 1; j < results.size(); ++j)
+        {
+            if (Iou(results[i], results[j]) > s_nms + 0.02f)
+            {
+                ++overlaps;
+            }
+        }
+    }
+
+    return overlaps;
+}
+
+} /* namespace */
+
+TEST(BatchedNmsTest, PerClassKeepsOverlapsOfOtherClasses)
+{
+    const std::vector<int> expected = {0, 1, 2};
+
+    EXPECT_EQ(RunNms<float>(NmsMode::PerClass), expected);
+    EXPECT_EQ(RunNms<float>(NmsMode::PerClassSorted), expected);
+    EXPECT_EQ(RunNms<int32_t>(NmsMode::PerClass), expected);
+}
+
+TEST(BatchedNmsTest, ClassAgnosticSuppressesOverlapsOfAnyClass)
+{
+    const std::vector<int> expected = {0, 2};
+
+    EXPECT_EQ(RunNms<float>(NmsMode::ClassAgnostic), expected);
+    EXPECT_EQ(RunNms<int32_t>(NmsMode::ClassAgnostic), expected);
+}
+
+/* Per-class results hold boxes of different classes overlapping past the threshold, agnostic ones do not */
+TEST(PatternNmsTest, ClassAgnosticKeepsNoOverlaps)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    for (DecodeMode decodeMode : {DecodeMode::Float, DecodeMode::Int8Prefilter, DecodeMode::FixedPoint})
+    {
+        int overlaps = 0;
+
+        for (uint32_t image = 0; image < 2; ++image)
+        {
+            overlaps += CountOverlaps(RunPattern(image, decodeMode, NmsMode::PerClass));
+
+            const std::vector<DetectionResult> agnostic = RunPattern(image, decodeMode, NmsMode::ClassAgnostic);
+
+            ASSERT_FALSE(agnostic.empty());
+            EXPECT_EQ(CountOverlaps(agnostic), 0) << "image " << image;
+        }
+
+        EXPECT_GT(overlaps, 0);
+    }
+}
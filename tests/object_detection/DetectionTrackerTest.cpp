@@ -0,0 +1,251 @@
+/**************************************************************************//**
+ * @file     DetectionTrackerTest.cpp
+ * @version  V1.00
+ * @brief    DetectionTracker on synthetic box sequences
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "DetectionTracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+using arm::app::object_detection::DetectionResult;
+using arm::app::object_detection::DetectionTracker;
+
+namespace
+{
+
+constexpr int s_frameWidth = 640;
+constexpr int s_frameHeight = 480;
+constexpr int s_maxTracks = 8;
+constexpr int s_maxDetections = 16;
+constexpr int s_boxSize = 40;
+
+/* Object moving right by s_speed pixels per frame */
+constexpr int s_startX = 100;
+constexpr int s_startY = 200;
+constexpr int s_speed = 6;
+
+DetectionResult Box(int x, int y, int cls = 0)
+{
+    return DetectionResult(0.9, x, y, s_boxSize, s_boxSize, cls);
+}
+
+int ObjectX(int frame)
+{
+    return s_startX + s_speed * frame;
+}
+
+std::vector<DetectionResult> Update(DetectionTracker &tracker, std::vector<DetectionResult> detections)
+{
+    tracker.Update(detections);
+    return detections;
+}
+
+std::vector<DetectionResult> Predict(DetectionTracker &tracker)
+{
+    std::vector<DetectionResult> results;
+
+    tracker.Predict(results);
+    return results;
+}
+
+/* The moving object detected on frames 0 to numFrames - 1 */
+void Follow(DetectionTracker &tracker, int numFrames)
+{
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        Update(tracker, {Box(ObjectX(frame), s_startY)});
+    }
+}
+
+void ExpectSameBoxes(const std::vector<DetectionResult> &results, const std::vector<DetectionResult> &expected)
+{
+    ASSERT_EQ(results.size(), expected.size());
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i].m_trackId, expected[i].m_trackId) << "track " << i;
+        EXPECT_EQ(results[i].m_cls, expected[i].m_cls) << "track " << i;
+        EXPECT_EQ(results[i].m_x0, expected[i].m_x0) << "track " << i;
+        EXPECT_EQ(results[i].m_y0, expected[i].m_y0) << "track " << i;
+        EXPECT_EQ(results[i].m_w, expected[i].m_w) << "track " << i;
+        EXPECT_EQ(results[i].m_h, expected[i].m_h) << "track " << i;
+    }
+}
+
+} /* namespace */
+
+/* One track for an object detected frame after frame, which Predict moves on at its speed */
+TEST(DetectionTrackerTest, PredictFollowsConstantVelocity)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        const std::vector<DetectionResult> results = Update(tracker, {Box(ObjectX(frame), s_startY)});
+
+        ASSERT_EQ(results.size(), 1u) << "frame " << frame;
+        EXPECT_EQ(results[0].m_trackId, 0) << "frame " << frame;
+    }
+
+    for (int frame = 10; frame < 14; ++frame)
+    {
+        const std::vector<DetectionResult> results = Predict(tracker);
+
+        ASSERT_EQ(results.size(), 1u) << "frame " << frame;
+        EXPECT_EQ(results[0].m_trackId, 0);
+        EXPECT_LE(std::abs(results[0].m_x0 - ObjectX(frame)), 3) << "frame " << frame;
+        EXPECT_LE(std::abs(results[0].m_y0 - s_startY), 1) << "frame " << frame;
+        EXPECT_LE(std::abs(results[0].m_w - s_boxSize), 1) << "frame " << frame;
+    }
+}
+
+/* Frames dropped unseen move the tracks on as predicted frames do */
+TEST(DetectionTrackerTest, AdvanceMatchesPredict)
+{
+    DetectionTracker predicted(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+    DetectionTracker advanced(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+
+    Follow(predicted, 6);
+    Follow(advanced, 6);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        Predict(predicted);
+    }
+
+    advanced.Advance(3);
+    advanced.Advance(0);
+
+    ExpectSameBoxes(Predict(advanced), Predict(predicted));
+    ExpectSameBoxes(Update(advanced, {Box(ObjectX(10), s_startY)}),
+                    Update(predicted, {Box(ObjectX(10), s_startY)}));
+}
+
+/* Dropped frames advanced over keep the velocity per frame, and the object its track */
+TEST(DetectionTrackerTest, DroppedFramesKeepVelocity)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+
+    Follow(tracker, 8);
+
+    /* Frames 8 and 9 dropped, 10 inferred */
+    tracker.Advance(2);
+
+    std::vector<DetectionResult> results = Update(tracker, {Box(ObjectX(10), s_startY)});
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].m_trackId, 0);
+
+    for (int frame = 11; frame < 14; ++frame)
+    {
+        results = Predict(tracker);
+
+        ASSERT_EQ(results.size(), 1u) << "frame " << frame;
+        EXPECT_LE(std::abs(results[0].m_x0 - ObjectX(frame)), 3) << "frame " << frame;
+    }
+}
+
+/* Overlapping objects of different classes keep their own tracks, in any detection order */
+TEST(DetectionTrackerTest, ClassesAreTrackedApart)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+
+    std::vector<DetectionResult> results = Update(tracker, {Box(100, 100, 0), Box(104, 100, 2)});
+
+    ASSERT_EQ(results.size(), 2u);
+
+    const int person = (results[0].m_cls == 0) ? results[0].m_trackId : results[1].m_trackId;
+    const int car = (results[0].m_cls == 2) ? results[0].m_trackId : results[1].m_trackId;
+
+    EXPECT_NE(person, car);
+
+    for (int frame = 1; frame < 5; ++frame)
+    {
+        results = Update(tracker, {Box(104 + frame, 100, 2), Box(100 - frame, 100, 0)});
+
+        ASSERT_EQ(results.size(), 2u) << "frame " << frame;
+
+        for (const DetectionResult &result : results)
+        {
+            EXPECT_EQ(result.m_trackId, (result.m_cls == 0) ? person : car) << "frame " << frame;
+        }
+    }
+}
+
+/* A track survives maxMisses updates without its detection, then is lost for good */
+TEST(DetectionTrackerTest, MissedDetectionsEndTrack)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight, 0.3f, 2);
+
+    Update(tracker, {Box(100, 100)});
+
+    for (int miss = 1; miss <= 2; ++miss)
+    {
+        const std::vector<DetectionResult> results = Update(tracker, {});
+
+        ASSERT_EQ(results.size(), 1u) << "miss " << miss;
+        EXPECT_EQ(results[0].m_trackId, 0);
+        EXPECT_EQ(results[0].m_x0, 100);
+    }
+
+    EXPECT_TRUE(Update(tracker, {}).empty());
+
+    const std::vector<DetectionResult> results = Update(tracker, {Box(100, 100)});
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].m_trackId, 1);
+}
+
+/* A track is reported from its minHits-th detection */
+TEST(DetectionTrackerTest, MinHitsDelaysReport)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight, 0.3f, 2, 3);
+
+    EXPECT_TRUE(Update(tracker, {Box(ObjectX(0), s_startY)}).empty());
+    EXPECT_TRUE(Update(tracker, {Box(ObjectX(1), s_startY)}).empty());
+    EXPECT_TRUE(Predict(tracker).empty());
+    EXPECT_EQ(Update(tracker, {Box(ObjectX(3), s_startY)}).size(), 1u);
+}
+
+/* Predicted boxes are clipped to the frame, and tracks that leave it are dropped */
+TEST(DetectionTrackerTest, TracksLeavingFrameAreDropped)
+{
+    DetectionTracker tracker(s_maxTracks, s_maxDetections, s_frameWidth, s_frameHeight);
+    const int speed = 20;
+    int x = s_frameWidth - 4 * speed - s_boxSize;
+
+    for (int frame = 0; frame < 4; ++frame, x += speed)
+    {
+        Update(tracker, {Box(x, s_startY)});
+    }
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (const DetectionResult &result : Predict(tracker))
+        {
+            EXPECT_GE(result.m_x0, 0);
+            EXPECT_LE(result.m_x0 + result.m_w, s_frameWidth);
+            EXPECT_GT(result.m_w, 0);
+        }
+    }
+
+    EXPECT_TRUE(Predict(tracker).empty());
+}
+
+/* Detections beyond the free track slots are not tracked */
+TEST(DetectionTrackerTest, TrackSlotsAreBounded)
+{
+    DetectionTracker tracker(2, s_maxDetections, s_frameWidth, s_frameHeight);
+
+    const std::vector<DetectionResult> results = Update(tracker, {Box(0, 0), Box(100, 0), Box(200, 0)});
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].m_x0, 0);
+    EXPECT_EQ(results[1].m_x0, 100);
+}
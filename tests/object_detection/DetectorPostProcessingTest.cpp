@@ -0,0 +1,495 @@
+/**************************************************************************//**
+ * @file     DetectorPostProcessingTest.cpp
+ * @version  V1.00
+ * @brief    DetectorPostprocessing against the list-based post-processing
+ *           on the Pattern images
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "DetectorPostProcessing.hpp"
+#include "PatternFrames.hpp"
+#include "ReferencePostProcessing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+using arm::app::object_detection::ClassMode;
+using arm::app::object_detection::DecodeMode;
+using arm::app::object_detection::DetectionResult;
+using arm::app::object_detection::DetectorPostprocessing;
+using arm::app::object_detection::NmsMode;
+using arm::app::object_detection::YoloDecodeTable;
+
+namespace
+{
+
+constexpr float s_threshold = 0.5f;
+constexpr float s_nms = 0.45f;
+constexpr int s_carClass = 2;
+constexpr int s_maxDetections = 128;
+constexpr bool s_growPool = true;   /* Keep every candidate, as the list did */
+
+struct Config
+{
+    uint32_t image;
+    DecodeMode decodeMode;
+    bool decodeTables;
+    int topN;
+};
+
+std::vector<DetectionResult> RunReference(uint32_t image, int topN)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+    std::vector<DetectionResult> results;
+
+    test::RunReferencePostProcessing(s_threshold, s_nms, numClasses, topN,
+                                     frames.GetInputRows(), frames.GetInputCols(),
+                                     test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                     frames.GetOutput(image, 0), frames.GetOutput(image, 1), results);
+    return results;
+}
+
+std::vector<DetectionResult> RunPostProcessing(DetectorPostprocessing &postProcess, uint32_t image)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+    std::vector<DetectionResult> results;
+
+    postProcess.RunPostProcessing(frames.GetInputRows(), frames.GetInputCols(),
+                                  test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                  frames.GetOutput(image, 0), frames.GetOutput(image, 1), results);
+    return results;
+}
+
+void ExpectSameResults(const std::vector<DetectionResult> &results, const std::vector<DetectionResult> &expected)
+{
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(results.size(), expected.size());
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i].m_cls, expected[i].m_cls) << "result " << i;
+        EXPECT_EQ(results[i].m_normalisedVal, expected[i].m_normalisedVal) << "result " << i;
+        EXPECT_EQ(results[i].m_x0, expected[i].m_x0) << "result " << i;
+        EXPECT_EQ(results[i].m_y0, expected[i].m_y0) << "result " << i;
+        EXPECT_EQ(results[i].m_w, expected[i].m_w) << "result " << i;
+        EXPECT_EQ(results[i].m_h, expected[i].m_h) << "result " << i;
+    }
+}
+
+/* Same objects, boxes within some pixels; score ties may order them differently */
+void ExpectWithinPixels(std::vector<DetectionResult> results, const std::vector<DetectionResult> &expected, int pixels = 1)
+{
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(results.size(), expected.size());
+
+    /* Matched by class and box */
+    for (const DetectionResult &detection : expected)
+    {
+        auto match = std::find_if(results.begin(), results.end(), [&detection, pixels](const DetectionResult &result)
+        {
+            return result.m_cls == detection.m_cls &&
+                   std::abs(result.m_x0 - detection.m_x0) <= pixels &&
+                   std::abs(result.m_y0 - detection.m_y0) <= pixels &&
+                   std::abs((result.m_x0 + result.m_w) - (detection.m_x0 + detection.m_w)) <= pixels &&
+                   std::abs((result.m_y0 + result.m_h) - (detection.m_y0 + detection.m_h)) <= pixels;
+        });
+
+        ASSERT_NE(match, results.end()) << "class " << detection.m_cls
+                                        << " at " << detection.m_x0 << "," << detection.m_y0;
+        EXPECT_NEAR(match->m_normalisedVal, detection.m_normalisedVal, 1e-3);
+
+        results.erase(match);
+    }
+}
+
+class PatternIdentityTest : public ::testing::TestWithParam<Config>
+{
+};
+
+/* Tells whether a class of a box, given its raw class scores, is kept */
+using KeepClass = std::function<bool(const int8_t *scores, int cls)>;
+
+/* Copies of the outputs of a Pattern image, with the raw scores of the classes not kept at the minimum */
+struct ClassOutputs
+{
+    std::vector<int8_t> data[2];
+    TfLiteTensor tensors[2];
+};
+
+void KeepClasses(uint32_t image, const KeepClass &keep, ClassOutputs &outputs)
+{
+    const int boxSize = 5 + numClasses;
+
+    for (size_t output = 0; output < 2; ++output)
+    {
+        const TfLiteTensor *tensor = test::PatternFrames::Get().GetOutput(image, output);
+        std::vector<int8_t> &data = outputs.data[output];
+
+        data.assign(tensor->data.int8, tensor->data.int8 + tensor->bytes);
+
+        /* The dequantized minimum is not above 0, its probability not above 0.5 times the objectness */
+        for (size_t box = 0; box + boxSize <= data.size(); box += boxSize)
+        {
+            const std::vector<int8_t> scores(data.begin() + box + 5, data.begin() + box + boxSize);
+
+            for (int c = 0; c < numClasses; ++c)
+            {
+                if (!keep(scores.data(), c))
+                {
+                    data[box + 5 + c] = std::numeric_limits<int8_t>::min();
+                }
+            }
+        }
+
+        outputs.tensors[output] = *tensor;
+        outputs.tensors[output].data.int8 = data.data();
+    }
+}
+
+/* List-based post-processing of the outputs of a Pattern image, keeping only some classes */
+std::vector<DetectionResult> RunReference(float threshold, uint32_t image, const KeepClass &keep)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+    ClassOutputs outputs;
+    std::vector<DetectionResult> results;
+
+    KeepClasses(image, keep, outputs);
+    test::RunReferencePostProcessing(threshold, s_nms, numClasses, 0,
+                                     frames.GetInputRows(), frames.GetInputCols(),
+                                     test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                     &outputs.tensors[0], &outputs.tensors[1], results);
+    return results;
+}
+
+/* Ordered by class then box, to compare results regardless of the NMS output order */
+std::vector<DetectionResult> Sorted(std::vector<DetectionResult> results)
+{
+    std::sort(results.begin(), results.end(), [](const DetectionResult &a, const DetectionResult &b)
+    {
+        return std::make_tuple(a.m_cls, a.m_x0, a.m_y0, a.m_w, a.m_h) <
+               std::make_tuple(b.m_cls, b.m_x0, b.m_y0, b.m_w, b.m_h);
+    });
+    return results;
+}
+
+struct DecodeConfig
+{
+    DecodeMode decodeMode;
+    bool decodeTables;
+};
+
+class PatternClassTest : public ::testing::TestWithParam<DecodeConfig>
+{
+protected:
+    /* Low enough for boxes with several classes above it */
+    static constexpr float ms_threshold = 0.1f;
+
+    std::vector<DetectionResult> Run(uint32_t image, DecodeMode decodeMode, ClassMode classMode,
+                                     const std::vector<int> &classMask)
+    {
+        DetectorPostprocessing postProcess(ms_threshold, s_nms, numClasses, 0, decodeMode, s_maxDetections,
+                                           NmsMode::PerClass, classMode, classMask, s_growPool);
+        YoloDecodeTable tables[2];
+
+        if (GetParam().decodeTables)
+        {
+            postProcess.SetDecodeTables(&tables[0], &tables[1]);
+        }
+
+        return RunPostProcessing(postProcess, image);
+    }
+
+    /* As the list-based post-processing keeping the same classes, to the bit but for the fixed-point path */
+    void ExpectReference(uint32_t image, const std::vector<DetectionResult> &results, ClassMode classMode,
+                         const std::vector<int> &classMask, const KeepClass &keep)
+    {
+        if (GetParam().decodeMode == DecodeMode::FixedPoint)
+        {
+            ExpectWithinPixels(results, Run(image, DecodeMode::Float, classMode, classMask));
+        }
+        else
+        {
+            ExpectSameResults(results, RunReference(ms_threshold, image, keep));
+        }
+    }
+};
+
+} /* namespace */
+
+TEST(PatternFramesTest, ModelRuns)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+}
+
+TEST(PatternFramesTest, CarIsDetected)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    const std::vector<DetectionResult> results = RunReference(0, 0);
+
+    EXPECT_TRUE(std::any_of(results.begin(), results.end(), [](const DetectionResult &result)
+    {
+        return result.m_cls == s_carClass;
+    }));
+}
+
+/* Same results, in the same order, and the same scores to the bit */
+TEST_P(PatternIdentityTest, MatchesListBasedPostProcessing)
+{
+    const Config config = GetParam();
+
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    DetectorPostprocessing postProcess(s_threshold, s_nms, numClasses, config.topN, config.decodeMode,
+                                       s_maxDetections, NmsMode::PerClass, ClassMode::AllClasses, {}, s_growPool);
+    YoloDecodeTable tables[2];
+
+    if (config.decodeTables)
+    {
+        postProcess.SetDecodeTables(&tables[0], &tables[1]);
+    }
+
+    const std::vector<DetectionResult> expected = RunReference(config.image, config.topN);
+
+    /* Twice, the second time from the prepared network and reused pool */
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        ExpectSameResults(RunPostProcessing(postProcess, config.image), expected);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Pattern, PatternIdentityTest, ::testing::Values(
+    Config {0, DecodeMode::Float, false, 0},
+    Config {1, DecodeMode::Float, false, 0},
+    Config {0, DecodeMode::Float, false, 3},
+    Config {1, DecodeMode::Float, false, 3},
+    Config {0, DecodeMode::Int8Prefilter, false, 0},
+    Config {1, DecodeMode::Int8Prefilter, false, 0},
+    Config {0, DecodeMode::Int8Prefilter, true, 0},
+    Config {1, DecodeMode::Int8Prefilter, true, 0},
+    Config {1, DecodeMode::Int8Prefilter, true, 3}
+));
+
+/* Integer decode and NMS find the same objects, boxes within 1 pixel */
+TEST(PatternFixedPointTest, MatchesFloatWithinOnePixel)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    for (uint32_t image = 0; image < 2; ++image)
+    {
+        DetectorPostprocessing floatPostProcess(s_threshold, s_nms, numClasses, 0, DecodeMode::Float,
+                                                s_maxDetections, NmsMode::PerClass, ClassMode::AllClasses, {},
+                                                s_growPool);
+        DetectorPostprocessing fixedPostProcess(s_threshold, s_nms, numClasses, 0, DecodeMode::FixedPoint,
+                                                s_maxDetections, NmsMode::PerClass, ClassMode::AllClasses, {},
+                                                s_growPool);
+        SCOPED_TRACE(testing::Message() << "image " << image);
+        ExpectWithinPixels(RunPostProcessing(fixedPostProcess, image), RunPostProcessing(floatPostProcess, image));
+    }
+}
+
+/*
+ * A letterboxed input decodes as the plain network input, each box then
+ * mapped back to the original image; within 2 pixels as the plain decode
+ * truncates to network pixels first.
+ */
+TEST(PatternLetterboxTest, MatchesPlainDecodeUnletterboxed)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+    ASSERT_TRUE(frames.IsValid());
+
+    /* A 4:3 image fills the width of the network input, as imlib_nvt_scale_plan_init_letterbox places it */
+    const int imageCols = 320;
+    const int imageRows = 240;
+    const int netCols = static_cast<int>(frames.GetInputCols());
+    const int netRows = static_cast<int>(frames.GetInputRows());
+    const int contentCols = netCols;
+    const int contentRows = (netCols * imageRows + imageCols / 2) / imageCols;
+    const int padCols = (netCols - contentCols) / 2;
+    const int padRows = (netRows - contentRows) / 2;
+
+    ASSERT_GT(padRows, 0);
+
+    for (DecodeMode decodeMode : {DecodeMode::Float, DecodeMode::FixedPoint})
+    {
+        for (uint32_t image = 0; image < 2; ++image)
+        {
+            SCOPED_TRACE(testing::Message() << "mode " << static_cast<int>(decodeMode) << ", image " << image);
+            DetectorPostprocessing letterboxed(s_threshold, s_nms, numClasses, 0, decodeMode, s_maxDetections,
+                                               NmsMode::PerClass, ClassMode::AllClasses, {}, s_growPool);
+            DetectorPostprocessing plain(s_threshold, s_nms, numClasses, 0, decodeMode, s_maxDetections,
+                                         NmsMode::PerClass, ClassMode::AllClasses, {}, s_growPool);
+            std::vector<DetectionResult> results;
+            std::vector<DetectionResult> expected;
+
+            letterboxed.SetLetterbox(padCols, padRows, contentCols, contentRows);
+            letterboxed.RunPostProcessing(netRows, netCols, imageRows, imageCols,
+                                          frames.GetOutput(image, 0), frames.GetOutput(image, 1), results);
+            plain.RunPostProcessing(netRows, netCols, netRows, netCols,
+                                    frames.GetOutput(image, 0), frames.GetOutput(image, 1), expected);
+
+            for (DetectionResult &result : expected)
+            {
+                auto unletterbox = [](int coord, int pad, int imageSize, int contentSize)
+                {
+                    return std::min(std::max((coord - pad) * imageSize / contentSize, 0), imageSize);
+                };
+                const int x0 = unletterbox(result.m_x0, padCols, imageCols, contentCols);
+                const int x1 = unletterbox(result.m_x0 + result.m_w, padCols, imageCols, contentCols);
+                const int y0 = unletterbox(result.m_y0, padRows, imageRows, contentRows);
+                const int y1 = unletterbox(result.m_y0 + result.m_h, padRows, imageRows, contentRows);
+
+                result.m_x0 = x0;
+                result.m_y0 = y0;
+                result.m_w = x1 - x0;
+                result.m_h = y1 - y0;
+            }
+
+            ExpectWithinPixels(results, expected, 2);
+        }
+    }
+}
+
+/* Copies of the outputs decode as the tensors would, leaving the network prepared for the tensors */
+TEST(PatternOutputCopyTest, MatchesTensors)
+{
+    test::PatternFrames &frames = test::PatternFrames::Get();
+
+    ASSERT_TRUE(frames.IsValid());
+
+    for (DecodeMode decodeMode : {DecodeMode::Int8Prefilter, DecodeMode::FixedPoint})
+    {
+        DetectorPostprocessing postProcess(s_threshold, s_nms, numClasses, 0, decodeMode);
+        YoloDecodeTable tables[2];
+
+        postProcess.SetDecodeTables(&tables[0], &tables[1]);
+
+        const std::vector<DetectionResult> expected0 = RunPostProcessing(postProcess, 0);
+        const std::vector<DetectionResult> expected1 = RunPostProcessing(postProcess, 1);
+
+        /* Prepared for the tensors of image 0, decoding copies of those of image 1 */
+        postProcess.InitNetwork(frames.GetInputRows(), frames.GetInputCols(),
+                                frames.GetOutput(0, 0), frames.GetOutput(0, 1));
+
+        const TfLiteTensor *output0 = frames.GetOutput(1, 0);
+        const TfLiteTensor *output1 = frames.GetOutput(1, 1);
+        const std::vector<int8_t> copy0(output0->data.int8, output0->data.int8 + output0->bytes);
+        const std::vector<int8_t> copy1(output1->data.int8, output1->data.int8 + output1->bytes);
+        std::vector<DetectionResult> results;
+
+        postProcess.RunPostProcessing(test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                      copy0.data(), copy1.data(), results);
+        ExpectSameResults(results, expected1);
+
+        results.clear();
+        postProcess.RunPostProcessing(test::PatternFrames::GetImageRows(), test::PatternFrames::GetImageCols(),
+                                      output0->data.int8, output1->data.int8, results);
+        ExpectSameResults(results, expected1);
+
+        ExpectSameResults(RunPostProcessing(postProcess, 0), expected0);
+    }
+}
+
+/* The default pool never grows: once full it keeps the top objectness, as topN would */
+TEST(PatternDetectionPoolTest, FixedByDefault)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    constexpr int maxDetections = 3;
+
+    for (DecodeMode decodeMode : {DecodeMode::Float, DecodeMode::Int8Prefilter, DecodeMode::FixedPoint})
+    {
+        for (uint32_t image = 0; image < 2; ++image)
+        {
+            DetectorPostprocessing fixedPostProcess(s_threshold, s_nms, numClasses, 0, decodeMode, maxDetections);
+            DetectorPostprocessing topNPostProcess(s_threshold, s_nms, numClasses, maxDetections, decodeMode,
+                                                   maxDetections, NmsMode::PerClass, ClassMode::AllClasses, {},
+                                                   s_growPool);
+            DetectorPostprocessing growPostProcess(s_threshold, s_nms, numClasses, 0, decodeMode, maxDetections,
+                                                   NmsMode::PerClass, ClassMode::AllClasses, {}, s_growPool);
+            const std::vector<DetectionResult> all = RunPostProcessing(growPostProcess, image);
+
+            ExpectSameResults(RunPostProcessing(fixedPostProcess, image), RunPostProcessing(topNPostProcess, image));
+            EXPECT_LT(RunPostProcessing(fixedPostProcess, image).size(), all.size());
+
+            if (decodeMode != DecodeMode::FixedPoint)
+            {
+                ExpectSameResults(all, RunReference(image, 0));
+            }
+        }
+    }
+}
+
+/* Only the first class with the best raw score of each box */
+TEST_P(PatternClassTest, BestClassKeepsArgmax)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    const KeepClass argmax = [](const int8_t *scores, int cls)
+    {
+        return std::max_element(scores, scores + numClasses) - scores == cls;
+    };
+    size_t allClasses = 0;
+    size_t bestClass = 0;
+
+    for (uint32_t image = 0; image < 2; ++image)
+    {
+        SCOPED_TRACE(testing::Message() << "image " << image);
+
+        const std::vector<DetectionResult> results = Run(image, GetParam().decodeMode, ClassMode::BestClass, {});
+
+        ExpectReference(image, results, ClassMode::BestClass, {}, argmax);
+
+        allClasses += Run(image, GetParam().decodeMode, ClassMode::AllClasses, {}).size();
+        bestClass += results.size();
+    }
+
+    /* Some boxes had a class other than their best above the threshold */
+    EXPECT_LT(bestClass, allClasses);
+}
+
+/* Only the masked classes, with the boxes they have without a mask */
+TEST_P(PatternClassTest, ClassMaskKeepsMaskedClasses)
+{
+    ASSERT_TRUE(test::PatternFrames::Get().IsValid());
+
+    const std::vector<int> classMask = {0, s_carClass};
+    const KeepClass masked = [&classMask](const int8_t *, int cls)
+    {
+        return std::find(classMask.begin(), classMask.end(), cls) != classMask.end();
+    };
+
+    for (uint32_t image = 0; image < 2; ++image)
+    {
+        SCOPED_TRACE(testing::Message() << "image " << image);
+
+        const std::vector<DetectionResult> results = Run(image, GetParam().decodeMode, ClassMode::AllClasses,
+                                                         classMask);
+        std::vector<DetectionResult> unmasked = Run(image, GetParam().decodeMode, ClassMode::AllClasses, {});
+        const size_t numUnmasked = unmasked.size();
+
+        ExpectReference(image, results, ClassMode::AllClasses, classMask, masked);
+
+        unmasked.erase(std::remove_if(unmasked.begin(), unmasked.end(), [&masked](const DetectionResult &result)
+        {
+            return !masked(nullptr, result.m_cls);
+        }), unmasked.end());
+
+        EXPECT_LT(unmasked.size(), numUnmasked);
+        ExpectSameResults(Sorted(results), Sorted(unmasked));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Pattern, PatternClassTest, ::testing::Values(
+    DecodeConfig {DecodeMode::Float, false},
+    DecodeConfig {DecodeMode::Int8Prefilter, false},
+    DecodeConfig {DecodeMode::Int8Prefilter, true},
+    DecodeConfig {DecodeMode::FixedPoint, true}
+));
@@ -0,0 +1,182 @@
+/**************************************************************************//**
+ * @file     PostProcessingBenchmark.cpp
+ * @version  V1.00
+ * @brief    Per-frame time of the list-based and the pool-based YOLO
+ *           post-processing as the number of candidates grows
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "DetectorPostProcessing.hpp"
+#include "ReferencePostProcessing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using arm::app::object_detection::ClassMode;
+using arm::app::object_detection::DecodeMode;
+using arm::app::object_detection::DetectionResult;
+using arm::app::object_detection::DetectorPostprocessing;
+using arm::app::object_detection::NmsMode;
+
+namespace
+{
+
+constexpr int s_inputSize = 320;
+constexpr int s_numBox = 3;
+constexpr float s_threshold = 0.5f;
+constexpr float s_nms = 0.45f;
+
+/* An output branch quantized as the model's */
+struct Output
+{
+    std::vector<int8_t> data;
+    TfLiteIntArray dims{};
+    TfLiteFloatArray scale{};
+    TfLiteIntArray zeroPoint{};
+    TfLiteAffineQuantization quantization{};
+    TfLiteTensor tensor{};
+
+    Output(int resolution, float scale, int zeroPoint)
+        :   data(resolution * resolution * s_numBox * (5 + numClasses), -128)
+    {
+        dims.size = 4;
+        dims.data[0] = 1;
+        dims.data[1] = resolution;
+        dims.data[2] = resolution;
+        dims.data[3] = s_numBox * (5 + numClasses);
+        this->scale.size = 1;
+        this->scale.data[0] = scale;
+        this->zeroPoint.size = 1;
+        this->zeroPoint.data[0] = zeroPoint;
+        quantization.scale = &this->scale;
+        quantization.zero_point = &this->zeroPoint;
+
+        tensor.type = kTfLiteInt8;
+        tensor.data.int8 = data.data();
+        tensor.dims = &dims;
+        tensor.bytes = data.size();
+        tensor.quantization.type = kTfLiteAffineQuantization;
+        tensor.quantization.params = &quantization;
+    }
+
+    int NumBoxes() const
+    {
+        return static_cast<int>(data.size()) / (5 + numClasses);
+    }
+
+    int8_t Quantize(float value) const
+    {
+        const int q = static_cast<int>(value / scale.data[0]) + zeroPoint.data[0];
+        return static_cast<int8_t>(std::max(-128, std::min(127, q)));
+    }
+
+    /* A box passing the threshold, of one of a few classes */
+    void AddCandidate(int box, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> confidence(1.5f, 4.0f);
+        std::uniform_int_distribution<int> cls(0, 7);
+        int8_t *cell = &data[box * (5 + numClasses)];
+
+        cell[0] = Quantize(offset(rng));
+        cell[1] = Quantize(offset(rng));
+        cell[2] = Quantize(offset(rng) / 4);
+        cell[3] = Quantize(offset(rng) / 4);
+        cell[4] = Quantize(confidence(rng));
+        cell[5 + cls(rng)] = Quantize(confidence(rng));
+    }
+};
+
+template <typename Function>
+double MeasureMicroseconds(int iterations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 50;
+    int failures = 0;
+
+    std::printf("%10s %10s %12s %12s %8s\n", "candidates", "results", "list (us)", "pool (us)", "speedup");
+
+    for (int candidates : {8, 32, 128, 512, 1024})
+    {
+        Output output0(s_inputSize / 32, 0.22045572f, 67);
+        Output output1(s_inputSize / 16, 0.19009549f, 77);
+        std::mt19937 rng(candidates);
+        const int numBoxes = output0.NumBoxes() + output1.NumBoxes();
+        std::vector<int> boxes(numBoxes);
+
+        for (int i = 0; i < numBoxes; ++i)
+        {
+            boxes[i] = i;
+        }
+
+        std::shuffle(boxes.begin(), boxes.end(), rng);
+
+        for (int i = 0; i < candidates; ++i)
+        {
+            if (boxes[i] < output0.NumBoxes())
+            {
+                output0.AddCandidate(boxes[i], rng);
+            }
+            else
+            {
+                output1.AddCandidate(boxes[i] - output0.NumBoxes(), rng);
+            }
+        }
+
+        /* Grown to every candidate, to match the list-based results */
+        DetectorPostprocessing postProcess(s_threshold, s_nms, numClasses, 0, DecodeMode::Float, 128,
+                                           NmsMode::PerClass, ClassMode::AllClasses, {}, true);
+        std::vector<DetectionResult> expected;
+        std::vector<DetectionResult> results;
+
+        const double listTime = MeasureMicroseconds(iterations, [&]()
+        {
+            expected.clear();
+            test::RunReferencePostProcessing(s_threshold, s_nms, numClasses, 0, s_inputSize, s_inputSize,
+                                             s_inputSize, s_inputSize, &output0.tensor, &output1.tensor, expected);
+        });
+
+        const double poolTime = MeasureMicroseconds(iterations, [&]()
+        {
+            results.clear();
+            postProcess.RunPostProcessing(s_inputSize, s_inputSize, s_inputSize, s_inputSize,
+                                          &output0.tensor, &output1.tensor, results);
+        });
+
+        bool same = (results.size() == expected.size());
+
+        for (size_t i = 0; same && i < results.size(); ++i)
+        {
+            same = results[i].m_cls == expected[i].m_cls &&
+                   results[i].m_normalisedVal == expected[i].m_normalisedVal &&
+                   results[i].m_x0 == expected[i].m_x0 && results[i].m_y0 == expected[i].m_y0 &&
+                   results[i].m_w == expected[i].m_w && results[i].m_h == expected[i].m_h;
+        }
+
+        std::printf("%10d %10zu %12.1f %12.1f %7.1fx%s\n", candidates, results.size(), listTime, poolTime,
+                    listTime / poolTime, same ? "" : "  results differ");
+
+        failures += same ? 0 : 1;
+    }
+
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
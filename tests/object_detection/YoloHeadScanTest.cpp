@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ * @file     YoloHeadScanTest.cpp
+ * @version  V1.00
+ * @brief    YOLO output branch scanning kernels against plain loops
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "YoloHeadScan.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using arm::app::object_detection::MaxClassScore;
+using arm::app::object_detection::ScanObjectness;
+
+namespace
+{
+
+/* Box sizes of YOLO-Fastest (3 boxes of 85 bytes per cell) and of others */
+constexpr int s_strides[] = {1, 6, 85, 255, 4369};
+
+std::vector<uint16_t> ExpectedIndices(const std::vector<int8_t> &data, int count, int stride, int8_t cutoff)
+{
+    std::vector<uint16_t> indices;
+
+    for (int n = 0; n < count; ++n)
+    {
+        if (data[n * stride] >= cutoff)
+        {
+            indices.push_back(static_cast<uint16_t>(n));
+        }
+    }
+
+    return indices;
+}
+
+using ScanFunction = int (*)(const int8_t *, int, int, int8_t, uint16_t *);
+using MaxFunction = int8_t (*)(const int8_t *, int);
+
+void CheckScan(ScanFunction scan)
+{
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> value(-128, 127);
+
+    for (int stride : s_strides)
+    {
+        /* Short scans, and the 16-bit index limit */
+        for (int count : {0, 1, 15, 16, 17, 300, 1200, 65536 / stride})
+        {
+            std::vector<int8_t> data(static_cast<size_t>(std::max(count, 1)) * stride);
+            std::vector<uint16_t> indices(std::max(count, 1));
+
+            for (auto &v : data)
+            {
+                v = static_cast<int8_t>(value(rng));
+            }
+
+            for (int cutoff : {-128, -1, 0, 100, 127})
+            {
+                const std::vector<uint16_t> expected = ExpectedIndices(data, count, stride,
+                                                                       static_cast<int8_t>(cutoff));
+                const int num = scan(data.data(), count, stride, static_cast<int8_t>(cutoff), indices.data());
+
+                ASSERT_EQ(num, static_cast<int>(expected.size())) << "stride " << stride << " count " << count;
+                EXPECT_TRUE(std::equal(expected.begin(), expected.end(), indices.begin()))
+                    << "stride " << stride << " count " << count << " cutoff " << cutoff;
+            }
+        }
+    }
+}
+
+void CheckMax(MaxFunction max)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> value(-128, 127);
+
+    for (int numClasses = 0; numClasses <= 100; ++numClasses)
+    {
+        std::vector<int8_t> scores(numClasses + 1);
+
+        for (auto &v : scores)
+        {
+            v = static_cast<int8_t>(value(rng));
+        }
+
+        const int8_t expected = numClasses ? *std::max_element(scores.begin(), scores.begin() + numClasses) :
+                                INT8_MIN;
+
+        ASSERT_EQ(max(scores.data(), numClasses), expected) << "numClasses " << numClasses;
+    }
+}
+
+} /* namespace */
+
+TEST(YoloHeadScanTest, ScanObjectness)
+{
+    CheckScan(ScanObjectness);
+}
+
+TEST(YoloHeadScanTest, MaxClassScore)
+{
+    CheckMax(MaxClassScore);
+}
+
+/* The first and last boxes of a scan are not dropped */
+TEST(YoloHeadScanTest, ScanObjectnessEdges)
+{
+    std::vector<int8_t> data(33 * 85, -128);
+    std::vector<uint16_t> indices(33);
+
+    data[0] = 10;
+    data[16 * 85] = 10;
+    data[32 * 85] = 10;
+
+    ASSERT_EQ(ScanObjectness(data.data(), 33, 85, 10, indices.data()), 3);
+    EXPECT_EQ(indices[0], 0);
+    EXPECT_EQ(indices[1], 16);
+    EXPECT_EQ(indices[2], 32);
+}
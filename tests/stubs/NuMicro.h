@@ -0,0 +1,19 @@
+/**************************************************************************//**
+ * @file     NuMicro.h
+ * @version  V1.00
+ * @brief    Host stand-in for the M55M1 device header, for the host tests.
+ *           Only what the hardware-independent device code needs.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __NUMICRO_H__
+#define __NUMICRO_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* CCAP driver result of a capture that timed out */
+#define CCAP_ERR_TIMEOUT    (-2L)
+
+#endif /* __NUMICRO_H__ */
@@ -0,0 +1,31 @@
+/**************************************************************************//**
+ * @file     arm_math.h
+ * @version  V1.00
+ * @brief    Host stand-in for CMSIS-DSP, for the host tests. Only the CMSIS
+ *           compiler macros and intrinsics imlib.h declares with.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __HOST_ARM_MATH_H__
+#define __HOST_ARM_MATH_H__
+
+#include <stdint.h>
+
+#define __ASM                   __asm__
+#define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+
+typedef float float32_t;
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 %= 32U;
+    return (op2 == 0U) ? op1 : ((op1 >> op2) | (op1 << (32U - op2)));
+}
+
+static inline uint32_t __UXTB16(uint32_t op1)
+{
+    return op1 & 0x00FF00FFU;
+}
+
+#endif /* __HOST_ARM_MATH_H__ */
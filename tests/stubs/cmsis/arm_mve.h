@@ -0,0 +1,642 @@
+/**************************************************************************//**
+ * @file     arm_mve.h
+ * @version  V1.00
+ * @brief    Host emulation of the Helium (MVE) intrinsics imlib_nvt.c uses,
+ *           lane by lane in plain C, for the host tests. Only those
+ *           intrinsics, with the lane types imlib_nvt.c passes them.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __HOST_ARM_MVE_H__
+#define __HOST_ARM_MVE_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct { uint8_t v[16]; } uint8x16_t;
+typedef struct { int8_t v[16]; } int8x16_t;
+typedef struct { uint16_t v[8]; } uint16x8_t;
+typedef struct { int16_t v[8]; } int16x8_t;
+typedef struct { uint32_t v[4]; } uint32x4_t;
+typedef struct { uint16x8_t val[2]; } uint16x8x2_t;
+
+/* One bit per byte of the 128-bit vector, a lane is active if its lowest byte's bit is set */
+typedef uint16_t mve_pred16_t;
+
+#define MVE_LANE8(p, i)     (((p) >> (i)) & 1)
+#define MVE_LANE16(p, i)    (((p) >> (2 * (i))) & 1)
+#define MVE_LANE32(p, i)    (((p) >> (4 * (i))) & 1)
+
+/* Tail predicates */
+
+static inline mve_pred16_t vctp8q(uint32_t n)
+{
+    return (n >= 16) ? 0xFFFF : (mve_pred16_t)((1u << n) - 1);
+}
+
+static inline mve_pred16_t vctp16q(uint32_t n)
+{
+    return (n >= 8) ? 0xFFFF : (mve_pred16_t)((1u << (2 * n)) - 1);
+}
+
+static inline mve_pred16_t vctp32q(uint32_t n)
+{
+    return (n >= 4) ? 0xFFFF : (mve_pred16_t)((1u << (4 * n)) - 1);
+}
+
+/* Vector creation. The first argument is the upper half, as the GCC builds
+ * of imlib_nvt.c (__GNUC__ without __ARMCC_VERSION) pass it */
+
+static inline uint8x16_t vcreateq_u8(uint64_t high, uint64_t low)
+{
+    uint8x16_t r;
+
+    for (int i = 0; i < 8; i++)
+    {
+        r.v[i] = (uint8_t)(low >> (8 * i));
+        r.v[i + 8] = (uint8_t)(high >> (8 * i));
+    }
+
+    return r;
+}
+
+static inline uint16x8_t vdupq_n_u16(uint16_t a)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = a;
+
+    return r;
+}
+
+static inline int16x8_t vdupq_n_s16(int16_t a)
+{
+    int16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = a;
+
+    return r;
+}
+
+static inline uint8x16_t vidupq_n_u8(uint32_t a, int imm)
+{
+    uint8x16_t r;
+
+    for (int i = 0; i < 16; i++)
+        r.v[i] = (uint8_t)(a + i * imm);
+
+    return r;
+}
+
+static inline uint16x8_t vidupq_n_u16(uint32_t a, int imm)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = (uint16_t)(a + i * imm);
+
+    return r;
+}
+
+/* Reinterpretation */
+
+static inline uint8x16_t vreinterpretq_u8_s8(int8x16_t a)
+{
+    uint8x16_t r;
+
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+static inline int16x8_t vreinterpretq_s16_u16(uint16x8_t a)
+{
+    int16x8_t r;
+
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+static inline uint16x8_t vreinterpretq_u16_s16(int16x8_t a)
+{
+    uint16x8_t r;
+
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+/* Contiguous loads and stores, inactive lanes load zero and are not stored */
+
+static inline uint8x16_t vld1q_z_u8(const uint8_t *base, mve_pred16_t p)
+{
+    uint8x16_t r;
+
+    for (int i = 0; i < 16; i++)
+        r.v[i] = MVE_LANE8(p, i) ? base[i] : 0;
+
+    return r;
+}
+
+static inline uint16x8_t vld1q_z_u16(const uint16_t *base, mve_pred16_t p)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = MVE_LANE16(p, i) ? base[i] : 0;
+
+    return r;
+}
+
+static inline uint16x8_t vldrbq_z_u16(const uint8_t *base, mve_pred16_t p)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = MVE_LANE16(p, i) ? base[i] : 0;
+
+    return r;
+}
+
+static inline uint32x4_t vldrhq_z_u32(const uint16_t *base, mve_pred16_t p)
+{
+    uint32x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.v[i] = MVE_LANE32(p, i) ? base[i] : 0;
+
+    return r;
+}
+
+static inline void vst1q_p_u16(uint16_t *base, uint16x8_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 8; i++)
+        if (MVE_LANE16(p, i))
+            base[i] = value.v[i];
+}
+
+static inline void vstrbq_p_u16(uint8_t *base, uint16x8_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 8; i++)
+        if (MVE_LANE16(p, i))
+            base[i] = (uint8_t)value.v[i];
+}
+
+static inline void vstrbq_p_u32(uint8_t *base, uint32x4_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 4; i++)
+        if (MVE_LANE32(p, i))
+            base[i] = (uint8_t)value.v[i];
+}
+
+/* Interleaving store: val[0] to the even elements, val[1] to the odd ones */
+static inline void vst2q_u16(uint16_t *base, uint16x8x2_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        base[2 * i] = value.val[0].v[i];
+        base[2 * i + 1] = value.val[1].v[i];
+    }
+}
+
+/* Gathers and scatters, offsets in bytes unless shifted by the element size */
+
+static inline uint8x16_t vldrbq_gather_offset_u8(const uint8_t *base, uint8x16_t offset)
+{
+    uint8x16_t r;
+
+    for (int i = 0; i < 16; i++)
+        r.v[i] = base[offset.v[i]];
+
+    return r;
+}
+
+#define vldrbq_gather_offset(base, offset)  vldrbq_gather_offset_u8((base), (offset))
+
+static inline int8x16_t vldrbq_gather_offset_z_s8(const int8_t *base, uint8x16_t offset, mve_pred16_t p)
+{
+    int8x16_t r;
+
+    for (int i = 0; i < 16; i++)
+        r.v[i] = MVE_LANE8(p, i) ? base[offset.v[i]] : 0;
+
+    return r;
+}
+
+static inline uint16x8_t vldrbq_gather_offset_z_u16(const uint8_t *base, uint16x8_t offset, mve_pred16_t p)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = MVE_LANE16(p, i) ? base[offset.v[i]] : 0;
+
+    return r;
+}
+
+static inline int16x8_t vldrbq_gather_offset_z_s16(const int8_t *base, uint16x8_t offset, mve_pred16_t p)
+{
+    int16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = MVE_LANE16(p, i) ? base[offset.v[i]] : 0;
+
+    return r;
+}
+
+static inline uint16x8_t vldrhq_gather_shifted_offset_z_u16(const uint16_t *base, uint16x8_t offset, mve_pred16_t p)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = MVE_LANE16(p, i) ? base[offset.v[i]] : 0;
+
+    return r;
+}
+
+static inline uint32x4_t vldrwq_gather_shifted_offset_z_u32(const uint32_t *base, uint32x4_t offset, mve_pred16_t p)
+{
+    uint32x4_t r;
+
+    for (int i = 0; i < 4; i++)
+        r.v[i] = MVE_LANE32(p, i) ? base[offset.v[i]] : 0;
+
+    return r;
+}
+
+static inline void vstrbq_scatter_offset_u8(uint8_t *base, uint8x16_t offset, uint8x16_t value)
+{
+    for (int i = 0; i < 16; i++)
+        base[offset.v[i]] = value.v[i];
+}
+
+#define vstrbq_scatter_offset(base, offset, value)  vstrbq_scatter_offset_u8((base), (offset), (value))
+
+static inline void vstrbq_scatter_offset_p_u8(uint8_t *base, uint8x16_t offset, uint8x16_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 16; i++)
+        if (MVE_LANE8(p, i))
+            base[offset.v[i]] = value.v[i];
+}
+
+static inline void vstrbq_scatter_offset_p_u16(uint8_t *base, uint16x8_t offset, uint16x8_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 8; i++)
+        if (MVE_LANE16(p, i))
+            base[offset.v[i]] = (uint8_t)value.v[i];
+}
+
+static inline void vstrbq_scatter_offset_p_s16(int8_t *base, uint16x8_t offset, int16x8_t value, mve_pred16_t p)
+{
+    for (int i = 0; i < 8; i++)
+        if (MVE_LANE16(p, i))
+            base[offset.v[i]] = (int8_t)value.v[i];
+}
+
+/* Widening: the bottom (even) or top (odd) 8-bit lanes to 16 bits */
+
+static inline uint16x8_t vmovlbq_u8(uint8x16_t a)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = a.v[2 * i];
+
+    return r;
+}
+
+static inline uint16x8_t vmovltq_u8(uint8x16_t a)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = a.v[2 * i + 1];
+
+    return r;
+}
+
+static inline uint16x8_t vshllbq_n_u8(uint8x16_t a, int imm)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = (uint16_t)(a.v[2 * i] << imm);
+
+    return r;
+}
+
+static inline uint16x8_t vshlltq_n_u8(uint8x16_t a, int imm)
+{
+    uint16x8_t r;
+
+    for (int i = 0; i < 8; i++)
+        r.v[i] = (uint16_t)(a.v[2 * i + 1] << imm);
+
+    return r;
+}
+
+#define vmovlbq(a)          vmovlbq_u8(a)
+#define vmovltq(a)          vmovltq_u8(a)
+#define vshllbq(a, imm)     vshllbq_n_u8((a), (imm))
+#define vshlltq(a, imm)     vshlltq_n_u8((a), (imm))
+
+/* Shifts */
+
+static inline uint8x16_t vshrq_n_u8(uint8x16_t a, int imm)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] = (uint8_t)(a.v[i] >> imm);
+
+    return a;
+}
+
+static inline uint16x8_t vshrq_n_u16(uint16x8_t a, int imm)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] >> imm);
+
+    return a;
+}
+
+static inline uint32x4_t vshrq_n_u32(uint32x4_t a, int imm)
+{
+    for (int i = 0; i < 4; i++)
+        a.v[i] >>= imm;
+
+    return a;
+}
+
+static inline uint8x16_t vshlq_n_u8(uint8x16_t a, int imm)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] = (uint8_t)(a.v[i] << imm);
+
+    return a;
+}
+
+static inline uint16x8_t vshlq_n_u16(uint16x8_t a, int imm)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] << imm);
+
+    return a;
+}
+
+/* Shift b left and insert it above the low imm bits of a */
+static inline uint16x8_t vsliq_n_u16(uint16x8_t a, uint16x8_t b, int imm)
+{
+    const uint16_t keep = (uint16_t)((1u << imm) - 1);
+
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)((a.v[i] & keep) | (b.v[i] << imm));
+
+    return a;
+}
+
+/* Shift b right and insert it below the high imm bits of a */
+static inline uint16x8_t vsriq_n_u16(uint16x8_t a, uint16x8_t b, int imm)
+{
+    const uint16_t keep = (uint16_t)~(0xFFFFu >> imm);
+
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)((a.v[i] & keep) | (b.v[i] >> imm));
+
+    return a;
+}
+
+#define vshrq(a, imm) _Generic((a), \
+    uint8x16_t: vshrq_n_u8, \
+    uint16x8_t: vshrq_n_u16, \
+    uint32x4_t: vshrq_n_u32)((a), (imm))
+
+#define vshlq_n(a, imm) _Generic((a), \
+    uint8x16_t: vshlq_n_u8, \
+    uint16x8_t: vshlq_n_u16)((a), (imm))
+
+#define vsliq(a, b, imm)    vsliq_n_u16((a), (b), (imm))
+#define vsriq(a, b, imm)    vsriq_n_u16((a), (b), (imm))
+
+/* Bitwise */
+
+static inline uint8x16_t vorrq_u8(uint8x16_t a, uint8x16_t b)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] |= b.v[i];
+
+    return a;
+}
+
+static inline uint16x8_t vorrq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] |= b.v[i];
+
+    return a;
+}
+
+static inline uint8x16_t vandq_u8(uint8x16_t a, uint8x16_t b)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] &= b.v[i];
+
+    return a;
+}
+
+static inline uint16x8_t vandq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] &= b.v[i];
+
+    return a;
+}
+
+#define vorrq(a, b) _Generic((a), \
+    uint8x16_t: vorrq_u8, \
+    uint16x8_t: vorrq_u16)((a), (b))
+
+#define vandq(a, b) _Generic((a), \
+    uint8x16_t: vandq_u8, \
+    uint16x8_t: vandq_u16)((a), (b))
+
+/* Arithmetic, wrapping unless saturating */
+
+static inline uint16x8_t vaddq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] + b.v[i]);
+
+    return a;
+}
+
+static inline uint16x8_t vaddq_n_u16(uint16x8_t a, uint16_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] + b);
+
+    return a;
+}
+
+static inline uint32x4_t vaddq_n_u32(uint32x4_t a, uint32_t b)
+{
+    for (int i = 0; i < 4; i++)
+        a.v[i] += b;
+
+    return a;
+}
+
+static inline int16x8_t vaddq_s16(int16x8_t a, int16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (int16_t)(a.v[i] + b.v[i]);
+
+    return a;
+}
+
+static inline uint16x8_t vsubq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] - b.v[i]);
+
+    return a;
+}
+
+static inline uint32x4_t vsubq_u32(uint32x4_t a, uint32x4_t b)
+{
+    for (int i = 0; i < 4; i++)
+        a.v[i] -= b.v[i];
+
+    return a;
+}
+
+static inline int16x8_t vsubq_s16(int16x8_t a, int16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (int16_t)(a.v[i] - b.v[i]);
+
+    return a;
+}
+
+static inline int16x8_t vsubq_n_s16(int16x8_t a, int16_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (int16_t)(a.v[i] - b);
+
+    return a;
+}
+
+static inline uint8x16_t vmulq_n_u8(uint8x16_t a, uint8_t b)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] = (uint8_t)(a.v[i] * b);
+
+    return a;
+}
+
+static inline uint16x8_t vmulq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] * b.v[i]);
+
+    return a;
+}
+
+static inline uint16x8_t vmulq_n_u16(uint16x8_t a, uint16_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] * b);
+
+    return a;
+}
+
+static inline uint32x4_t vmulq_u32(uint32x4_t a, uint32x4_t b)
+{
+    for (int i = 0; i < 4; i++)
+        a.v[i] *= b.v[i];
+
+    return a;
+}
+
+/* a + b * c */
+static inline uint16x8_t vmlaq_u16(uint16x8_t a, uint16x8_t b, uint16x8_t c)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] + b.v[i] * c.v[i]);
+
+    return a;
+}
+
+static inline uint16x8_t vmlaq_n_u16(uint16x8_t a, uint16x8_t b, uint16_t c)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(a.v[i] + b.v[i] * c);
+
+    return a;
+}
+
+/* High half of the rounded product */
+static inline uint16x8_t vrmulhq_u16(uint16x8_t a, uint16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (uint16_t)(((uint32_t)a.v[i] * b.v[i] + 0x8000u) >> 16);
+
+    return a;
+}
+
+/* High half of the rounded doubled product, saturated */
+static inline int16x8_t vqrdmulhq_n_s16(int16x8_t a, int16_t b)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        int32_t product = (2 * (int32_t)a.v[i] * b + 0x8000) >> 16;
+
+        a.v[i] = (int16_t)((product > INT16_MAX) ? INT16_MAX : product);
+    }
+
+    return a;
+}
+
+static inline uint8x16_t vabdq_u8(uint8x16_t a, uint8x16_t b)
+{
+    for (int i = 0; i < 16; i++)
+        a.v[i] = (uint8_t)((a.v[i] > b.v[i]) ? (a.v[i] - b.v[i]) : (b.v[i] - a.v[i]));
+
+    return a;
+}
+
+static inline int16x8_t vmaxq_s16(int16x8_t a, int16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i];
+
+    return a;
+}
+
+static inline int16x8_t vminq_s16(int16x8_t a, int16x8_t b)
+{
+    for (int i = 0; i < 8; i++)
+        a.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i];
+
+    return a;
+}
+
+/* Comparison: predicate of the active lanes where a > b, unsigned */
+static inline mve_pred16_t vcmphiq_m_n_u8(uint8x16_t a, uint8_t b, mve_pred16_t p)
+{
+    mve_pred16_t r = 0;
+
+    for (int i = 0; i < 16; i++)
+        if (MVE_LANE8(p, i) && (a.v[i] > b))
+            r |= (mve_pred16_t)(1u << i);
+
+    return r;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_ARM_MVE_H__ */
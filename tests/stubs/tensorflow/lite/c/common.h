@@ -0,0 +1,87 @@
+/**************************************************************************//**
+ * @file     common.h
+ * @version  V1.00
+ * @brief    Host stand-in for the TensorFlow Lite C types used by the
+ *           application, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef TENSORFLOW_LITE_C_COMMON_H_
+#define TENSORFLOW_LITE_C_COMMON_H_
+
+#include <cstddef>
+#include <cstdint>
+
+typedef enum
+{
+    kTfLiteOk = 0,
+    kTfLiteError = 1
+} TfLiteStatus;
+
+typedef enum
+{
+    kTfLiteNoType = 0,
+    kTfLiteFloat32 = 1,
+    kTfLiteInt32 = 2,
+    kTfLiteInt8 = 9
+} TfLiteType;
+
+typedef enum
+{
+    kTfLiteNoQuantization = 0,
+    kTfLiteAffineQuantization = 1
+} TfLiteQuantizationType;
+
+/* Fixed size, where TensorFlow Lite has a flexible array member */
+typedef struct
+{
+    int size;
+    int data[8];
+} TfLiteIntArray;
+
+typedef struct
+{
+    int size;
+    float data[8];
+} TfLiteFloatArray;
+
+typedef struct
+{
+    TfLiteFloatArray *scale;
+    TfLiteIntArray *zero_point;
+    int32_t quantized_dimension;
+} TfLiteAffineQuantization;
+
+typedef struct
+{
+    TfLiteQuantizationType type;
+    void *params;
+} TfLiteQuantization;
+
+typedef struct
+{
+    float scale;
+    int32_t zero_point;
+} TfLiteQuantizationParams;
+
+typedef union
+{
+    int32_t *i32;
+    int8_t *int8;
+    uint8_t *uint8;
+    float *f;
+    void *data;
+} TfLitePtrUnion;
+
+typedef struct
+{
+    TfLiteType type;
+    TfLitePtrUnion data;
+    TfLiteIntArray *dims;
+    TfLiteQuantizationParams params;
+    size_t bytes;
+    TfLiteQuantization quantization;
+} TfLiteTensor;
+
+#endif /* TENSORFLOW_LITE_C_COMMON_H_ */
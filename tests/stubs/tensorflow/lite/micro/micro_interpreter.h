@@ -0,0 +1,27 @@
+/**************************************************************************//**
+ * @file     micro_interpreter.h
+ * @version  V1.00
+ * @brief    Host stand-in for the TensorFlow Lite Micro interpreter, for the
+ *           host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_INTERPRETER_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_INTERPRETER_H_
+
+#include "tensorflow/lite/c/common.h"
+
+#include <memory>
+#include <vector>
+
+namespace tflite
+{
+
+class MicroAllocator;
+class MicroInterpreter;
+struct Model;
+
+} /* namespace tflite */
+
+#endif /* TENSORFLOW_LITE_MICRO_MICRO_INTERPRETER_H_ */
@@ -0,0 +1,31 @@
+/**************************************************************************//**
+ * @file     micro_mutable_op_resolver.h
+ * @version  V1.00
+ * @brief    Host stand-in for the TensorFlow Lite Micro op resolver, for the
+ *           host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_MUTABLE_OP_RESOLVER_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_MUTABLE_OP_RESOLVER_H_
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite
+{
+
+class MicroOpResolver
+{
+public:
+    virtual ~MicroOpResolver() = default;
+};
+
+template <unsigned int tOpCount>
+class MicroMutableOpResolver : public MicroOpResolver
+{
+};
+
+} /* namespace tflite */
+
+#endif /* TENSORFLOW_LITE_MICRO_MICRO_MUTABLE_OP_RESOLVER_H_ */
@@ -0,0 +1,15 @@
+/**************************************************************************//**
+ * @file     schema_utils.h
+ * @version  V1.00
+ * @brief    Host stand-in for the TensorFlow Lite header of the same name,
+ *           for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef TENSORFLOW_LITE_SCHEMA_SCHEMA_UTILS_H_
+#define TENSORFLOW_LITE_SCHEMA_SCHEMA_UTILS_H_
+
+#include "tensorflow/lite/c/common.h"
+
+#endif /* TENSORFLOW_LITE_SCHEMA_SCHEMA_UTILS_H_ */
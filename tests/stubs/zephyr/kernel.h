@@ -0,0 +1,256 @@
+/**************************************************************************//**
+ * @file     kernel.h
+ * @version  V1.00
+ * @brief    Host stand-in for the Zephyr kernel objects the application uses,
+ *           on POSIX threads, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef __HOST_ZEPHYR_KERNEL_H__
+#define __HOST_ZEPHYR_KERNEL_H__
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARG_UNUSED(x) (void)(x)
+
+/* Timeouts, in milliseconds */
+typedef struct
+{
+    int64_t ms;
+} k_timeout_t;
+
+static inline k_timeout_t K_MSEC(int64_t ms)
+{
+    k_timeout_t timeout = { ms };
+    return timeout;
+}
+
+#define K_FOREVER   K_MSEC(-1)
+#define K_NO_WAIT   K_MSEC(0)
+
+/* Semaphores */
+#define K_SEM_MAX_LIMIT 0xFFFFFFFFU
+
+struct k_sem
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned int count;
+    unsigned int limit;
+};
+
+#define K_SEM_DEFINE(name, initial_count, count_limit) \
+    struct k_sem name = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, (initial_count), (count_limit) }
+
+static inline int k_sem_init(struct k_sem *sem, unsigned int initial_count, unsigned int limit)
+{
+    pthread_mutex_init(&sem->mutex, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->count = initial_count;
+    sem->limit = limit;
+    return 0;
+}
+
+static inline void k_sem_give(struct k_sem *sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+
+    if (sem->count < sem->limit)
+        sem->count++;
+
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static inline int k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+{
+    struct timespec deadline;
+    int result = 0;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    if (timeout.ms > 0)
+    {
+        deadline.tv_sec += (time_t)(timeout.ms / 1000);
+        deadline.tv_nsec += (long)(timeout.ms % 1000) * 1000000L;
+
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&sem->mutex);
+
+    while (sem->count == 0 && result == 0)
+    {
+        if (timeout.ms == 0)
+            result = -EBUSY;
+        else if (timeout.ms < 0)
+            pthread_cond_wait(&sem->cond, &sem->mutex);
+        else if (pthread_cond_timedwait(&sem->cond, &sem->mutex, &deadline) == ETIMEDOUT)
+            result = (sem->count == 0) ? -EAGAIN : 0;
+    }
+
+    if (result == 0)
+        sem->count--;
+
+    pthread_mutex_unlock(&sem->mutex);
+    return result;
+}
+
+static inline void k_sem_reset(struct k_sem *sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    sem->count = 0;
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static inline unsigned int k_sem_count_get(struct k_sem *sem)
+{
+    unsigned int count;
+
+    pthread_mutex_lock(&sem->mutex);
+    count = sem->count;
+    pthread_mutex_unlock(&sem->mutex);
+    return count;
+}
+
+/* Mutexes, recursive as Zephyr's */
+struct k_mutex
+{
+    pthread_mutex_t mutex;
+};
+
+static inline int k_mutex_init(struct k_mutex *mutex)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return 0;
+}
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+    (void)timeout;
+    return pthread_mutex_lock(&mutex->mutex);
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex)
+{
+    return pthread_mutex_unlock(&mutex->mutex);
+}
+
+/* FIFOs, linked through the first word of each item as Zephyr's */
+struct k_fifo
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    void *head;
+    void *tail;
+};
+
+#define K_FIFO_DEFINE(name) \
+    struct k_fifo name = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL }
+
+static inline void k_fifo_init(struct k_fifo *fifo)
+{
+    pthread_mutex_init(&fifo->mutex, NULL);
+    pthread_cond_init(&fifo->cond, NULL);
+    fifo->head = NULL;
+    fifo->tail = NULL;
+}
+
+static inline void k_fifo_put(struct k_fifo *fifo, void *data)
+{
+    pthread_mutex_lock(&fifo->mutex);
+
+    *(void **)data = NULL;
+
+    if (fifo->tail)
+        *(void **)fifo->tail = data;
+    else
+        fifo->head = data;
+
+    fifo->tail = data;
+    pthread_cond_signal(&fifo->cond);
+    pthread_mutex_unlock(&fifo->mutex);
+}
+
+static inline void *k_fifo_get(struct k_fifo *fifo, k_timeout_t timeout)
+{
+    struct timespec deadline;
+    void *data;
+    int result = 0;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    if (timeout.ms > 0)
+    {
+        deadline.tv_sec += (time_t)(timeout.ms / 1000);
+        deadline.tv_nsec += (long)(timeout.ms % 1000) * 1000000L;
+
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&fifo->mutex);
+
+    while (fifo->head == NULL && result == 0)
+    {
+        if (timeout.ms == 0)
+            result = -EBUSY;
+        else if (timeout.ms < 0)
+            pthread_cond_wait(&fifo->cond, &fifo->mutex);
+        else if (pthread_cond_timedwait(&fifo->cond, &fifo->mutex, &deadline) == ETIMEDOUT)
+            result = -EAGAIN;
+    }
+
+    data = fifo->head;
+
+    if (data)
+    {
+        fifo->head = *(void **)data;
+
+        if (fifo->head == NULL)
+            fifo->tail = NULL;
+    }
+
+    pthread_mutex_unlock(&fifo->mutex);
+    return data;
+}
+
+/* Uptime, one tick per microsecond */
+static inline int64_t k_uptime_ticks(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static inline uint64_t k_ticks_to_us_floor64(uint64_t ticks)
+{
+    return ticks;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_ZEPHYR_KERNEL_H__ */
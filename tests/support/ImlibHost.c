@@ -0,0 +1,20 @@
+/**************************************************************************//**
+ * @file     ImlibHost.c
+ * @version  V1.00
+ * @brief    The imlib.c function imlib_nvt.c calls, imlib.c itself pulling
+ *           in the whole library
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "imlib.h"
+
+/* As imlib.c */
+uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v)
+{
+    uint32_t r = IM_MAX(IM_MIN(y + ((91881 * v) >> 16), COLOR_R8_MAX), COLOR_R8_MIN);
+    uint32_t g = IM_MAX(IM_MIN(y - (((22554 * u) + (46802 * v)) >> 16), COLOR_G8_MAX), COLOR_G8_MIN);
+    uint32_t b = IM_MAX(IM_MIN(y + ((116130 * u) >> 16), COLOR_B8_MAX), COLOR_B8_MIN);
+
+    return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
+}
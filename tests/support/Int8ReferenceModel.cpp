@@ -0,0 +1,757 @@
+/**************************************************************************//**
+ * @file     Int8ReferenceModel.cpp
+ * @version  V1.00
+ * @brief    Reference int8 interpreter of the YOLO-Fastest TensorFlow Lite
+ *           model, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "Int8ReferenceModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace test
+{
+
+namespace
+{
+
+/* Builtin operator codes of the tflite schema */
+constexpr int s_opAdd = 0;
+constexpr int s_opConcatenation = 2;
+constexpr int s_opConv2D = 3;
+constexpr int s_opDepthwiseConv2D = 4;
+constexpr int s_opPad = 34;
+constexpr int s_opResizeNearestNeighbor = 97;
+constexpr int s_opLeakyRelu = 98;
+
+/* Tensor types of the tflite schema */
+constexpr int s_typeFloat32 = 0;
+constexpr int s_typeInt32 = 2;
+constexpr int s_typeInt8 = 9;
+
+template <typename T>
+T Read(const uint8_t *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/* A flatbuffer table, read in place */
+struct Table
+{
+    const uint8_t *pos{nullptr};
+
+    explicit operator bool() const
+    {
+        return pos != nullptr;
+    }
+
+    const uint8_t *Field(int id) const
+    {
+        if (!pos)
+        {
+            return nullptr;
+        }
+
+        const uint8_t *vtable = pos - Read<int32_t>(pos);
+        const uint16_t vtableSize = Read<uint16_t>(vtable);
+
+        if (4 + 2 * id >= vtableSize)
+        {
+            return nullptr;
+        }
+
+        const uint16_t offset = Read<uint16_t>(vtable + 4 + 2 * id);
+        return offset ? pos + offset : nullptr;
+    }
+
+    template <typename T>
+    T Scalar(int id, T defaultValue) const
+    {
+        const uint8_t *field = Field(id);
+        return field ? Read<T>(field) : defaultValue;
+    }
+
+    Table Child(int id) const
+    {
+        const uint8_t *field = Field(id);
+        return Table {field ? field + Read<uint32_t>(field) : nullptr};
+    }
+
+    /* Element data and count of a vector field */
+    const uint8_t *Vector(int id, uint32_t &count) const
+    {
+        const uint8_t *field = Field(id);
+        count = 0;
+
+        if (!field)
+        {
+            return nullptr;
+        }
+
+        const uint8_t *vector = field + Read<uint32_t>(field);
+        count = Read<uint32_t>(vector);
+        return vector + 4;
+    }
+
+    Table Element(int id, uint32_t index) const
+    {
+        uint32_t count;
+        const uint8_t *data = Vector(id, count);
+        const uint8_t *element = data + 4 * index;
+        return Table {element + Read<uint32_t>(element)};
+    }
+
+    std::vector<int> Ints(int id) const
+    {
+        uint32_t count;
+        const uint8_t *data = Vector(id, count);
+        std::vector<int> values(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            values[i] = Read<int32_t>(data + 4 * i);
+        }
+
+        return values;
+    }
+};
+
+/* gemmlowp rounding, as in TensorFlow Lite */
+int32_t SaturatingRoundingDoublingHighMul(int32_t a, int32_t b)
+{
+    const bool overflow = (a == b) && (a == std::numeric_limits<int32_t>::min());
+    const int64_t ab = static_cast<int64_t>(a) * b;
+    const int32_t nudge = (ab >= 0) ? (1 << 30) : (1 - (1 << 30));
+    const int32_t high = static_cast<int32_t>((ab + nudge) / (1LL << 31));
+
+    return overflow ? std::numeric_limits<int32_t>::max() : high;
+}
+
+int32_t RoundingDivideByPOT(int32_t x, int exponent)
+{
+    const int32_t mask = static_cast<int32_t>((1LL << exponent) - 1);
+    const int32_t remainder = x & mask;
+    const int32_t threshold = (mask >> 1) + ((x < 0) ? 1 : 0);
+
+    return (x >> exponent) + ((remainder > threshold) ? 1 : 0);
+}
+
+int32_t MultiplyByQuantizedMultiplier(int32_t x, int32_t multiplier, int shift)
+{
+    const int leftShift = (shift > 0) ? shift : 0;
+    const int rightShift = (shift > 0) ? 0 : -shift;
+
+    return RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(x * (1 << leftShift), multiplier), rightShift);
+}
+
+void QuantizeMultiplier(double real, int32_t &multiplier, int &shift)
+{
+    if (real == 0.0)
+    {
+        multiplier = 0;
+        shift = 0;
+        return;
+    }
+
+    const double q = std::frexp(real, &shift);
+    int64_t fixed = static_cast<int64_t>(std::round(q * (1LL << 31)));
+
+    if (fixed == (1LL << 31))
+    {
+        fixed /= 2;
+        ++shift;
+    }
+
+    if (shift < -31)
+    {
+        shift = 0;
+        fixed = 0;
+    }
+
+    multiplier = static_cast<int32_t>(fixed);
+}
+
+/* Padding before the first output, as ComputePaddingHeightWidth */
+int Padding(int padding, int stride, int dilation, int inSize, int filterSize, int outSize)
+{
+    if (padding != 0)
+    {
+        return 0;
+    }
+
+    const int effectiveFilter = (filterSize - 1) * dilation + 1;
+    const int total = (outSize - 1) * stride + effectiveFilter - inSize;
+
+    return std::max(total, 0) / 2;
+}
+
+int32_t Clamp(int32_t value, int32_t min, int32_t max)
+{
+    return std::min(std::max(value, min), max);
+}
+
+} /* namespace */
+
+int Int8ReferenceModel::Tensor::Size() const
+{
+    int size = 1;
+
+    for (int dim : shape)
+    {
+        size *= dim;
+    }
+
+    return size;
+}
+
+const int8_t *Int8ReferenceModel::Tensor::Int8() const
+{
+    return constData ? reinterpret_cast<const int8_t *>(constData) : data.data();
+}
+
+int32_t Int8ReferenceModel::Tensor::Int32(int index) const
+{
+    return Read<int32_t>(constData + 4 * index);
+}
+
+Int8ReferenceModel::Int8ReferenceModel(const uint8_t *model, size_t size)
+    :   m_buffer(model),
+        m_size(size)
+{
+    m_valid = Parse();
+}
+
+bool Int8ReferenceModel::IsValid() const
+{
+    return m_valid;
+}
+
+TfLiteTensor *Int8ReferenceModel::GetInputTensor(size_t index)
+{
+    return (m_valid && index < m_inputs.size()) ? &m_tensors[m_inputs[index]].tflite : nullptr;
+}
+
+TfLiteTensor *Int8ReferenceModel::GetOutputTensor(size_t index)
+{
+    return (m_valid && index < m_outputs.size()) ? &m_tensors[m_outputs[index]].tflite : nullptr;
+}
+
+bool Int8ReferenceModel::Parse()
+{
+    if (!m_buffer || m_size < 8)
+    {
+        return false;
+    }
+
+    const Table model {m_buffer + Read<uint32_t>(m_buffer)};
+    const Table subgraph = model.Element(2, 0);
+    uint32_t numCodes, numTensors, numOperators, numBuffers;
+
+    model.Vector(1, numCodes);
+    model.Vector(4, numBuffers);
+    subgraph.Vector(0, numTensors);
+    subgraph.Vector(3, numOperators);
+
+    std::vector<int> codes(numCodes);
+
+    for (uint32_t i = 0; i < numCodes; ++i)
+    {
+        const Table code = model.Element(1, i);
+
+        /* Codes from 127 on are only in builtin_code */
+        codes[i] = std::max<int>(code.Scalar<int8_t>(0, 0), code.Scalar<int32_t>(3, 0));
+    }
+
+    m_tensors.resize(numTensors);
+
+    for (uint32_t i = 0; i < numTensors; ++i)
+    {
+        const Table tensor = subgraph.Element(0, i);
+        const Table quantization = tensor.Child(4);
+        Tensor &t = m_tensors[i];
+        uint32_t count;
+
+        t.shape = tensor.Ints(0);
+
+        switch (tensor.Scalar<int8_t>(1, s_typeFloat32))
+        {
+            case s_typeInt8:
+                t.type = kTfLiteInt8;
+                break;
+            case s_typeInt32:
+                t.type = kTfLiteInt32;
+                break;
+            default:
+                return false;
+        }
+
+        const float *scale = reinterpret_cast<const float *>(quantization.Vector(2, count));
+
+        for (uint32_t k = 0; k < count; ++k)
+        {
+            t.scale.push_back(Read<float>(reinterpret_cast<const uint8_t *>(scale + k)));
+        }
+
+        const uint8_t *zeroPoint = quantization.Vector(3, count);
+
+        for (uint32_t k = 0; k < count; ++k)
+        {
+            t.zeroPoint.push_back(static_cast<int32_t>(Read<int64_t>(zeroPoint + 8 * k)));
+        }
+
+        const uint32_t buffer = tensor.Scalar<uint32_t>(2, 0);
+
+        if (buffer < numBuffers)
+        {
+            t.constData = model.Element(4, buffer).Vector(0, count);
+        }
+
+        if (!t.constData)
+        {
+            t.data.resize(t.Size());
+        }
+    }
+
+    for (uint32_t i = 0; i < numOperators; ++i)
+    {
+        const Table op = subgraph.Element(3, i);
+        const Table options = op.Child(4);
+        Operator o;
+
+        o.inputs = op.Ints(1);
+        o.outputs = op.Ints(2);
+
+        switch (codes.at(op.Scalar<uint32_t>(0, 0)))
+        {
+            case s_opAdd:
+                o.code = OpCode::Add;
+                o.activation = options.Scalar<int8_t>(0, 0);
+                break;
+            case s_opConcatenation:
+                o.code = OpCode::Concatenation;
+                o.axis = options.Scalar<int32_t>(0, 0);
+                o.activation = options.Scalar<int8_t>(1, 0);
+                break;
+            case s_opConv2D:
+                o.code = OpCode::Conv2D;
+                o.padding = options.Scalar<int8_t>(0, 0);
+                o.strideW = options.Scalar<int32_t>(1, 1);
+                o.strideH = options.Scalar<int32_t>(2, 1);
+                o.activation = options.Scalar<int8_t>(3, 0);
+                o.dilationW = options.Scalar<int32_t>(4, 1);
+                o.dilationH = options.Scalar<int32_t>(5, 1);
+                break;
+            case s_opDepthwiseConv2D:
+                o.code = OpCode::DepthwiseConv2D;
+                o.padding = options.Scalar<int8_t>(0, 0);
+                o.strideW = options.Scalar<int32_t>(1, 1);
+                o.strideH = options.Scalar<int32_t>(2, 1);
+                o.depthMultiplier = options.Scalar<int32_t>(3, 1);
+                o.activation = options.Scalar<int8_t>(4, 0);
+                o.dilationW = options.Scalar<int32_t>(5, 1);
+                o.dilationH = options.Scalar<int32_t>(6, 1);
+                break;
+            case s_opLeakyRelu:
+                o.code = OpCode::LeakyRelu;
+                o.alpha = options.Scalar<float>(0, 0.2f);
+                break;
+            case s_opPad:
+                o.code = OpCode::Pad;
+                break;
+            case s_opResizeNearestNeighbor:
+                o.code = OpCode::ResizeNearestNeighbor;
+                o.alignCorners = options.Scalar<uint8_t>(0, 0) != 0;
+                o.halfPixelCenters = options.Scalar<uint8_t>(1, 0) != 0;
+                break;
+            default:
+                return false;
+        }
+
+        m_operators.push_back(o);
+    }
+
+    m_inputs = subgraph.Ints(1);
+    m_outputs = subgraph.Ints(2);
+
+    for (int index : m_inputs)
+    {
+        Publish(m_tensors[index]);
+    }
+
+    for (int index : m_outputs)
+    {
+        Publish(m_tensors[index]);
+    }
+
+    return true;
+}
+
+void Int8ReferenceModel::Publish(Tensor &tensor)
+{
+    tensor.dims.size = static_cast<int>(tensor.shape.size());
+    std::copy(tensor.shape.begin(), tensor.shape.end(), tensor.dims.data);
+
+    tensor.scaleArray.size = 1;
+    tensor.scaleArray.data[0] = tensor.scale.empty() ? 0.0f : tensor.scale[0];
+    tensor.zeroPointArray.size = 1;
+    tensor.zeroPointArray.data[0] = tensor.zeroPoint.empty() ? 0 : tensor.zeroPoint[0];
+    tensor.affine.scale = &tensor.scaleArray;
+    tensor.affine.zero_point = &tensor.zeroPointArray;
+
+    tensor.tflite.type = kTfLiteInt8;
+    tensor.tflite.data.int8 = tensor.data.data();
+    tensor.tflite.dims = &tensor.dims;
+    tensor.tflite.params.scale = tensor.scaleArray.data[0];
+    tensor.tflite.params.zero_point = tensor.zeroPointArray.data[0];
+    tensor.tflite.bytes = tensor.data.size();
+    tensor.tflite.quantization.type = kTfLiteAffineQuantization;
+    tensor.tflite.quantization.params = &tensor.affine;
+}
+
+void Int8ReferenceModel::Invoke()
+{
+    for (const Operator &op : m_operators)
+    {
+        switch (op.code)
+        {
+            case OpCode::Add:
+                RunAdd(op);
+                break;
+            case OpCode::Concatenation:
+                RunConcatenation(op);
+                break;
+            case OpCode::Conv2D:
+                RunConv2D(op);
+                break;
+            case OpCode::DepthwiseConv2D:
+                RunDepthwiseConv2D(op);
+                break;
+            case OpCode::LeakyRelu:
+                RunLeakyRelu(op);
+                break;
+            case OpCode::Pad:
+                RunPad(op);
+                break;
+            case OpCode::ResizeNearestNeighbor:
+                RunResizeNearestNeighbor(op);
+                break;
+        }
+    }
+}
+
+void Int8ReferenceModel::ActivationRange(const Operator &op, const Tensor &output, int32_t &min, int32_t &max) const
+{
+    const float scale = output.scale[0];
+    const int32_t zeroPoint = output.zeroPoint[0];
+
+    min = std::numeric_limits<int8_t>::min();
+    max = std::numeric_limits<int8_t>::max();
+
+    if (op.activation == 1 || op.activation == 3)
+    {
+        min = std::max(min, zeroPoint);
+    }
+
+    if (op.activation == 3)
+    {
+        max = std::min(max, zeroPoint + static_cast<int32_t>(std::round(6.0f / scale)));
+    }
+}
+
+void Int8ReferenceModel::RunAdd(const Operator &op)
+{
+    const Tensor &in1 = m_tensors[op.inputs[0]];
+    const Tensor &in2 = m_tensors[op.inputs[1]];
+    Tensor &out = m_tensors[op.outputs[0]];
+    const int leftShift = 20;
+    const double twiceMaxScale = 2 * static_cast<double>(std::max(in1.scale[0], in2.scale[0]));
+    int32_t multiplier1, multiplier2, multiplierOut;
+    int shift1, shift2, shiftOut;
+    int32_t min, max;
+
+    QuantizeMultiplier(in1.scale[0] / twiceMaxScale, multiplier1, shift1);
+    QuantizeMultiplier(in2.scale[0] / twiceMaxScale, multiplier2, shift2);
+    QuantizeMultiplier(twiceMaxScale / ((1 << leftShift) * static_cast<double>(out.scale[0])), multiplierOut, shiftOut);
+    ActivationRange(op, out, min, max);
+
+    const int8_t *a = in1.Int8();
+    const int8_t *b = in2.Int8();
+
+    for (int i = 0; i < out.Size(); ++i)
+    {
+        const int32_t shiftedA = (a[i] - in1.zeroPoint[0]) * (1 << leftShift);
+        const int32_t shiftedB = (b[i] - in2.zeroPoint[0]) * (1 << leftShift);
+        const int32_t sum = RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(shiftedA, multiplier1), -shift1) +
+                            RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(shiftedB, multiplier2), -shift2);
+        const int32_t value = RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(sum, multiplierOut), -shiftOut) +
+                              out.zeroPoint[0];
+
+        out.data[i] = static_cast<int8_t>(Clamp(value, min, max));
+    }
+}
+
+void Int8ReferenceModel::RunConcatenation(const Operator &op)
+{
+    Tensor &out = m_tensors[op.outputs[0]];
+    const int rank = static_cast<int>(out.shape.size());
+    const int axis = (op.axis < 0) ? op.axis + rank : op.axis;
+    int outer = 1;
+    int inner = 1;
+
+    for (int d = 0; d < axis; ++d)
+    {
+        outer *= out.shape[d];
+    }
+
+    for (int d = axis + 1; d < rank; ++d)
+    {
+        inner *= out.shape[d];
+    }
+
+    int8_t *dst = out.data.data();
+
+    /* All inputs share the output quantization, as TensorFlow Lite requires for int8 */
+    for (int o = 0; o < outer; ++o)
+    {
+        for (int index : op.inputs)
+        {
+            const Tensor &in = m_tensors[index];
+            const int chunk = in.shape[axis] * inner;
+
+            std::memcpy(dst, in.Int8() + o * chunk, chunk);
+            dst += chunk;
+        }
+    }
+}
+
+void Int8ReferenceModel::RunConv2D(const Operator &op)
+{
+    const Tensor &in = m_tensors[op.inputs[0]];
+    const Tensor &filter = m_tensors[op.inputs[1]];
+    const Tensor *bias = (op.inputs.size() > 2 && op.inputs[2] >= 0) ? &m_tensors[op.inputs[2]] : nullptr;
+    Tensor &out = m_tensors[op.outputs[0]];
+
+    const int inH = in.shape[1], inW = in.shape[2], inC = in.shape[3];
+    const int outH = out.shape[1], outW = out.shape[2], outC = out.shape[3];
+    const int filterH = filter.shape[1], filterW = filter.shape[2];
+    const int padH = Padding(op.padding, op.strideH, op.dilationH, inH, filterH, outH);
+    const int padW = Padding(op.padding, op.strideW, op.dilationW, inW, filterW, outW);
+    const int32_t inOffset = -in.zeroPoint[0];
+    std::vector<int32_t> multiplier(outC);
+    std::vector<int> shift(outC);
+    int32_t min, max;
+
+    for (int c = 0; c < outC; ++c)
+    {
+        const float filterScale = filter.scale[(filter.scale.size() > 1) ? c : 0];
+        QuantizeMultiplier(static_cast<double>(in.scale[0]) * filterScale / out.scale[0], multiplier[c], shift[c]);
+    }
+
+    ActivationRange(op, out, min, max);
+
+    const int8_t *src = in.Int8();
+    const int8_t *weights = filter.Int8();
+
+    for (int y = 0; y < outH; ++y)
+    {
+        for (int x = 0; x < outW; ++x)
+        {
+            for (int c = 0; c < outC; ++c)
+            {
+                int32_t acc = 0;
+
+                for (int fy = 0; fy < filterH; ++fy)
+                {
+                    const int inY = y * op.strideH - padH + fy * op.dilationH;
+
+                    if (inY < 0 || inY >= inH)
+                    {
+                        continue;
+                    }
+
+                    for (int fx = 0; fx < filterW; ++fx)
+                    {
+                        const int inX = x * op.strideW - padW + fx * op.dilationW;
+
+                        if (inX < 0 || inX >= inW)
+                        {
+                            continue;
+                        }
+
+                        const int8_t *pixel = src + (inY * inW + inX) * inC;
+                        const int8_t *w = weights + ((c * filterH + fy) * filterW + fx) * inC;
+
+                        for (int k = 0; k < inC; ++k)
+                        {
+                            acc += (pixel[k] + inOffset) * w[k];
+                        }
+                    }
+                }
+
+                if (bias)
+                {
+                    acc += bias->Int32(c);
+                }
+
+                acc = MultiplyByQuantizedMultiplier(acc, multiplier[c], shift[c]) + out.zeroPoint[0];
+                out.data[(y * outW + x) * outC + c] = static_cast<int8_t>(Clamp(acc, min, max));
+            }
+        }
+    }
+}
+
+void Int8ReferenceModel::RunDepthwiseConv2D(const Operator &op)
+{
+    const Tensor &in = m_tensors[op.inputs[0]];
+    const Tensor &filter = m_tensors[op.inputs[1]];
+    const Tensor *bias = (op.inputs.size() > 2 && op.inputs[2] >= 0) ? &m_tensors[op.inputs[2]] : nullptr;
+    Tensor &out = m_tensors[op.outputs[0]];
+
+    const int inH = in.shape[1], inW = in.shape[2], inC = in.shape[3];
+    const int outH = out.shape[1], outW = out.shape[2], outC = out.shape[3];
+    const int filterH = filter.shape[1], filterW = filter.shape[2];
+    const int padH = Padding(op.padding, op.strideH, op.dilationH, inH, filterH, outH);
+    const int padW = Padding(op.padding, op.strideW, op.dilationW, inW, filterW, outW);
+    const int32_t inOffset = -in.zeroPoint[0];
+    std::vector<int32_t> multiplier(outC);
+    std::vector<int> shift(outC);
+    int32_t min, max;
+
+    for (int c = 0; c < outC; ++c)
+    {
+        const float filterScale = filter.scale[(filter.scale.size() > 1) ? c : 0];
+        QuantizeMultiplier(static_cast<double>(in.scale[0]) * filterScale / out.scale[0], multiplier[c], shift[c]);
+    }
+
+    ActivationRange(op, out, min, max);
+
+    const int8_t *src = in.Int8();
+    const int8_t *weights = filter.Int8();
+
+    for (int y = 0; y < outH; ++y)
+    {
+        for (int x = 0; x < outW; ++x)
+        {
+            for (int c = 0; c < outC; ++c)
+            {
+                const int inChannel = c / op.depthMultiplier;
+                int32_t acc = 0;
+
+                for (int fy = 0; fy < filterH; ++fy)
+                {
+                    const int inY = y * op.strideH - padH + fy * op.dilationH;
+
+                    if (inY < 0 || inY >= inH)
+                    {
+                        continue;
+                    }
+
+                    for (int fx = 0; fx < filterW; ++fx)
+                    {
+                        const int inX = x * op.strideW - padW + fx * op.dilationW;
+
+                        if (inX < 0 || inX >= inW)
+                        {
+                            continue;
+                        }
+
+                        acc += (src[(inY * inW + inX) * inC + inChannel] + inOffset) *
+                               weights[(fy * filterW + fx) * outC + c];
+                    }
+                }
+
+                if (bias)
+                {
+                    acc += bias->Int32(c);
+                }
+
+                acc = MultiplyByQuantizedMultiplier(acc, multiplier[c], shift[c]) + out.zeroPoint[0];
+                out.data[(y * outW + x) * outC + c] = static_cast<int8_t>(Clamp(acc, min, max));
+            }
+        }
+    }
+}
+
+void Int8ReferenceModel::RunLeakyRelu(const Operator &op)
+{
+    const Tensor &in = m_tensors[op.inputs[0]];
+    Tensor &out = m_tensors[op.outputs[0]];
+    int32_t multiplierAlpha, multiplierIdentity;
+    int shiftAlpha, shiftIdentity;
+
+    QuantizeMultiplier(static_cast<double>(in.scale[0] * op.alpha / out.scale[0]), multiplierAlpha, shiftAlpha);
+    QuantizeMultiplier(static_cast<double>(in.scale[0] / out.scale[0]), multiplierIdentity, shiftIdentity);
+
+    const int8_t *src = in.Int8();
+
+    for (int i = 0; i < out.Size(); ++i)
+    {
+        const int32_t value = src[i] - in.zeroPoint[0];
+        const int32_t scaled = (value >= 0) ? MultiplyByQuantizedMultiplier(value, multiplierIdentity, shiftIdentity) :
+                               MultiplyByQuantizedMultiplier(value, multiplierAlpha, shiftAlpha);
+
+        out.data[i] = static_cast<int8_t>(Clamp(scaled + out.zeroPoint[0], std::numeric_limits<int8_t>::min(),
+                                                std::numeric_limits<int8_t>::max()));
+    }
+}
+
+void Int8ReferenceModel::RunPad(const Operator &op)
+{
+    const Tensor &in = m_tensors[op.inputs[0]];
+    const Tensor &paddings = m_tensors[op.inputs[1]];
+    Tensor &out = m_tensors[op.outputs[0]];
+    const int inH = in.shape[1], inW = in.shape[2], inC = in.shape[3];
+    const int outW = out.shape[2];
+    const int top = paddings.Int32(2);
+    const int left = paddings.Int32(4);
+
+    /* Batch and channels are never padded by the model */
+    std::fill(out.data.begin(), out.data.end(), static_cast<int8_t>(out.zeroPoint[0]));
+
+    for (int y = 0; y < inH; ++y)
+    {
+        std::memcpy(&out.data[((y + top) * outW + left) * inC], in.Int8() + y * inW * inC, inW * inC);
+    }
+}
+
+void Int8ReferenceModel::RunResizeNearestNeighbor(const Operator &op)
+{
+    const Tensor &in = m_tensors[op.inputs[0]];
+    Tensor &out = m_tensors[op.outputs[0]];
+    const int inH = in.shape[1], inW = in.shape[2], channels = in.shape[3];
+    const int outH = out.shape[1], outW = out.shape[2];
+    const float offset = op.halfPixelCenters ? 0.5f : 0.0f;
+    const float scaleH = (op.alignCorners && outH > 1) ? (inH - 1) / static_cast<float>(outH - 1) :
+                         inH / static_cast<float>(outH);
+    const float scaleW = (op.alignCorners && outW > 1) ? (inW - 1) / static_cast<float>(outW - 1) :
+                         inW / static_cast<float>(outW);
+
+    auto nearest = [&](int value, int size, float scale)
+    {
+        const float position = (value + offset) * scale;
+        int index = std::min(static_cast<int>(op.alignCorners ? std::round(position) : std::floor(position)), size - 1);
+
+        return op.halfPixelCenters ? std::max(0, index) : index;
+    };
+
+    for (int y = 0; y < outH; ++y)
+    {
+        const int inY = nearest(y, inH, scaleH);
+
+        for (int x = 0; x < outW; ++x)
+        {
+            const int inX = nearest(x, inW, scaleW);
+
+            std::memcpy(&out.data[(y * outW + x) * channels], in.Int8() + (inY * inW + inX) * channels, channels);
+        }
+    }
+}
+
+} /* namespace test */
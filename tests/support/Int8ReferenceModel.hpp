@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @file     Int8ReferenceModel.hpp
+ * @version  V1.00
+ * @brief    Reference int8 interpreter of the YOLO-Fastest TensorFlow Lite
+ *           model, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef INT8_REFERENCE_MODEL_HPP
+#define INT8_REFERENCE_MODEL_HPP
+
+#include "tensorflow/lite/c/common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace test
+{
+
+/**
+ * @brief   Runs a fully int8 quantized TensorFlow Lite model on the host with
+ *          the integer reference kernels of TensorFlow Lite: PAD, CONV_2D,
+ *          DEPTHWISE_CONV_2D, ADD, LEAKY_RELU, RESIZE_NEAREST_NEIGHBOR and
+ *          CONCATENATION, which are all YOLO-Fastest needs. The flatbuffer
+ *          is read in place, nothing beyond the tflite schema is required.
+ */
+class Int8ReferenceModel
+{
+public:
+    /**
+     * @brief       Constructor. Parses the model, IsValid tells the outcome.
+     * @param[in]   model   TensorFlow Lite flatbuffer.
+     * @param[in]   size    Size of the flatbuffer in bytes.
+     **/
+    Int8ReferenceModel(const uint8_t *model, size_t size);
+
+    /** @brief  Tells whether the model was parsed and all its ops are supported. */
+    bool IsValid() const;
+
+    /** @brief  Gets the input tensor of given index, to be filled before Invoke. */
+    TfLiteTensor *GetInputTensor(size_t index);
+
+    /** @brief  Gets the output tensor of given index, valid after Invoke. */
+    TfLiteTensor *GetOutputTensor(size_t index);
+
+    /** @brief  Runs all operators in order. */
+    void Invoke();
+
+private:
+    enum class OpCode
+    {
+        Add,
+        Concatenation,
+        Conv2D,
+        DepthwiseConv2D,
+        LeakyRelu,
+        Pad,
+        ResizeNearestNeighbor
+    };
+
+    struct Tensor
+    {
+        std::vector<int> shape;
+        TfLiteType type{kTfLiteNoType};
+        std::vector<float> scale;       /* Per channel, or one */
+        std::vector<int32_t> zeroPoint; /* Per channel, or one */
+        const uint8_t *constData{nullptr}; /* Into the flatbuffer, for weights */
+        std::vector<int8_t> data;       /* Activations */
+
+        /* Stand-in handed to the application, for inputs and outputs */
+        TfLiteTensor tflite{};
+        TfLiteIntArray dims{};
+        TfLiteFloatArray scaleArray{};
+        TfLiteIntArray zeroPointArray{};
+        TfLiteAffineQuantization affine{};
+
+        int Size() const;
+        const int8_t *Int8() const;
+        int32_t Int32(int index) const;
+    };
+
+    struct Operator
+    {
+        OpCode code;
+        std::vector<int> inputs;
+        std::vector<int> outputs;
+        int padding{0};         /* 0: SAME, 1: VALID */
+        int strideW{1};
+        int strideH{1};
+        int dilationW{1};
+        int dilationH{1};
+        int depthMultiplier{1};
+        int activation{0};      /* 0: none, 1: RELU, 3: RELU6 */
+        float alpha{0};
+        int axis{0};
+        bool alignCorners{false};
+        bool halfPixelCenters{false};
+    };
+
+    const uint8_t *m_buffer;
+    size_t m_size;
+    bool m_valid{false};
+    std::vector<Tensor> m_tensors;
+    std::vector<Operator> m_operators;
+    std::vector<int> m_inputs;
+    std::vector<int> m_outputs;
+
+    bool Parse();
+    void Publish(Tensor &tensor);
+
+    void RunAdd(const Operator &op);
+    void RunConcatenation(const Operator &op);
+    void RunConv2D(const Operator &op);
+    void RunDepthwiseConv2D(const Operator &op);
+    void RunLeakyRelu(const Operator &op);
+    void RunPad(const Operator &op);
+    void RunResizeNearestNeighbor(const Operator &op);
+
+    /* Output range of a fused activation */
+    void ActivationRange(const Operator &op, const Tensor &output, int32_t &min, int32_t &max) const;
+};
+
+} /* namespace test */
+
+#endif /* INT8_REFERENCE_MODEL_HPP */
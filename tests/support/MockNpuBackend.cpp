@@ -0,0 +1,72 @@
+/**************************************************************************//**
+ * @file     MockNpuBackend.cpp
+ * @version  V1.00
+ * @brief    Simulated NPU and clock behind NpuScheduler, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "MockNpuBackend.hpp"
+
+namespace test
+{
+
+int MockNpuBackend::SetInvokeUs(const arm::app::Model *model, uint64_t invokeUs)
+{
+    for (int i = 0; i < m_numModels; i++)
+    {
+        if (m_models[i] == model)
+        {
+            m_invokeUs[i] = invokeUs;
+            return 0;
+        }
+    }
+
+    if (m_numModels == ms_maxModels)
+        return -1;
+
+    m_models[m_numModels] = model;
+    m_invokeUs[m_numModels] = invokeUs;
+    m_numModels++;
+
+    return 0;
+}
+
+void MockNpuBackend::Advance(uint64_t us)
+{
+    m_nowUs += us;
+}
+
+void MockNpuBackend::FailNext(int count)
+{
+    m_failNext = count;
+}
+
+bool MockNpuBackend::Invoke(arm::app::Model *model)
+{
+    for (int i = 0; i < m_numModels; i++)
+    {
+        if (m_models[i] == model)
+        {
+            m_nowUs += m_invokeUs[i];
+            break;
+        }
+    }
+
+    m_invocations++;
+
+    if (m_failNext > 0)
+    {
+        m_failNext--;
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t MockNpuBackend::NowUs()
+{
+    return m_nowUs;
+}
+
+} /* namespace test */
@@ -0,0 +1,67 @@
+/**************************************************************************//**
+ * @file     MockNpuBackend.hpp
+ * @version  V1.00
+ * @brief    Simulated NPU and clock behind NpuScheduler, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef MOCK_NPU_BACKEND_HPP
+#define MOCK_NPU_BACKEND_HPP
+
+#include "NpuScheduler.hpp"
+
+namespace test
+{
+
+/*
+ * No NPU: each inference takes the time set for its model on a simulated
+ * clock, and the models are never touched, so that the scheduling policy
+ * runs on the host with any model pointers.
+ */
+class MockNpuBackend : public NpuBackend
+{
+public:
+    static constexpr int ms_maxModels = 8;
+
+    /**
+     * @brief       Set how long an inference of a model takes.
+     * @param[in]   model      Model.
+     * @param[in]   invokeUs   Inference time.
+     * @return      0 on success, <0 if ms_maxModels models have a time set already.
+     */
+    int SetInvokeUs(const arm::app::Model *model, uint64_t invokeUs);
+
+    /**
+     * @brief       Let time pass without inferences, e.g. until the next submission.
+     * @param[in]   us   Microseconds.
+     */
+    void Advance(uint64_t us);
+
+    /**
+     * @brief       Fail the next inferences.
+     * @param[in]   count   Inferences to fail.
+     */
+    void FailNext(int count);
+
+    /** @brief      Inferences run, failed ones included. */
+    uint32_t Invocations() const
+    {
+        return m_invocations;
+    }
+
+    bool Invoke(arm::app::Model *model) override;
+    uint64_t NowUs() override;
+
+private:
+    const arm::app::Model *m_models[ms_maxModels];
+    uint64_t m_invokeUs[ms_maxModels];
+    int m_numModels{0};
+    uint64_t m_nowUs{0};
+    int m_failNext{0};
+    uint32_t m_invocations{0};
+};
+
+} /* namespace test */
+
+#endif /* MOCK_NPU_BACKEND_HPP */
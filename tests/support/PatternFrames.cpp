@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ * @file     PatternFrames.cpp
+ * @version  V1.00
+ * @brief    Model outputs of the baked-in Pattern images, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "PatternFrames.hpp"
+
+#include "InputFiles.hpp"
+
+#include <vector>
+
+namespace arm
+{
+namespace app
+{
+namespace yolofastest
+{
+extern const uint8_t *GetModelPointer();
+extern size_t GetModelLen();
+} /* namespace yolofastest */
+} /* namespace app */
+} /* namespace arm */
+
+namespace test
+{
+
+/* Copy of an output tensor, the model reuses its own for the next image */
+struct PatternFrames::Frame
+{
+    std::vector<int8_t> data[2];
+    TfLiteTensor tensors[2];
+};
+
+PatternFrames &PatternFrames::Get()
+{
+    static PatternFrames frames;
+    return frames;
+}
+
+PatternFrames::PatternFrames()
+    :   m_model(new Int8ReferenceModel(arm::app::yolofastest::GetModelPointer(),
+                                       arm::app::yolofastest::GetModelLen()))
+{
+    if (!m_model->IsValid())
+    {
+        return;
+    }
+
+    TfLiteTensor *input = m_model->GetInputTensor(0);
+    const int rows = input->dims->data[1];
+    const int cols = input->dims->data[2];
+
+    for (uint32_t index = 0; index < NUMBER_OF_FILES; ++index)
+    {
+        const uint8_t *image = get_img_array(index);
+
+        /* Nearest scaling as NVT_SCALE_NEAREST, then uint8 to int8 */
+        for (int y = 0; y < rows; ++y)
+        {
+            const int srcY = y * IMAGE_HEIGHT / rows;
+
+            for (int x = 0; x < cols; ++x)
+            {
+                const int srcX = x * IMAGE_WIDTH / cols;
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    input->data.int8[(y * cols + x) * 3 + c] =
+                        static_cast<int8_t>(image[(srcY * IMAGE_WIDTH + srcX) * 3 + c] - 128);
+                }
+            }
+        }
+
+        m_model->Invoke();
+
+        m_frames[index].reset(new Frame);
+
+        for (size_t output = 0; output < 2; ++output)
+        {
+            const TfLiteTensor *tensor = m_model->GetOutputTensor(output);
+            Frame &frame = *m_frames[index];
+
+            frame.data[output].assign(tensor->data.int8, tensor->data.int8 + tensor->bytes);
+            frame.tensors[output] = *tensor;
+            frame.tensors[output].data.int8 = frame.data[output].data();
+        }
+    }
+}
+
+bool PatternFrames::IsValid() const
+{
+    return m_model->IsValid();
+}
+
+TfLiteTensor *PatternFrames::GetOutput(uint32_t index, size_t output)
+{
+    return &m_frames[index]->tensors[output];
+}
+
+uint32_t PatternFrames::GetImageRows()
+{
+    return IMAGE_HEIGHT;
+}
+
+uint32_t PatternFrames::GetImageCols()
+{
+    return IMAGE_WIDTH;
+}
+
+uint32_t PatternFrames::GetInputRows() const
+{
+    return static_cast<uint32_t>(m_model->GetInputTensor(0)->dims->data[1]);
+}
+
+uint32_t PatternFrames::GetInputCols() const
+{
+    return static_cast<uint32_t>(m_model->GetInputTensor(0)->dims->data[2]);
+}
+
+} /* namespace test */
@@ -0,0 +1,57 @@
+/**************************************************************************//**
+ * @file     PatternFrames.hpp
+ * @version  V1.00
+ * @brief    Model outputs of the baked-in Pattern images, for the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef PATTERN_FRAMES_HPP
+#define PATTERN_FRAMES_HPP
+
+#include "Int8ReferenceModel.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace test
+{
+
+/**
+ * @brief   Runs YOLO-Fastest on a Pattern image (car, dinner) the way the
+ *          application feeds it: scaled nearest to the model input and
+ *          converted to int8. Every image is inferred once per process, the
+ *          outputs are kept for all tests.
+ */
+class PatternFrames
+{
+public:
+    /** @brief  Gets the frames, inferring on first use. */
+    static PatternFrames &Get();
+
+    /** @brief  Tells whether the model could be run. */
+    bool IsValid() const;
+
+    /** @brief  Gets output tensor 0 or 1 of Pattern image index. */
+    TfLiteTensor *GetOutput(uint32_t index, size_t output);
+
+    /** @brief  Pattern image size, the source image of post-processing. */
+    static uint32_t GetImageRows();
+    static uint32_t GetImageCols();
+
+    /** @brief  Model input size. */
+    uint32_t GetInputRows() const;
+    uint32_t GetInputCols() const;
+
+private:
+    struct Frame;
+
+    PatternFrames();
+
+    std::unique_ptr<Int8ReferenceModel> m_model;
+    std::unique_ptr<Frame> m_frames[2];
+};
+
+} /* namespace test */
+
+#endif /* PATTERN_FRAMES_HPP */
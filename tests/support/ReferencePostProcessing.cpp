@@ -0,0 +1,188 @@
+/**************************************************************************//**
+ * @file     ReferencePostProcessing.cpp
+ * @version  V1.00
+ * @brief    List-based YOLO post-processing DetectorPostprocessing replaced,
+ *           kept as the reference of its results
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "ReferencePostProcessing.hpp"
+
+#include "ImageUtils.hpp"
+#include "PlatformMath.hpp"
+#include "YoloFastestModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <forward_list>
+
+namespace test
+{
+
+using arm::app::image::Detection;
+using arm::app::math::MathUtils;
+using arm::app::object_detection::DetectionResult;
+
+namespace
+{
+
+struct Branch
+{
+    int resolution;
+    int numBox;
+    const float *anchor;
+    const int8_t *modelOutput;
+    float scale;
+    int zeroPoint;
+};
+
+Branch MakeBranch(const TfLiteTensor *tensor, const float *anchor)
+{
+    const auto *quantParams = static_cast<const TfLiteAffineQuantization *>(tensor->quantization.params);
+
+    return Branch {tensor->dims->data[1], 3, anchor, tensor->data.int8,
+                   quantParams->scale->data[0], quantParams->zero_point->data[0]};
+}
+
+void InsertTopNDetections(std::forward_list<Detection> &detections, Detection &det)
+{
+    std::forward_list<Detection>::iterator it;
+    std::forward_list<Detection>::iterator lastIt;
+
+    for (it = detections.begin(); it != detections.end(); ++it)
+    {
+        if (it->objectness > det.objectness)
+        {
+            break;
+        }
+
+        lastIt = it;
+    }
+
+    if (it != detections.begin())
+    {
+        detections.emplace_after(lastIt, det);
+        detections.pop_front();
+    }
+}
+
+void GetNetworkBoxes(const Branch (&branches)[2], int numClasses, int topN, int inputWidth, int inputHeight,
+                     int imageWidth, int imageHeight, float threshold, std::forward_list<Detection> &detections)
+{
+    int num = 0;
+    auto objectnessComparator = [](Detection &a, Detection &b)
+    {
+        return a.objectness < b.objectness;
+    };
+
+    for (const Branch &branch : branches)
+    {
+        const int width = branch.resolution;
+        const int height = branch.resolution;
+        const int channel = branch.numBox * (5 + numClasses);
+
+        for (int h = 0; h < height; h++)
+        {
+            for (int w = 0; w < width; w++)
+            {
+                for (int anc = 0; anc < branch.numBox; anc++)
+                {
+                    const int objOffset = h * width * channel + w * channel + anc * (numClasses + 5) + 4;
+                    const float objectness = MathUtils::SigmoidF32(
+                        (static_cast<float>(branch.modelOutput[objOffset]) - branch.zeroPoint) * branch.scale);
+
+                    if (objectness <= threshold)
+                    {
+                        continue;
+                    }
+
+                    Detection det;
+                    det.objectness = objectness;
+
+                    const int xOffset = objOffset - 4;
+                    auto dequantize = [&branch](int offset)
+                    {
+                        return (static_cast<float>(branch.modelOutput[offset]) - branch.zeroPoint) * branch.scale;
+                    };
+
+                    det.bbox.x = (MathUtils::SigmoidF32(dequantize(xOffset)) + w) / width;
+                    det.bbox.y = (MathUtils::SigmoidF32(dequantize(xOffset + 1)) + h) / height;
+                    det.bbox.w = std::exp(dequantize(xOffset + 2)) * branch.anchor[anc * 2] / inputWidth;
+                    det.bbox.h = std::exp(dequantize(xOffset + 3)) * branch.anchor[anc * 2 + 1] / inputHeight;
+
+                    for (int s = 0; s < numClasses; s++)
+                    {
+                        const float sig = MathUtils::SigmoidF32(dequantize(xOffset + 5 + s)) * objectness;
+                        det.prob.emplace_back((sig > threshold) ? sig : 0);
+                    }
+
+                    det.bbox.x *= imageWidth;
+                    det.bbox.w *= imageWidth;
+                    det.bbox.y *= imageHeight;
+                    det.bbox.h *= imageHeight;
+
+                    if (num < topN || topN <= 0)
+                    {
+                        detections.emplace_front(det);
+                        num += 1;
+                    }
+                    else if (num == topN)
+                    {
+                        detections.sort(objectnessComparator);
+                        InsertTopNDetections(detections, det);
+                        num += 1;
+                    }
+                    else
+                    {
+                        InsertTopNDetections(detections, det);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} /* namespace */
+
+void RunReferencePostProcessing(float threshold,
+                                float nms,
+                                int numClasses,
+                                int topN,
+                                uint32_t imgNetRows,
+                                uint32_t imgNetCols,
+                                uint32_t imgSrcRows,
+                                uint32_t imgSrcCols,
+                                const TfLiteTensor *modelOutput0,
+                                const TfLiteTensor *modelOutput1,
+                                std::vector<DetectionResult> &resultsOut)
+{
+    const Branch branches[2] = {MakeBranch(modelOutput0, anchor1), MakeBranch(modelOutput1, anchor2)};
+    const int imageWidth = static_cast<int>(imgSrcCols);
+    const int imageHeight = static_cast<int>(imgSrcRows);
+    std::forward_list<Detection> detections;
+
+    GetNetworkBoxes(branches, numClasses, topN, static_cast<int>(imgNetCols), static_cast<int>(imgNetRows),
+                    imageWidth, imageHeight, threshold, detections);
+
+    arm::app::image::CalculateNMS(detections, numClasses, nms);
+
+    for (auto &it : detections)
+    {
+        float xMin = std::max(it.bbox.x - it.bbox.w / 2.0f, 0.0f);
+        float xMax = std::min(it.bbox.x + it.bbox.w / 2.0f, static_cast<float>(imageWidth));
+        float yMin = std::max(it.bbox.y - it.bbox.h / 2.0f, 0.0f);
+        float yMax = std::min(it.bbox.y + it.bbox.h / 2.0f, static_cast<float>(imageHeight));
+
+        for (int j = 0; j < numClasses; ++j)
+        {
+            if (it.prob[j] > 0)
+            {
+                resultsOut.emplace_back(it.prob[j], static_cast<int>(xMin), static_cast<int>(yMin),
+                                        static_cast<int>(xMax - xMin), static_cast<int>(yMax - yMin), j);
+            }
+        }
+    }
+}
+
+} /* namespace test */
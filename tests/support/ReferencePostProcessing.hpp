@@ -0,0 +1,53 @@
+/**************************************************************************//**
+ * @file     ReferencePostProcessing.hpp
+ * @version  V1.00
+ * @brief    List-based YOLO post-processing DetectorPostprocessing replaced,
+ *           kept as the reference of its results
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef REFERENCE_POST_PROCESSING_HPP
+#define REFERENCE_POST_PROCESSING_HPP
+
+#include "DetectionResult.hpp"
+#include "tensorflow/lite/c/common.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace test
+{
+
+/**
+ * @brief       Post-processing of YOLO-Fastest outputs as it was before the
+ *              detection pool: a std::forward_list of candidates, decoded in
+ *              float, with image::CalculateNMS.
+ * @param[in]   threshold     Post-processing threshold.
+ * @param[in]   nms           Non-maximum Suppression threshold.
+ * @param[in]   numClasses    Number of classes.
+ * @param[in]   topN          Candidates with the highest objectness to keep,
+ *                            0 for all of them.
+ * @param[in]   imgNetRows    Number of rows in the network input image.
+ * @param[in]   imgNetCols    Number of columns in the network input image.
+ * @param[in]   imgSrcRows    Number of rows in the original input image.
+ * @param[in]   imgSrcCols    Number of columns in the original input image.
+ * @param[in]   modelOutput0  Output tensor of branch 0.
+ * @param[in]   modelOutput1  Output tensor of branch 1.
+ * @param[out]  resultsOut    Detected results, appended.
+ **/
+void RunReferencePostProcessing(float threshold,
+                                float nms,
+                                int numClasses,
+                                int topN,
+                                uint32_t imgNetRows,
+                                uint32_t imgNetCols,
+                                uint32_t imgSrcRows,
+                                uint32_t imgSrcCols,
+                                const TfLiteTensor *modelOutput0,
+                                const TfLiteTensor *modelOutput1,
+                                std::vector<arm::app::object_detection::DetectionResult> &resultsOut);
+
+} /* namespace test */
+
+#endif /* REFERENCE_POST_PROCESSING_HPP */
@@ -0,0 +1,140 @@
+/**************************************************************************//**
+ * @file     SimulatedCcap.cpp
+ * @version  V1.00
+ * @brief    Simulated CCAP behind the image sensor capture path
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "SimulatedCcap.hpp"
+
+namespace test
+{
+
+SimulatedCcap &SimulatedCcap::Get()
+{
+    static SimulatedCcap ccap;
+    return ccap;
+}
+
+const S_IMAGE_SENSOR_BACKEND *SimulatedCcap::GetBackend() const
+{
+    static const S_IMAGE_SENSOR_BACKEND backend =
+    {
+        SetBufs,
+        Start,
+        Stop,
+        DisableIRQ,
+        EnableIRQ,
+    };
+
+    return &backend;
+}
+
+void SimulatedCcap::Reset()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    m_ops.clear();
+    m_running = false;
+    m_frameBufAddr = 0;
+    m_planarBufAddr = 0;
+}
+
+std::vector<std::string> SimulatedCcap::GetOps() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_ops;
+}
+
+bool SimulatedCcap::IsRunning() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_running;
+}
+
+uint32_t SimulatedCcap::GetFrameBufAddr() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_frameBufAddr;
+}
+
+uint32_t SimulatedCcap::GetPlanarBufAddr() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_planarBufAddr;
+}
+
+void SimulatedCcap::RaiseFrameEnd()
+{
+    /* One shot: CCAP has stopped by the time VINTF is raised */
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    m_running = false;
+    RaiseInterrupt(IMAGE_SENSOR_EVENT_FRAME_END);
+}
+
+void SimulatedCcap::RaiseMemError()
+{
+    RaiseInterrupt(IMAGE_SENSOR_EVENT_MEM_ERROR);
+}
+
+void SimulatedCcap::Record(const char *op)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_ops.emplace_back(op);
+}
+
+void SimulatedCcap::RaiseInterrupt(uint32_t events)
+{
+    /* Waits while the capture path has the interrupt disabled */
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    ImageSensor_CaptureEvent(events);
+}
+
+void SimulatedCcap::SetBufs(uint32_t frameBufAddr, uint32_t planarBufAddr)
+{
+    SimulatedCcap &ccap = Get();
+    std::lock_guard<std::recursive_mutex> lock(ccap.m_mutex);
+
+    ccap.Record("SetBufs");
+    ccap.m_frameBufAddr = frameBufAddr;
+    ccap.m_planarBufAddr = planarBufAddr;
+}
+
+void SimulatedCcap::Start()
+{
+    SimulatedCcap &ccap = Get();
+    std::lock_guard<std::recursive_mutex> lock(ccap.m_mutex);
+
+    ccap.Record("Start");
+    ccap.m_running = true;
+}
+
+void SimulatedCcap::Stop()
+{
+    SimulatedCcap &ccap = Get();
+    std::lock_guard<std::recursive_mutex> lock(ccap.m_mutex);
+
+    ccap.Record("Stop");
+    ccap.m_running = false;
+}
+
+void SimulatedCcap::DisableIRQ()
+{
+    SimulatedCcap &ccap = Get();
+
+    /* Held until EnableIRQ, like a masked interrupt */
+    ccap.m_mutex.lock();
+    ccap.Record("DisableIRQ");
+}
+
+void SimulatedCcap::EnableIRQ()
+{
+    SimulatedCcap &ccap = Get();
+
+    ccap.Record("EnableIRQ");
+    ccap.m_mutex.unlock();
+}
+
+} /* namespace test */
@@ -0,0 +1,66 @@
+/**************************************************************************//**
+ * @file     SimulatedCcap.hpp
+ * @version  V1.00
+ * @brief    Simulated CCAP behind the image sensor capture path. It records
+ *           what the capture path does to it; the test raises its interrupt.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#ifndef SIMULATED_CCAP_HPP
+#define SIMULATED_CCAP_HPP
+
+#include "ImageSensorBackend.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+class SimulatedCcap
+{
+public:
+    /* The one simulated CCAP */
+    static SimulatedCcap &Get();
+
+    const S_IMAGE_SENSOR_BACKEND *GetBackend() const;
+
+    /* Forget what was done to CCAP */
+    void Reset();
+
+    /* What was done to CCAP, in order: "SetBufs", "Start", "Stop", "DisableIRQ", "EnableIRQ" */
+    std::vector<std::string> GetOps() const;
+
+    bool IsRunning() const;
+    uint32_t GetFrameBufAddr() const;
+    uint32_t GetPlanarBufAddr() const;
+
+    /* Raise the CCAP interrupt: VINTF ends the frame, MEINTF reports a memory error */
+    void RaiseFrameEnd();
+    void RaiseMemError();
+
+private:
+    SimulatedCcap() = default;
+
+    void Record(const char *op);
+    void RaiseInterrupt(uint32_t events);
+
+    static void SetBufs(uint32_t frameBufAddr, uint32_t planarBufAddr);
+    static void Start();
+    static void Stop();
+    static void DisableIRQ();
+    static void EnableIRQ();
+
+    mutable std::recursive_mutex m_mutex;  /* Held while the interrupt runs, and while it is disabled */
+    std::vector<std::string> m_ops;
+    bool m_running = false;
+    uint32_t m_frameBufAddr = 0;
+    uint32_t m_planarBufAddr = 0;
+};
+
+} /* namespace test */
+
+#endif /* SIMULATED_CCAP_HPP */
@@ -0,0 +1,310 @@
+/**************************************************************************//**
+ * @file     TilePlannerTest.cpp
+ * @version  V1.00
+ * @brief    TilePlanner grid, adaptive plans and cross-tile merge on
+ *           synthetic detections, and the tile conversion of YUV420P frames
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2025 Nuvoton Technology Corp. All rights reserved.
+ ******************************************************************************/
+#include "TilePlanner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using arm::app::object_detection::DetectionResult;
+
+namespace
+{
+
+/* VGA stage in 320 x 320 tiles, 3 x 2 of them, merged to a QVGA frame */
+constexpr int s_stageWidth = 640;
+constexpr int s_stageHeight = 480;
+constexpr int s_tileSize = 320;
+constexpr int s_minOverlap = 64;
+constexpr int s_frameWidth = 320;
+constexpr int s_frameHeight = 240;
+constexpr int s_fullGridFrames = 4;
+constexpr int s_maxDetections = 8;
+
+/* An object of the scene, stage pixels */
+struct Object
+{
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+    float score;
+};
+
+DetectionResult Box(int x0, int y0, int x1, int y1, float score)
+{
+    DetectionResult result = {};
+
+    result.m_normalisedVal = score;
+    result.m_x0 = x0;
+    result.m_y0 = y0;
+    result.m_w = x1 - x0;
+    result.m_h = y1 - y0;
+    result.m_cls = 0;
+    return result;
+}
+
+/*
+ * Detections of each tile: the part of each object inside it, when at least
+ * a quarter of the object, scoring less the more of it is cut off.
+ */
+std::vector<DetectionResult> Detect(const rectangle_t *tiles, int numTiles, const std::vector<Object> &scene,
+                                    int *tileEnd)
+{
+    std::vector<DetectionResult> results;
+
+    for (int t = 0; t < numTiles; t++)
+    {
+        const rectangle_t &tile = tiles[t];
+
+        for (const Object &object : scene)
+        {
+            const int x0 = std::max(object.x0, static_cast<int>(tile.x));
+            const int y0 = std::max(object.y0, static_cast<int>(tile.y));
+            const int x1 = std::min(object.x1, tile.x + tile.w);
+            const int y1 = std::min(object.y1, tile.y + tile.h);
+
+            if ((x1 <= x0) || (y1 <= y0))
+                continue;
+
+            const float visible = static_cast<float>((x1 - x0) * (y1 - y0)) /
+                                  ((object.x1 - object.x0) * (object.y1 - object.y0));
+
+            if (visible >= 0.25f)
+            {
+                results.push_back(Box(x0, y0, x1, y1, object.score * visible));
+            }
+        }
+
+        tileEnd[t] = static_cast<int>(results.size());
+    }
+
+    return results;
+}
+
+/* Each object once, in frame pixels within 1 pixel */
+void ExpectObjects(std::vector<DetectionResult> results, const std::vector<Object> &scene)
+{
+    ASSERT_EQ(results.size(), scene.size());
+
+    for (const Object &object : scene)
+    {
+        const int x0 = object.x0 * s_frameWidth / s_stageWidth;
+        const int y0 = object.y0 * s_frameHeight / s_stageHeight;
+        const int x1 = object.x1 * s_frameWidth / s_stageWidth;
+        const int y1 = object.y1 * s_frameHeight / s_stageHeight;
+
+        auto match = std::find_if(results.begin(), results.end(), [=](const DetectionResult &result)
+        {
+            return (std::abs(result.m_x0 - x0) <= 1) && (std::abs(result.m_y0 - y0) <= 1) &&
+                   (std::abs(result.m_x0 + result.m_w - x1) <= 1) && (std::abs(result.m_y0 + result.m_h - y1) <= 1);
+        });
+
+        ASSERT_NE(match, results.end()) << "object at " << object.x0 << "," << object.y0;
+        results.erase(match);
+    }
+}
+
+class TilePlannerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(m_planner.Init(s_stageWidth, s_stageHeight, s_tileSize, s_tileSize, s_minOverlap,
+                                 s_frameWidth, s_frameHeight, s_fullGridFrames, s_maxDetections), 0);
+    }
+
+    /* Plan, detect and merge one frame, returning its number of tiles */
+    int RunFrame(bool adaptive, const std::vector<Object> &scene, std::vector<DetectionResult> &results)
+    {
+        int tileEnd[TilePlanner::ms_maxTiles];
+
+        m_numTiles = m_planner.Plan(adaptive, m_tiles);
+        results = Detect(m_tiles, m_numTiles, scene, tileEnd);
+        m_planner.Merge(results, tileEnd);
+        return m_numTiles;
+    }
+
+    TilePlanner m_planner;
+    rectangle_t m_tiles[TilePlanner::ms_maxTiles];
+    int m_numTiles{0};
+};
+
+} /* namespace */
+
+TEST_F(TilePlannerTest, GridSpreadsEvenTiles)
+{
+    const int xs[] = {0, 160, 320, 0, 160, 320};
+    const int ys[] = {0, 0, 0, 160, 160, 160};
+
+    ASSERT_EQ(m_planner.Plan(false, m_tiles), 6);
+
+    for (int t = 0; t < 6; t++)
+    {
+        EXPECT_EQ(m_tiles[t].x, xs[t]) << "tile " << t;
+        EXPECT_EQ(m_tiles[t].y, ys[t]) << "tile " << t;
+        EXPECT_EQ(m_tiles[t].w, s_tileSize);
+        EXPECT_EQ(m_tiles[t].h, s_tileSize);
+    }
+
+    TilePlanner crowded;
+
+    EXPECT_LT(crowded.Init(s_stageWidth, s_stageHeight, 64, 64, 32, s_frameWidth, s_frameHeight,
+                           s_fullGridFrames, s_maxDetections), 0);
+}
+
+/* Objects cut by a seam, seen whole by another tile, or whole in the overlap of several */
+TEST_F(TilePlannerTest, CutObjectsMergeWithinOnePixel)
+{
+    const std::vector<Object> scene = {
+        {280, 100, 360, 180, 0.9f},     /* Across the right edge of tile 0, whole in tile 1 */
+        {100, 290, 180, 370, 0.8f},     /* Across the bottom edge of the top row, whole in the bottom one */
+        {180, 180, 300, 300, 0.7f},     /* Whole in tiles 0, 1, 3 and 4 */
+        {500, 40, 600, 120, 0.6f},      /* In tile 2 only */
+    };
+    std::vector<DetectionResult> results;
+
+    ASSERT_EQ(RunFrame(false, scene, results), 6);
+    ExpectObjects(results, scene);
+}
+
+/* Same-class objects inside one another are distinct when no seam cuts them */
+TEST_F(TilePlannerTest, NestedObjectsStayApart)
+{
+    const std::vector<Object> scene = {
+        {20, 20, 140, 140, 0.9f},
+        {60, 60, 100, 100, 0.8f},
+        {400, 360, 600, 460, 0.7f},     /* Whole in tile 5, cut by the right edge of tile 4 */
+        {520, 380, 560, 420, 0.6f},
+    };
+    std::vector<DetectionResult> results;
+
+    RunFrame(false, scene, results);
+    ExpectObjects(results, scene);
+}
+
+/* A box joined with its cut part is not compared again as the union: it would absorb its neighbour */
+TEST_F(TilePlannerTest, MergeDoesNotChain)
+{
+    int tileEnd[6] = {1, 3, 3, 3, 3, 3};
+    std::vector<DetectionResult> results = {
+        Box(250, 100, 320, 150, 0.9f),  /* Tile 0, cut by its right edge */
+        Box(250, 100, 340, 150, 0.8f),  /* Tile 1, the same object whole */
+        Box(310, 100, 350, 150, 0.7f),  /* Tile 1, its neighbour */
+    };
+
+    ASSERT_EQ(m_planner.Plan(false, m_tiles), 6);
+    m_planner.Merge(results, tileEnd);
+
+    ExpectObjects(results, {{250, 100, 340, 150, 0.9f}, {310, 100, 350, 150, 0.7f}});
+}
+
+/* Four objects apart take 4 tiles around them rather than the 6 of the grid, until the grid is due */
+TEST_F(TilePlannerTest, AdaptiveTakesFourTilesInsteadOfSix)
+{
+    const std::vector<Object> scene = {
+        {20, 20, 80, 80, 0.9f},
+        {560, 20, 620, 80, 0.8f},
+        {20, 400, 80, 460, 0.7f},
+        {560, 400, 620, 460, 0.6f},
+    };
+    std::vector<DetectionResult> results;
+
+    ASSERT_EQ(RunFrame(true, scene, results), 0);
+    ASSERT_EQ(RunFrame(false, scene, results), 6);
+    ExpectObjects(results, scene);
+
+    for (int frame = 1; frame < s_fullGridFrames; frame++)
+    {
+        ASSERT_EQ(RunFrame(true, scene, results), 4) << "frame " << frame;
+        ExpectObjects(results, scene);
+    }
+
+    EXPECT_EQ(RunFrame(true, scene, results), 6);
+    ExpectObjects(results, scene);
+}
+
+/* A tile converted from the frame is the matching crop of the whole frame converted */
+TEST(YUV420PTileTest, MatchesCropOfFrame)
+{
+    constexpr uint32_t width = 64;
+    constexpr uint32_t height = 48;
+    std::vector<uint8_t> planes(width * height * 3 / 2);
+    std::vector<uint8_t> frameData(width * height * 3);
+    std::mt19937 random(3);
+    rgb565_int8_lut_t lut;
+    image_t frame{};
+
+    const rgb565_int8_lut_t *luts[] = {nullptr, &lut};
+
+    imlib_nvt_RGB565toInt8_lut(&lut, 1 / 255.f, 1 / 255.f, -128);
+
+    for (uint8_t &byte : planes)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    frame.w = width;
+    frame.h = height;
+    frame.pixfmt = PIXFORMAT_RGB888;
+    frame.data = frameData.data();
+
+    for (const rgb565_int8_lut_t *tileLut : luts)
+    {
+        ASSERT_EQ(imlib_nvt_YUV420PtoRGB888(planes.data(), &frame, tileLut), 0);
+
+        for (rectangle_t roi : {rectangle_t {0, 0, 16, 8}, rectangle_t {8, 6, 32, 24},
+                                rectangle_t {30, 22, 34, 26}, rectangle_t {2, 40, 62, 8}})
+        {
+            SCOPED_TRACE(testing::Message() << "lut " << (tileLut != nullptr) << ", roi " << roi.x << "," << roi.y);
+            std::vector<uint8_t> tileData(roi.w * roi.h * 3);
+            image_t tile{};
+
+            tile.w = roi.w;
+            tile.h = roi.h;
+            tile.pixfmt = PIXFORMAT_RGB888;
+            tile.data = tileData.data();
+
+            ASSERT_EQ(imlib_nvt_YUV420PtoRGB888_roi(planes.data(), width, height, &roi, &tile, tileLut), 0);
+
+            for (int y = 0; y < roi.h; y++)
+            {
+                const uint8_t *frameRow = frameData.data() + ((roi.y + y) * width + roi.x) * 3;
+
+                ASSERT_TRUE(std::equal(frameRow, frameRow + roi.w * 3, tileData.data() + y * roi.w * 3)) << "row " << y;
+            }
+        }
+    }
+}
+
+TEST(YUV420PTileTest, RejectsOddOrOutsideRois)
+{
+    constexpr uint32_t width = 64;
+    constexpr uint32_t height = 48;
+    std::vector<uint8_t> planes(width * height * 3 / 2);
+    std::vector<uint8_t> tileData(16 * 8 * 3);
+    image_t tile{};
+
+    tile.w = 16;
+    tile.h = 8;
+    tile.pixfmt = PIXFORMAT_RGB888;
+    tile.data = tileData.data();
+
+    for (rectangle_t roi : {rectangle_t {1, 0, 16, 8}, rectangle_t {0, 1, 16, 8}, rectangle_t {50, 0, 16, 8},
+                            rectangle_t {0, 42, 16, 8}, rectangle_t {0, 0, 18, 8}})
+    {
+        EXPECT_EQ(imlib_nvt_YUV420PtoRGB888_roi(planes.data(), width, height, &roi, &tile, nullptr), -1)
+            << "roi " << roi.x << "," << roi.y << " " << roi.w << "x" << roi.h;
+    }
+}